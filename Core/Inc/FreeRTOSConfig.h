@@ -52,19 +52,18 @@
   #include <stdint.h>
   extern uint32_t SystemCoreClock;
 #endif
-#define configENABLE_FPU                         0
+#define configENABLE_FPU                         1
 #define configENABLE_MPU                         0
 
 #define configUSE_PREEMPTION                     1
 #define configSUPPORT_STATIC_ALLOCATION          1
-#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION         0
 #define configUSE_IDLE_HOOK                      0
 #define configUSE_TICK_HOOK                      0
 #define configCPU_CLOCK_HZ                       ( SystemCoreClock )
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 7 )
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
-#define configTOTAL_HEAP_SIZE                    ((size_t)15360)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
@@ -134,6 +133,30 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Run time stats counted in CPU cycles by DWT CYCCNT (enabled by DWT_Init in bsp_init).
+   The 32 bit counters wrap, so bsp/trace only reports deltas over short windows. */
+#define configUSE_TRACE_FACILITY                 1
+#define configGENERATE_RUN_TIME_STATS            1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()         (*(volatile uint32_t *)0xE0001004UL)
+
+/* Binary scheduler trace (bsp/trace), set to 0 to remove all trace hooks */
+#define configUSE_SCHED_TRACE                    1
+
+#if (configUSE_SCHED_TRACE == 1) && (defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__))
+  void trace_record(uint8_t type, uint8_t id, uint16_t arg);
+  #define traceTASK_SWITCHED_IN()                trace_record(1, (uint8_t)pxCurrentTCB->uxTCBNumber, 0)
+  #define traceMOVED_TASK_TO_READY_STATE(pxTCB)  trace_record(2, (uint8_t)(pxTCB)->uxTCBNumber, 0)
+  #define traceQUEUE_SEND(pxQueue)               trace_record(5, 0, (uint16_t)(uint32_t)(pxQueue))
+  #define traceQUEUE_SEND_FROM_ISR(pxQueue)      trace_record(5, 0, (uint16_t)(uint32_t)(pxQueue))
+  #define traceQUEUE_RECEIVE(pxQueue)            trace_record(6, 0, (uint16_t)(uint32_t)(pxQueue))
+  #define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)   trace_record(6, 0, (uint16_t)(uint32_t)(pxQueue))
+  #define traceTASK_NOTIFY()                     trace_record(7, (uint8_t)pxTCB->uxTCBNumber, 0)
+  #define traceTASK_NOTIFY_FROM_ISR()            trace_record(7, (uint8_t)pxTCB->uxTCBNumber, 0)
+  #define traceTASK_NOTIFY_GIVE_FROM_ISR()       trace_record(7, (uint8_t)pxTCB->uxTCBNumber, 0)
+  #define traceTASK_NOTIFY_WAIT()                trace_record(8, (uint8_t)pxCurrentTCB->uxTCBNumber, 0)
+  #define traceTASK_NOTIFY_TAKE()                trace_record(8, (uint8_t)pxCurrentTCB->uxTCBNumber, 0)
+#endif
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
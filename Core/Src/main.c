@@ -30,6 +30,8 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "bsp_init.h"
+#include "dwt/bsp_dwt.h"
+#include "tick/tick.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -103,6 +105,8 @@ int main(void)
   MX_SPI1_Init();
   MX_TIM4_Init();
   MX_TIM5_Init();
+  MX_TIM7_Init();
+  MX_TIM10_Init();
   /* USER CODE BEGIN 2 */
   bsp_init();
   /* USER CODE END 2 */
@@ -193,7 +197,14 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
-
+  if (htim->Instance == TIM14)
+  {
+    DWT_CNT_Update();
+  }
+  else if (htim->Instance == TIM7)
+  {
+    tick_isr();
+  }
   /* USER CODE END Callback 1 */
 }
 
@@ -22,7 +22,9 @@
 #include "usbd_cdc_if.h"
 
 /* USER CODE BEGIN INCLUDE */
-
+#include <string.h>
+#include "cmd/cmd.h"
+#include "ulog/ulog.h"
 /* USER CODE END INCLUDE */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -62,6 +64,8 @@
   */
 
 /* USER CODE BEGIN PRIVATE_DEFINES */
+/* UserTxBufferFS分成两半交替使用: 一半由USB发送时另一半供写入 */
+#define CDC_TX_HALF_SIZE  (APP_TX_DATA_SIZE / 2)
 /* USER CODE END PRIVATE_DEFINES */
 
 /**
@@ -94,6 +98,9 @@ uint8_t UserRxBufferFS[APP_RX_DATA_SIZE];
 uint8_t UserTxBufferFS[APP_TX_DATA_SIZE];
 
 /* USER CODE BEGIN PRIVATE_VARIABLES */
+static uint16_t CDC_TxFillLen;            /* 写入半区中的数据长度 */
+static uint8_t CDC_TxFillIdx;             /* 当前写入的半区 */
+static volatile uint8_t CDC_TxInFlight;   /* 另一半区正在发送 */
 
 /* USER CODE END PRIVATE_VARIABLES */
 
@@ -128,6 +135,7 @@ static int8_t CDC_Receive_FS(uint8_t* pbuf, uint32_t *Len);
 static int8_t CDC_TransmitCplt_FS(uint8_t *pbuf, uint32_t *Len, uint8_t epnum);
 
 /* USER CODE BEGIN PRIVATE_FUNCTIONS_DECLARATION */
+static void CDC_TxKick_FS(void);
 
 /* USER CODE END PRIVATE_FUNCTIONS_DECLARATION */
 
@@ -152,9 +160,12 @@ USBD_CDC_ItfTypeDef USBD_Interface_fops_FS =
 static int8_t CDC_Init_FS(void)
 {
   /* USER CODE BEGIN 3 */
+  /* 重新枚举后正在发送的半区不会再有完成回调，丢弃；写入半区中的数据保留，配置完成后发送 */
+  CDC_TxInFlight = 0;
   /* Set Application Buffers */
   USBD_CDC_SetTxBuffer(&hUsbDeviceFS, UserTxBufferFS, 0);
   USBD_CDC_SetRxBuffer(&hUsbDeviceFS, UserRxBufferFS);
+  ulog_tx_ready();
   return (USBD_OK);
   /* USER CODE END 3 */
 }
@@ -261,6 +272,7 @@ static int8_t CDC_Control_FS(uint8_t cmd, uint8_t* pbuf, uint16_t length)
 static int8_t CDC_Receive_FS(uint8_t* Buf, uint32_t *Len)
 {
   /* USER CODE BEGIN 6 */
+  cmd_receive(Buf, *Len);
   USBD_CDC_SetRxBuffer(&hUsbDeviceFS, &Buf[0]);
   USBD_CDC_ReceivePacket(&hUsbDeviceFS);
   return (USBD_OK);
@@ -311,11 +323,70 @@ static int8_t CDC_TransmitCplt_FS(uint8_t *Buf, uint32_t *Len, uint8_t epnum)
   UNUSED(Buf);
   UNUSED(Len);
   UNUSED(epnum);
+  CDC_TxInFlight = 0;
+  CDC_TxKick_FS();
+  ulog_tx_ready();
   /* USER CODE END 13 */
   return result;
 }
 
 /* USER CODE BEGIN PRIVATE_FUNCTIONS_IMPLEMENTATION */
+/**
+  * @brief  把写入半区交给USB发送并切换到另一半区
+  *         需在关中断或USB中断中调用。整块数据由USB库按64字节包发出，
+  *         长度为包长整数倍时USB库会补发ZLP
+  */
+static void CDC_TxKick_FS(void)
+{
+  if (CDC_TxInFlight || CDC_TxFillLen == 0)
+    return;
+  if (hUsbDeviceFS.dev_state != USBD_STATE_CONFIGURED || hUsbDeviceFS.pClassData == NULL)
+    return;
+
+  USBD_CDC_SetTxBuffer(&hUsbDeviceFS, &UserTxBufferFS[CDC_TxFillIdx * CDC_TX_HALF_SIZE], CDC_TxFillLen);
+  if (USBD_CDC_TransmitPacket(&hUsbDeviceFS) != USBD_OK)
+    return;
+
+  CDC_TxInFlight = 1;
+  CDC_TxFillIdx ^= 1U;
+  CDC_TxFillLen = 0;
+}
+
+/**
+  * @brief  追加数据到发送缓冲区，USB空闲时立即开始发送，否则在上一次传输完成回调中发送
+  *         不会阻塞，可多处调用。Len为0时只尝试启动发送(如USB刚连接时)
+  * @param  Buf: 数据
+  * @param  Len: 数据长度
+  * @retval 实际写入的长度，缓冲区满时小于Len；USB未配置(未连接或未枚举)时为0，数据留在调用方
+  */
+uint16_t CDC_Write_FS(const uint8_t* Buf, uint16_t Len)
+{
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  if (hUsbDeviceFS.dev_state != USBD_STATE_CONFIGURED)
+    Len = 0;
+  else if (Len > CDC_TX_HALF_SIZE - CDC_TxFillLen)
+    Len = CDC_TX_HALF_SIZE - CDC_TxFillLen;
+  if (Len > 0) {
+    memcpy(&UserTxBufferFS[CDC_TxFillIdx * CDC_TX_HALF_SIZE + CDC_TxFillLen], Buf, Len);
+    CDC_TxFillLen += Len;
+  }
+  CDC_TxKick_FS();
+
+  __set_PRIMASK(primask);
+  return Len;
+}
+
+/**
+  * @brief  发送缓冲区剩余空间，USB未配置时为0，启动日志留在ulog环形缓冲区中直到枚举完成
+  */
+uint16_t CDC_TxSpace_FS(void)
+{
+  if (hUsbDeviceFS.dev_state != USBD_STATE_CONFIGURED)
+    return 0;
+  return CDC_TX_HALF_SIZE - CDC_TxFillLen;
+}
 
 /* USER CODE END PRIVATE_FUNCTIONS_IMPLEMENTATION */
 
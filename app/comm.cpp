@@ -1,6 +1,8 @@
 #include "comm.h"
 #include "upc/upc.h"
 #include "cmsis_os.h"
+#include "cmd/cmd.h"
+#include "trace/trace.h"
 upc upc_instance(&huart6);
 
 void comm_init()
@@ -14,6 +16,8 @@ void CommTask(void const * argument)
     while (1)
     {
         upc_instance.send_attitude_handler();
+        cmd_poll();
+        trace_poll();
         osDelay(5);
     }
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * @file control.cpp
+ * @brief 电机闭环控制任务
+ * 由TIM7以CONTROL_RATE_HZ释放(见bsp/tick)，每周期对CAN1上0x201~0x204四个M3508
+ * 运行一次位置→速度串级PID并发出电流指令，周期与FreeRTOS节拍和其他任务的负载无关。
+ * 设定值由其他模块写入DTM话题control_target，类型为control_target_t，默认各环均未使能、电流为0。
+ * 四个电机的反馈都更新一次时CAN接收中断置位新数据标志，
+ * 连续CONTROL_TIMEOUT_MS没有收齐反馈时(电机掉线)输出0电流并清除PID状态
+ * @version 1.1
+ * @date 2026-10-19
+ */
+
+#include "control.h"
+#include "cmsis_os.h"
+#include "dtm/dtm.h"
+#include "tick/tick.h"
+#include "motor/dji/dji_motor.h"
+
+#define CONTROL_RATE_HZ    1000u
+#define CONTROL_TIMEOUT_MS 3u
+
+DTM_DEFINE_TOPIC(control_target_t, control_target);
+
+namespace {
+
+volatile uint8_t feedback_fresh;
+
+/* 电调转速反馈单位为rpm，换算到输出轴rad/s后用下列参数，输出为电流原始值(±16384对应±20A) */
+constexpr pid::Params SPEED_PARAMS = {2000.0f, 20000.0f, 0.0f, 5000.0f, 16000.0f, 1.0f, 0.0f};
+constexpr pid::Params POS_PARAMS = {10.0f, 0.0f, 0.2f, 0.0f, 40.0f, 0.2f, 0.0f};
+
+void control_sync(void *)
+{
+    feedback_fresh = 1;
+}
+
+} // namespace
+
+bool control_idle()
+{
+    const control_target_t &t = DTM_TOPIC_REF(control_target);
+    if (t.pos_mask != 0 || t.speed_mask != 0)
+        return false;
+    for (uint8_t i = 0; i < CONTROL_MOTORS; i++) {
+        if (t.current[i] != 0.0f)
+            return false;
+    }
+    return true;
+}
+
+void ControlTask(void const * argument)
+{
+    // 在任务中构造，此时OD与DTM已初始化
+    static dji::M3508Group chassis(&hcan1, 0x200, CONTROL_MOTORS);
+    static pid::Cascade<CONTROL_MOTORS> cascade;
+
+    DTM_REGISTER_TOPIC(control_target_t, control_target);
+    cascade.speed.set_all(SPEED_PARAMS);
+    cascade.pos.set_all(POS_PARAMS);
+    chassis.set_sync(control_sync, nullptr);
+
+    constexpr float dt = 1.0f / CONTROL_RATE_HZ;
+    constexpr uint32_t timeout = CONTROL_TIMEOUT_MS * CONTROL_RATE_HZ / 1000u;
+    uint32_t stale = timeout;
+    tick_start(CONTROL_RATE_HZ);
+
+    while (1) {
+        tick_wait();
+
+        if (feedback_fresh) {
+            feedback_fresh = 0;
+            stale = 0;
+        } else if (stale < timeout) {
+            stale++;
+        }
+        if (stale >= timeout) {
+            cascade.reset();
+            chassis.send_cmd(0, 0, 0, 0);
+            tick_done();
+            continue;
+        }
+
+        float pos[CONTROL_MOTORS], speed[CONTROL_MOTORS], current[CONTROL_MOTORS];
+        int16_t cmd[CONTROL_MOTORS];
+
+        for (uint8_t i = 0; i < CONTROL_MOTORS; i++) {
+            pos[i] = chassis.angle(i);
+            speed[i] = chassis.speed(i);
+        }
+        cascade.update(DTM_TOPIC_REF(control_target), pos, speed, current, dt);
+        for (uint8_t i = 0; i < CONTROL_MOTORS; i++)
+            cmd[i] = static_cast<int16_t>(current[i]);
+        chassis.send_cmd(cmd, CONTROL_MOTORS);
+        tick_done();
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef STANDARD_ROBOT_CONTROL_H
+#define STANDARD_ROBOT_CONTROL_H
+
+#ifdef __cplusplus
+#include "algorithm/pid.h"
+
+constexpr uint8_t CONTROL_MOTORS = 4;
+using control_target_t = pid::Cascade<CONTROL_MOTORS>::Target;
+
+/* 话题control_target各环均未使能且电流指令为0(电机不出力)，任务与中断中均可调用 */
+bool control_idle();
+
+extern "C" {
+#endif
+
+void ControlTask(void const * argument);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //STANDARD_ROBOT_CONTROL_H
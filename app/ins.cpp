@@ -0,0 +1,152 @@
+/**
+ * @file ins.cpp
+ * @brief 姿态解算任务
+ * BMI088由数据就绪中断驱动采样(陀螺仪2000Hz、加速度计1600Hz)，本任务由每个陀螺仪样本唤醒(bmi088::wait)，
+ * 对每个样本运行一次姿态估计，dt为该样本与上一个样本的中断时间戳之差；加速度计取当时最新的样本。
+ * 任务被推迟到下一个样本之后才运行时，漏处理的样本计入skipped，dt跨过它们。
+ * 默认使用估计零偏的EKF，定义INS_MAHONY时改用Mahony互补滤波。
+ * 本任务同时以10Hz运行IMU恒温控制，温度稳定("imu_temp"话题的stable)之前冻结零偏估计。
+ * 送入估计器的样本先经imu_calib去除当前温度下标定的零偏、标定加速度计，估计器的零偏只是残差；
+ * 当前温度的零偏已标定过(上电时从Flash载入)时ready立即为true，否则在第一次静止约1s后为true。
+ * 结果写入DTM话题"attitude"，类型为ins_attitude_t；每次更新的耗时计入profile区"ins_update"，
+ * "prof"命令中的max即最坏情况
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "ins.h"
+#include "control.h"
+#include "cmsis_os.h"
+#include "dtm/dtm.h"
+#include "imu/bmi088.h"
+#include "imu/heater.h"
+#include "imu/calib.h"
+#include "dwt/bsp_dwt.h"
+#include "online_detect/onl_det.h"
+#include "profile/profile.h"
+#include "ulog/ulog.h"
+
+namespace {
+
+constexpr float IMU_TIMEOUT_S = 0.01f;
+constexpr uint32_t WAIT_TIMEOUT_MS = 2;     // 没有样本时(离线)也要运行离线检查与恒温控制
+constexpr uint32_t DETECT_PERIOD_US = 100000;
+constexpr uint32_t HEATER_PERIOD_US = 100000;   // 恒温控制10Hz
+constexpr uint32_t HEATER_PHASE_US = 50000;     // 与离线检查错开
+constexpr float HEATER_DT = 0.1f;
+constexpr float DT_MAX = 0.01f;             // 超过时(采样中断丢失)按DT_MAX积分
+
+#ifdef INS_MAHONY
+attitude::Mahony estimator(0.3f, 0.03f);
+#else
+attitude::Ekf estimator;
+#endif
+
+dtm::TopicStorage<ins_attitude_t> attitude_topic{};
+
+int32_t od_gyro = -1;
+int32_t od_accel = -1;
+uint32_t skipped = 0;   // 任务未及时运行而漏处理的陀螺仪样本数
+
+void ins_init()
+{
+    while (!bmi088::init())
+        osDelay(100);
+    od_gyro = OD::find_device("od_bmi088_gyro");
+    od_accel = OD::find_device("od_bmi088_accel");
+    dtm::Manager::registerTopic("attitude", attitude_topic);
+    imu_heater::init();
+    imu_calib::init(control_idle);    // 只在电机不出力时写入Flash
+}
+
+void check_online(bool &online)
+{
+    const bool now = OD::detect(od_gyro, IMU_TIMEOUT_S) && OD::detect(od_accel, IMU_TIMEOUT_S);
+    if (now == online)
+        return;
+    if (now)
+        LOG_INFO("bmi088 online");
+    else
+        LOG_WARN("bmi088 offline, overruns %lu errors %lu skipped %lu", (unsigned long)bmi088::overruns(),
+                 (unsigned long)bmi088::errors(), (unsigned long)skipped);
+    online = now;
+}
+
+} // namespace
+
+void ins_get_attitude(ins_attitude_t &out)
+{
+    attitude_topic.load(out);
+}
+
+void InsTask(void const * argument)
+{
+    ins_init();
+
+    bmi088::ImuData imu{};
+    while (imu.gyro_count == 0 || imu.accel_count == 0 || imu.temp_count == 0) {
+        osDelay(1);
+        bmi088::read(imu);
+    }
+    float gyro[3], accel[3];
+    imu_calib::apply(imu.gyro, imu.accel, imu.temperature, gyro, accel);
+    estimator.reset(accel);
+    estimator.set_bias_learning(false);
+
+    ins_attitude_t out{};
+    uint32_t last_gyro = imu.gyro_count;
+    uint64_t last_time = imu.gyro_time;
+    uint64_t detect_at = DWT_Deadline_us(DETECT_PERIOD_US);
+    uint64_t heater_at = DWT_Deadline_us(HEATER_PHASE_US);
+    bool online = true;
+
+    while (1)
+    {
+        bmi088::wait(WAIT_TIMEOUT_MS);
+        if (DWT_DeadlineReached(detect_at)) {
+            detect_at = DWT_Deadline_us(DETECT_PERIOD_US);
+            check_online(online);
+        }
+
+        bmi088::read(imu);
+        if (DWT_DeadlineReached(heater_at)) {
+            heater_at = DWT_Deadline_us(HEATER_PERIOD_US);
+            if (online)
+                imu_heater::update(imu.temperature, HEATER_DT);
+            else
+                imu_heater::off();
+            estimator.set_bias_learning(imu_heater::stable());
+        }
+        if (imu.gyro_count == last_gyro)
+            continue;
+        skipped += imu.gyro_count - last_gyro - 1u;
+        float dt = static_cast<float>(imu.gyro_time - last_time) / static_cast<float>(SystemCoreClock);
+        dt = dt > DT_MAX ? DT_MAX : dt;
+        last_gyro = imu.gyro_count;
+        last_time = imu.gyro_time;
+
+        {
+            PROFILE_SCOPE(ins_calib);
+            imu_calib::feed(imu.gyro, imu.accel, imu.temperature);
+            out.ready = imu_calib::apply(imu.gyro, imu.accel, imu.temperature, gyro, accel);
+        }
+        {
+            PROFILE_SCOPE(ins_update);
+            estimator.update(gyro, accel, dt);
+        }
+
+        const float *q = estimator.quat();
+        for (uint8_t i = 0; i < 4; i++)
+            out.q[i] = q[i];
+        out.euler = attitude::to_euler(q);
+        float residual[3];
+        estimator.bias(residual);
+        for (uint8_t i = 0; i < 3; i++) {
+            out.rate[i] = gyro[i] - residual[i];
+            out.bias[i] = imu.gyro[i] - out.rate[i];
+        }
+        out.time = imu.gyro_time;
+        out.count++;
+        attitude_topic.store(out);    // 约70字节，关中断的时间很短
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef STANDARD_ROBOT_INS_H
+#define STANDARD_ROBOT_INS_H
+
+#ifdef __cplusplus
+#include "algorithm/attitude.h"
+
+/* DTM话题"attitude"，机体系为C板的BMI088坐标系 */
+struct ins_attitude_t
+{
+    uint32_t count;             // 更新次数
+    float q[4];                 // [w, x, y, z]，机体系到世界系
+    attitude::Euler euler;      // rad
+    float rate[3];              // 去除零偏后的角速度 rad/s
+    float bias[3];              // 陀螺仪零偏 rad/s，标定值加估计的残差
+    uint64_t time;              // 所用陀螺仪样本的DWT_GetCycles
+    bool ready;                 // 当前温度下的零偏已标定(从Flash载入或静止时学到)
+};
+
+/* 一致地读取话题"attitude"，任务与中断中均可调用 */
+void ins_get_attitude(ins_attitude_t &out);
+
+extern "C" {
+#endif
+
+void InsTask(void const * argument);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //STANDARD_ROBOT_INS_H
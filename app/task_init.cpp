@@ -0,0 +1,153 @@
+/* @file task_init.cpp
+ * @brief 任务表与FreeRTOS任务创建
+ * 所有任务在task_table中声明周期、相对截止时间、每周期执行时间预算与栈大小。
+ * 优先级在编译期按周期单调(rate-monotonic)分配: 周期越短优先级越高，周期相同时截止时间短的优先；
+ * 由硬件定时器释放的任务(pinned)不参与排序，固定在其余任务之上，释放抖动只取决于中断与内核临界区。
+ * 这打破了周期单调的最优性，因此编译期再用响应时间分析检查每个任务在截止时间内完成；
+ * TCB与栈静态分配，编译期检查总利用率不超过TASK_CPU_BUDGET_PERCENT，启动时输出各任务参数。
+ * 事件驱动的任务(由中断或其他任务通知释放，而不是按固定周期延时)以其最短触发间隔作为周期
+ * @version 2.0
+ */
+
+#include "task_init.h"
+#include "cmsis_os.h"
+#include "comm.h"
+#include "control.h"
+#include "ins.h"
+#include "test.h"
+#include "ulog/ulog.h"
+
+#ifndef TASK_CPU_BUDGET_PERCENT
+#define TASK_CPU_BUDGET_PERCENT 70
+#endif
+
+namespace {
+
+struct TaskSpec
+{
+    const char *name;
+    os_pthread entry;
+    uint32_t period_us;
+    uint32_t deadline_us;
+    uint32_t budget_us;     // 每周期执行时间预算
+    uint32_t stack_words;
+    bool event;             // 事件驱动，period_us为最短触发间隔
+    bool pinned;            // 由硬件定时器释放，优先级高于所有按周期排序的任务
+};
+
+constexpr TaskSpec task_table[] = {
+    // 名称       入口         周期     截止时间  预算   栈(字) 事件驱动 固定最高
+    {"control", ControlTask, 1000,   1000,    20,    256,   false,   true},   // TIM7释放，四电机串级PID与一帧CAN
+    {"ins",     InsTask,     500,    500,     100,   256,   true,    false},  // 姿态解算，每个陀螺仪样本(2kHz)唤醒，须在下一个样本前完成
+    {"ulog",    UlogTask,    1000,   20000,   60,    256,   true,    false},  // USB发送，新日志或USB发送完成时唤醒，最快约1ms发完半个缓冲区
+    {"comm",    CommTask,    5000,   5000,    200,   384,   false,   false},  // upc、调试命令(prof/trace/top/bench)
+    {"test",    test_task,   100000, 100000,  20,    128,   false,   false},
+};
+constexpr uint32_t TASK_COUNT = sizeof(task_table) / sizeof(task_table[0]);
+
+/* 优先于task_table[i]的任务数: 固定最高的任务之间按周期排序，其余任务排在它们之后 */
+constexpr uint32_t rm_rank(const uint32_t i)
+{
+    const TaskSpec &self = task_table[i];
+    uint32_t rank = 0;
+    for (const auto &t : task_table) {
+        if (t.pinned != self.pinned) {
+            rank += t.pinned ? 1u : 0u;
+            continue;
+        }
+        if (t.period_us < self.period_us || (t.period_us == self.period_us && t.deadline_us < self.deadline_us))
+            rank++;
+    }
+    return rank;
+}
+
+/* 最高为osPriorityRealtime，最低用到osPriorityLow，osPriorityIdle留给空闲任务 */
+constexpr osPriority rm_priority(const uint32_t i)
+{
+    const int32_t p = osPriorityRealtime - static_cast<int32_t>(rm_rank(i));
+    return static_cast<osPriority>(p < osPriorityLow ? osPriorityLow : p);
+}
+
+/* 利用率，千分比 */
+constexpr uint32_t utilization_permille()
+{
+    uint32_t u = 0;
+    for (const auto &t : task_table)
+        u += t.budget_us * 1000u / t.period_us;
+    return u;
+}
+
+constexpr uint32_t stack_offset(const uint32_t i)
+{
+    uint32_t offset = 0;
+    for (uint32_t k = 0; k < i; k++)
+        offset += task_table[k].stack_words;
+    return offset;
+}
+
+/* 最坏响应时间: 预算加上优先级不低于它的其他任务在此期间的全部释放，超过截止时间即停止迭代 */
+constexpr uint32_t response_time_us(const uint32_t i)
+{
+    const TaskSpec &self = task_table[i];
+    uint32_t r = self.budget_us;
+    while (r <= self.deadline_us) {
+        uint32_t next = self.budget_us;
+        for (uint32_t k = 0; k < TASK_COUNT; k++) {
+            if (k != i && rm_rank(k) <= rm_rank(i))
+                next += (r + task_table[k].period_us - 1u) / task_table[k].period_us * task_table[k].budget_us;
+        }
+        if (next == r)
+            break;
+        r = next;
+    }
+    return r;
+}
+
+constexpr bool schedulable()
+{
+    for (uint32_t i = 0; i < TASK_COUNT; i++) {
+        if (response_time_us(i) > task_table[i].deadline_us)
+            return false;
+    }
+    return true;
+}
+
+constexpr bool table_valid()
+{
+    for (const auto &t : task_table) {
+        if (t.period_us == 0 || t.deadline_us == 0 || t.deadline_us > t.period_us * 100u ||
+            t.budget_us > t.deadline_us || t.stack_words < configMINIMAL_STACK_SIZE)
+            return false;
+    }
+    return true;
+}
+
+static_assert(table_valid(), "task_table: period/deadline/budget/stack out of range");
+static_assert(rm_rank(0) == 0 && rm_rank(1) == 1, "control (TIM7) must have the highest priority, ins (IMU rate) the next");
+static_assert(schedulable(), "task_table: a task's worst-case response time exceeds its deadline");
+static_assert(utilization_permille() <= TASK_CPU_BUDGET_PERCENT * 10u, "task_table exceeds the CPU budget");
+
+// 任务栈与TCB放在CCM RAM: 上下文切换与局部变量访问不与DMA争用总线；DMA缓冲区不能定义为局部变量
+CCM_BSS StackType_t task_stacks[stack_offset(TASK_COUNT)];
+CCM_BSS StaticTask_t task_tcbs[TASK_COUNT];
+osThreadId task_handles[TASK_COUNT];
+
+} // namespace
+
+void task_init()
+{
+    for (uint32_t i = 0; i < TASK_COUNT; i++) {
+        const TaskSpec &t = task_table[i];
+        const osThreadDef_t def = {
+            const_cast<char *>(t.name), t.entry, rm_priority(i), 0, t.stack_words,
+            &task_stacks[stack_offset(i)], &task_tcbs[i],
+        };
+        task_handles[i] = osThreadCreate(&def, NULL);
+        LOG_INFO("task %s prio %d %s %lu deadline %lu budget %lu wcrt %lu (us) stack %lu", t.name,
+                 (int)rm_priority(i), t.event ? "min interval" : "period", (unsigned long)t.period_us,
+                 (unsigned long)t.deadline_us, (unsigned long)t.budget_us, (unsigned long)response_time_us(i),
+                 (unsigned long)t.stack_words);
+    }
+    LOG_INFO("task utilization %lu.%lu%% (budget %d%%)", (unsigned long)(utilization_permille() / 10u),
+             (unsigned long)(utilization_permille() % 10u), TASK_CPU_BUDGET_PERCENT);
+}
@@ -1,6 +1,14 @@
 #ifndef STANDARD_ROBOT_TASK_INIT_H
 #define STANDARD_ROBOT_TASK_INIT_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 void task_init(void);
 
-#endif //STANDARD_ROBOT_TASK_INIT_H
\ No newline at end of file
+#ifdef __cplusplus
+}
+#endif
+
+#endif //STANDARD_ROBOT_TASK_INIT_H
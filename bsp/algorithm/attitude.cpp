@@ -0,0 +1,277 @@
+/**
+ * @file attitude.cpp
+ * @brief Mahony互补滤波与估计零偏的乘性四元数EKF
+ * 四元数运算用CMSIS-DSP的arm_quaternion_*_f32，EKF的协方差传播与增益计算用arm_mat_*_f32。
+ * 上位机精度与速度测试见tools/attitude_bench，片上单次更新的耗时见"bench att"
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "algorithm/attitude.h"
+#include "algorithm/fast_trig.h"
+
+namespace attitude {
+
+namespace {
+
+constexpr float GRAVITY = 9.80665f;
+
+/* 机体系中的重力方向，即旋转矩阵的第三行 */
+void gravity_body(const float *q, float *v)
+{
+    v[0] = 2.0f * (q[1] * q[3] - q[0] * q[2]);
+    v[1] = 2.0f * (q[2] * q[3] + q[0] * q[1]);
+    v[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+}
+
+float norm3(const float *v)
+{
+    float n;
+    arm_sqrt_f32(v[0] * v[0] + v[1] * v[1] + v[2] * v[2], &n);
+    return n;
+}
+
+} // namespace
+
+Euler to_euler(const float *q)
+{
+    const float w = q[0], x = q[1], y = q[2], z = q[3];
+    float sinp = 2.0f * (w * y - z * x);
+    sinp = sinp > 1.0f ? 1.0f : (sinp < -1.0f ? -1.0f : sinp);
+    float cosp;
+    arm_sqrt_f32(1.0f - sinp * sinp, &cosp);
+    return Euler{
+        trig::atan2(2.0f * (w * x + y * z), 1.0f - 2.0f * (x * x + y * y)),
+        trig::atan2(sinp, cosp),
+        trig::atan2(2.0f * (w * z + x * y), 1.0f - 2.0f * (y * y + z * z)),
+    };
+}
+
+void from_gravity(const float *accel, float *q)
+{
+    q[0] = 1.0f;
+    q[1] = q[2] = q[3] = 0.0f;
+    if (accel == nullptr || norm3(accel) == 0.0f)
+        return;
+
+    float ayz;
+    arm_sqrt_f32(accel[1] * accel[1] + accel[2] * accel[2], &ayz);
+    const trig::SinCos r = trig::sincos(0.5f * trig::atan2(accel[1], accel[2]));
+    const trig::SinCos p = trig::sincos(0.5f * trig::atan2(-accel[0], ayz));
+    q[0] = r.cos * p.cos;
+    q[1] = r.sin * p.cos;
+    q[2] = r.cos * p.sin;
+    q[3] = -r.sin * p.sin;
+}
+
+/* Mahony */
+
+Mahony::Mahony(const float kp, const float ki, const float accel_gate) : kp_(kp), ki_(ki), gate_(accel_gate) {}
+
+void Mahony::reset(const float *accel)
+{
+    from_gravity(accel, q_);
+    integral_[0] = integral_[1] = integral_[2] = 0.0f;
+}
+
+bool Mahony::update(const float *gyro, const float *accel, const float dt)
+{
+    float w[4] = {0.0f, gyro[0], gyro[1], gyro[2]};
+
+    const float n = norm3(accel);
+    const float dev = n / GRAVITY - 1.0f;
+    const bool use_accel = dev <= gate_ && dev >= -gate_;
+    if (use_accel) {
+        const float a[3] = {accel[0] / n, accel[1] / n, accel[2] / n};
+        float v[3];
+        gravity_body(q_, v);
+        const float e[3] = {a[1] * v[2] - a[2] * v[1], a[2] * v[0] - a[0] * v[2], a[0] * v[1] - a[1] * v[0]};
+        for (uint8_t i = 0; i < 3; i++) {
+            integral_[i] += learn_bias_ ? ki_ * e[i] * dt : 0.0f;
+            w[i + 1] += kp_ * e[i];
+        }
+    }
+    for (uint8_t i = 0; i < 3; i++)
+        w[i + 1] += integral_[i];
+
+    float dq[4];
+    arm_quaternion_product_single_f32(q_, w, dq);
+    for (uint8_t i = 0; i < 4; i++)
+        q_[i] += 0.5f * dt * dq[i];
+    arm_quaternion_normalize_f32(q_, q_, 1);
+    return use_accel;
+}
+
+void Mahony::bias(float *out) const
+{
+    for (uint8_t i = 0; i < 3; i++)
+        out[i] = -integral_[i];
+}
+
+/* EKF */
+
+Ekf::Ekf(const Config &config) : cfg_(config)
+{
+    arm_mat_init_f32(&P_m_, N, N, P_);
+    arm_mat_init_f32(&F_m_, N, N, F_);
+    arm_mat_init_f32(&Ft_m_, N, N, Ft_);
+    arm_mat_init_f32(&NN_m_, N, N, NN_);
+    arm_mat_init_f32(&H_m_, M, N, H_);
+    arm_mat_init_f32(&Ht_m_, N, M, Ht_);
+    arm_mat_init_f32(&PHt_m_, N, M, PHt_);
+    arm_mat_init_f32(&K_m_, N, M, K_);
+    arm_mat_init_f32(&HP_m_, M, N, HP_);
+    arm_mat_init_f32(&S_m_, M, M, S_);
+    arm_mat_init_f32(&Sinv_m_, M, M, Sinv_);
+    reset(nullptr);
+}
+
+void Ekf::reset(const float *accel)
+{
+    from_gravity(accel, q_);
+    b_[0] = b_[1] = b_[2] = 0.0f;
+    rejected_ = 0;
+
+    // 由重力得到的横滚、俯仰误差取0.1rad，偏航任意，取1rad
+    const float b2 = cfg_.init_bias_std * cfg_.init_bias_std;
+    const float p0[N] = {0.01f, 0.01f, 1.0f, b2, b2, b2};
+    for (uint16_t i = 0; i < N * N; i++)
+        P_[i] = 0.0f;
+    for (uint16_t i = 0; i < N; i++)
+        P_[i * N + i] = p0[i];
+}
+
+void Ekf::predict(const float *gyro, const float dt)
+{
+    const float wx = (gyro[0] - b_[0]) * dt;
+    const float wy = (gyro[1] - b_[1]) * dt;
+    const float wz = (gyro[2] - b_[2]) * dt;
+
+    const float dq[4] = {1.0f, 0.5f * wx, 0.5f * wy, 0.5f * wz};
+    float qn[4];
+    arm_quaternion_product_single_f32(q_, dq, qn);
+    arm_quaternion_normalize_f32(qn, q_, 1);
+
+    // F = [I - [ω×]dt, -I dt; 0, I]
+    const float f[N * N] = {
+        1.0f, wz,   -wy,  -dt,  0.0f, 0.0f,
+        -wz,  1.0f, wx,   0.0f, -dt,  0.0f,
+        wy,   -wx,  1.0f, 0.0f, 0.0f, -dt,
+        0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+    };
+    for (uint16_t i = 0; i < N * N; i++)
+        F_[i] = f[i];
+
+    // P = F P F' + Q
+    arm_mat_trans_f32(&F_m_, &Ft_m_);
+    arm_mat_mult_f32(&F_m_, &P_m_, &NN_m_);
+    arm_mat_mult_f32(&NN_m_, &Ft_m_, &P_m_);
+
+    const float qa = cfg_.gyro_noise * dt * cfg_.gyro_noise * dt;
+    const float qb = cfg_.bias_walk * cfg_.bias_walk * dt;
+    for (uint16_t i = 0; i < N; i++)
+        P_[i * N + i] += i < 3 ? qa : qb;
+}
+
+void Ekf::hold_bias()
+{
+    const float b2 = cfg_.init_bias_std * cfg_.init_bias_std;
+    for (uint16_t i = 0; i < 3; i++) {
+        for (uint16_t j = 3; j < N; j++) {
+            P_[i * N + j] = P_[j * N + i] = 0.0f;
+            P_[j * N + i + 3] = i + 3 == j ? b2 : 0.0f;
+        }
+    }
+}
+
+bool Ekf::correct(const float *accel)
+{
+    const float n = norm3(accel);
+    const float dev = n / GRAVITY - 1.0f;
+    if (dev > cfg_.accel_gate || dev < -cfg_.accel_gate) {
+        rejected_++;
+        return false;
+    }
+
+    float v[3];
+    gravity_body(q_, v);
+    const float y[M] = {accel[0] / n - v[0], accel[1] / n - v[1], accel[2] / n - v[2]};
+
+    // 机体系误差δθ使重力方向变为v + [v×]δθ，对零偏的偏导为0
+    const float hm[M * N] = {
+        0.0f,  -v[2], v[1],  0.0f, 0.0f, 0.0f,
+        v[2],  0.0f,  -v[0], 0.0f, 0.0f, 0.0f,
+        -v[1], v[0],  0.0f,  0.0f, 0.0f, 0.0f,
+    };
+    for (uint16_t i = 0; i < M * N; i++)
+        H_[i] = hm[i];
+
+    // S = H P H' + R
+    arm_mat_trans_f32(&H_m_, &Ht_m_);
+    arm_mat_mult_f32(&P_m_, &Ht_m_, &PHt_m_);
+    arm_mat_mult_f32(&H_m_, &PHt_m_, &S_m_);
+    const float r = cfg_.accel_noise * cfg_.accel_noise;
+    for (uint16_t i = 0; i < M; i++)
+        S_[i * M + i] += r;
+    if (arm_mat_inverse_f32(&S_m_, &Sinv_m_) != ARM_MATH_SUCCESS) {
+        rejected_++;
+        return false;
+    }
+
+    // 新息的马氏距离 y' S^-1 y
+    float d2 = 0.0f;
+    for (uint16_t i = 0; i < M; i++)
+        d2 += y[i] * (Sinv_[i * M] * y[0] + Sinv_[i * M + 1] * y[1] + Sinv_[i * M + 2] * y[2]);
+    if (d2 > cfg_.innov_gate) {
+        rejected_++;
+        return false;
+    }
+
+    // K = P H' S^-1，δx = K y
+    arm_mat_mult_f32(&PHt_m_, &Sinv_m_, &K_m_);
+    float dx[N];
+    for (uint16_t i = 0; i < N; i++)
+        dx[i] = K_[i * M] * y[0] + K_[i * M + 1] * y[1] + K_[i * M + 2] * y[2];
+
+    const float dq[4] = {1.0f, 0.5f * dx[0], 0.5f * dx[1], 0.5f * dx[2]};
+    float qn[4];
+    arm_quaternion_product_single_f32(q_, dq, qn);
+    arm_quaternion_normalize_f32(qn, q_, 1);
+    b_[0] += dx[3];
+    b_[1] += dx[4];
+    b_[2] += dx[5];
+
+    // P -= K H P，P对称，H P = (P H')'
+    arm_mat_trans_f32(&PHt_m_, &HP_m_);
+    arm_mat_mult_f32(&K_m_, &HP_m_, &NN_m_);
+    arm_mat_sub_f32(&P_m_, &NN_m_, &P_m_);
+
+    // 消除舍入造成的不对称
+    for (uint16_t i = 0; i < N; i++) {
+        for (uint16_t j = i + 1; j < N; j++) {
+            const float s = 0.5f * (P_[i * N + j] + P_[j * N + i]);
+            P_[i * N + j] = P_[j * N + i] = s;
+        }
+    }
+    return true;
+}
+
+bool Ekf::update(const float *gyro, const float *accel, const float dt)
+{
+    predict(gyro, dt);
+    // 零偏与姿态不相关时K的零偏行为0，correct不改变零偏
+    if (!learn_bias_)
+        hold_bias();
+    return correct(accel);
+}
+
+void Ekf::bias(float *out) const
+{
+    out[0] = b_[0];
+    out[1] = b_[1];
+    out[2] = b_[2];
+}
+
+} // namespace attitude
@@ -0,0 +1,139 @@
+#ifndef STANDARD_ROBOT_ATTITUDE_H
+#define STANDARD_ROBOT_ATTITUDE_H
+
+#include "typedef.h"
+
+#ifdef __cplusplus
+#include "arm_math.h"
+
+/*
+ * 由陀螺仪与加速度计估计姿态。四元数按CMSIS-DSP的顺序[w, x, y, z]，表示机体系到世界系的旋转，
+ * 世界系z轴向上；静止水平放置时加速度计读数为(0, 0, +g)。
+ * 只用重力观测，偏航角没有绝对参考，随陀螺仪z轴零偏漂移
+ */
+namespace attitude {
+
+/* ZYX欧拉角 rad，俯仰在±π/2处奇异 */
+struct Euler
+{
+    float roll;
+    float pitch;
+    float yaw;
+};
+
+Euler to_euler(const float *q);
+
+/* 由重力方向得到偏航为0的初始四元数，accel为0时返回单位四元数 */
+void from_gravity(const float *accel, float *q);
+
+/**
+ * @brief Mahony互补滤波
+ * 加速度计方向与四元数预测的重力方向的叉积作为误差，比例项修正角速度，积分项估计零偏；
+ * 加速度模长偏离g超过accel_gate时只积分陀螺仪
+ */
+class Mahony
+{
+public:
+    /* kp、ki的单位为 rad/s 每单位误差，kp越大越信任加速度计 */
+    Mahony(float kp, float ki, float accel_gate = 0.15f);
+
+    void reset(const float *accel);
+
+    /* gyro rad/s，accel m/s²，dt s；返回是否使用了加速度计 */
+    bool update(const float *gyro, const float *accel, float dt);
+
+    [[nodiscard]] const float *quat() const { return q_; }
+    /* 估计的陀螺仪零偏 rad/s，rate = gyro - bias */
+    void bias(float *out) const;
+
+    /* 关闭时积分项保持不变，零偏估计冻结在当前值 */
+    void set_bias_learning(bool enable) { learn_bias_ = enable; }
+
+private:
+    float kp_;
+    float ki_;
+    float gate_;
+    bool learn_bias_ = true;
+    float q_[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+    float integral_[3] = {};
+};
+
+/**
+ * @brief 估计陀螺仪零偏的乘性(误差状态)扩展卡尔曼滤波
+ * 名义状态为四元数q与零偏b，误差状态x = [δθ(3), δb(3)]，δθ为机体系中的小角度误差，
+ * 四元数不直接参与协方差运算，不存在加性四元数EKF中模长方向不受约束的问题。
+ * 预测: q = q ⊗ (1, (ω - b)dt/2)，F = [I - [ω×]dt, -I dt; 0, I]；
+ * 观测: 归一化的加速度计读数 = 机体系中的重力方向v，H = [[v×], 0]；
+ * 修正后q = q ⊗ (1, δθ/2)，b += δb。
+ * 协方差运算全部用arm_mat_*_f32，每次update为固定的矩阵运算序列。
+ * 加速度模长偏离g超过accel_gate，或新息的马氏距离平方超过innov_gate时(机动、碰撞)只做预测
+ */
+class Ekf
+{
+public:
+    static constexpr uint16_t N = 6;    // 误差状态维数
+    static constexpr uint16_t M = 3;    // 观测维数
+
+    struct Config
+    {
+        float gyro_noise;       // 陀螺仪噪声 rad/s
+        float bias_walk;        // 零偏随机游走 rad/s/√s
+        float accel_noise;      // 归一化加速度的观测噪声
+        float accel_gate;       // |a|/g - 1的允许范围
+        float innov_gate;       // 新息马氏距离平方的上限，3自由度χ²
+        float init_bias_std;    // 零偏初始标准差 rad/s
+    };
+
+    static constexpr Config default_config = {0.01f, 0.0005f, 0.05f, 0.15f, 16.0f, 0.02f};
+
+    explicit Ekf(const Config &config = default_config);
+    Ekf(const Ekf &) = delete;
+    Ekf &operator=(const Ekf &) = delete;
+
+    void reset(const float *accel);
+
+    /* gyro rad/s，accel m/s²，dt s；返回是否使用了加速度计观测 */
+    bool update(const float *gyro, const float *accel, float dt);
+
+    [[nodiscard]] const float *quat() const { return q_; }
+    void bias(float *out) const;
+
+    /*
+     * 关闭时零偏固定为当前估计值，作为已知量参与预测: 零偏方差保持为init_bias_std²，
+     * 与姿态误差的协方差清零，观测不再修正零偏，零偏的不确定性只使姿态协方差增大。
+     * 重新打开时从init_bias_std开始收敛。用于IMU温度稳定前，避免学到随温度变化的零偏
+     */
+    void set_bias_learning(bool enable) { learn_bias_ = enable; }
+
+    /* 被门限拒绝的加速度计观测数 */
+    [[nodiscard]] uint32_t rejected() const { return rejected_; }
+
+private:
+    Config cfg_;
+    float q_[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+    float b_[3] = {};
+    bool learn_bias_ = true;
+    uint32_t rejected_ = 0;
+    float P_[N * N] = {};
+    float F_[N * N] = {};
+    float Ft_[N * N] = {};
+    float NN_[N * N] = {};      // 中间结果
+    float H_[M * N] = {};
+    float Ht_[N * M] = {};
+    float PHt_[N * M] = {};
+    float K_[N * M] = {};
+    float HP_[M * N] = {};
+    float S_[M * M] = {};
+    float Sinv_[M * M] = {};
+
+    arm_matrix_instance_f32 P_m_, F_m_, Ft_m_, NN_m_, H_m_, Ht_m_, PHt_m_, K_m_, HP_m_, S_m_, Sinv_m_;
+
+    void predict(const float *gyro, float dt);
+    void hold_bias();
+    bool correct(const float *accel);
+};
+
+} // namespace attitude
+#endif
+
+#endif //STANDARD_ROBOT_ATTITUDE_H
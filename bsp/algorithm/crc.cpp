@@ -0,0 +1,86 @@
+/**
+ * @file crc.cpp
+ * @brief 循环冗余校验算法
+ * 用于获得通信协议中的校验位数据
+ * 查找表由crc::Engine在编译期生成，较长的数据按slice-by-N每次处理多个字节，
+ * C接口保持不变，作为crc::Crc8/crc::Crc16的包装
+ * @version 2.0
+ * @date 2026-10-19
+ */
+
+#include "algorithm/crc.h"
+
+// 与原手写查找表逐项一致
+static_assert(crc::Crc8::table[0][1] == 0x5e && crc::Crc8::table[0][255] == 0x35);
+static_assert(crc::Crc16::table[0][1] == 0x1189 && crc::Crc16::table[0][255] == 0x0f78);
+
+static constexpr uint8_t CRC8_INIT = 0xff;
+static constexpr uint16_t CRC_INIT = 0xffff;
+
+/*
+** Descriptions: CRC8 checksum function
+** Input: Data to check,Stream length, initialized checksum
+** Output: CRC checksum
+*/
+uint8_t Get_CRC8_Check_Sum(uint8_t *pchMessage, uint32_t dwLength, uint8_t ucCRC8)
+{
+    return crc::Crc8::compute(ucCRC8, pchMessage, dwLength);
+}
+
+/*
+** Descriptions: CRC8 Verify function
+** Input: Data to Verify,Stream length = Data + checksum
+** Output: True or False (CRC Verify Result)
+*/
+uint8_t Verify_CRC8_Check_Sum(uint8_t *pchMessage, uint32_t dwLength)
+{
+    if ((pchMessage == nullptr) || (dwLength <= 2)) return 0;
+    return crc::Crc8::compute(CRC8_INIT, pchMessage, dwLength - 1) == pchMessage[dwLength - 1];
+}
+
+/*
+** Descriptions: append CRC8 to the end of data
+** Input: Data to CRC and append,Stream length = Data + checksum
+** Output: True or False (CRC Verify Result)
+*/
+void Append_CRC8_Check_Sum(uint8_t *pchMessage, uint32_t dwLength)
+{
+    if ((pchMessage == nullptr) || (dwLength <= 2)) return;
+    pchMessage[dwLength - 1] = crc::Crc8::compute(CRC8_INIT, pchMessage, dwLength - 1);
+}
+
+/*
+** Descriptions: CRC16 checksum function
+** Input: Data to check,Stream length, initialized checksum
+** Output: CRC checksum
+*/
+uint16_t Get_CRC16_Check_Sum(uint8_t *pchMessage, uint32_t dwLength, uint16_t wCRC)
+{
+    if (pchMessage == nullptr) return 0xFFFF;
+    return crc::Crc16::compute(wCRC, pchMessage, dwLength);
+}
+
+/*
+** Descriptions: CRC16 Verify function
+** Input: Data to Verify,Stream length = Data + checksum
+** Output: True or False (CRC Verify Result)
+*/
+uint8_t Verify_CRC16_Check_Sum(uint8_t *pchMessage, uint32_t dwLength)
+{
+    if ((pchMessage == nullptr) || (dwLength <= 2)) return 0;
+    const uint16_t wExpected = crc::Crc16::compute(CRC_INIT, pchMessage, dwLength - 2);
+    return ((wExpected & 0xff) == pchMessage[dwLength - 2] && ((wExpected >> 8) & 0xff) == pchMessage[dwLength - 1]);
+}
+
+/*
+** Descriptions: append CRC16 to the end of data
+** Input: Data to CRC and append,Stream length = Data + checksum
+** Output: True or False (CRC Verify Result)
+*/
+void Append_CRC16_Check_Sum(uint8_t *pchMessage, uint32_t dwLength)
+{
+    if ((pchMessage == nullptr) || (dwLength <= 2)) return;
+    const uint16_t wCRC = crc::Crc16::compute(CRC_INIT, pchMessage, dwLength - 2);
+    pchMessage[dwLength - 2] = (uint8_t)(wCRC & 0x00ff);
+    pchMessage[dwLength - 1] = (uint8_t)((wCRC >> 8) & 0x00ff);
+}
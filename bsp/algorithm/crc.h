@@ -16,4 +16,165 @@ void Append_CRC16_Check_Sum(uint8_t * pchMessage,uint32_t dwLength) ;
 #ifdef __cplusplus
 }
 #endif
+
+#ifdef __cplusplus
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace crc {
+
+/**
+ * @brief 反射(低位先行)查表CRC，查找表在编译期由多项式生成
+ * Slices为4或8时每次处理4/8字节(slice-by-N)，剩余字节逐字节处理；为1时与逐字节查表相同。
+ * 多字节读取按小端序拼接，仅适用于小端平台
+ * @tparam T      CRC宽度(不超过32位)
+ * @tparam Poly   反射后的生成多项式
+ * @tparam Init   初值
+ * @tparam Slices 每轮处理的字节数，1/4/8，表大小为Slices * 256 * sizeof(T)
+ */
+template <typename T, T Poly, T Init, unsigned Slices>
+class Engine {
+    static_assert(Slices == 1 || Slices == 4 || Slices == 8, "Slices must be 1, 4 or 8");
+    static_assert(sizeof(T) <= 4);
+    static_assert(std::endian::native == std::endian::little);
+
+public:
+    using Table = std::array<std::array<T, 256>, Slices>;
+
+    static constexpr Table make_table()
+    {
+        Table t{};
+        for (unsigned i = 0; i < 256; i++) {
+            T c = static_cast<T>(i);
+            for (int bit = 0; bit < 8; bit++)
+                c = (c & 1u) ? static_cast<T>((c >> 1) ^ Poly) : static_cast<T>(c >> 1);
+            t[0][i] = c;
+        }
+        // t[k][i]: 字节i后接k个0字节的CRC
+        for (unsigned k = 1; k < Slices; k++)
+            for (unsigned i = 0; i < 256; i++)
+                t[k][i] = static_cast<T>((static_cast<uint32_t>(t[k - 1][i]) >> 8) ^ t[0][t[k - 1][i] & 0xFFu]);
+        return t;
+    }
+
+    static constexpr Table table = make_table();
+
+    /**
+     * @brief 从crc开始继续计算n字节，不做结果异或，与Get_CRC*_Check_Sum一致
+     * 可在编译期求值(逐字节)，用于预先算出固定帧头的校验值
+     */
+    static constexpr T compute(const T crc, const uint8_t *p, const size_t n)
+    {
+        if (std::is_constant_evaluated()) {
+            uint32_t c = crc;
+            for (size_t i = 0; i < n; i++)
+                c = (c >> 8) ^ table[0][(c ^ p[i]) & 0xFFu];
+            return static_cast<T>(c);
+        }
+        return process<false>(crc, nullptr, p, n);
+    }
+
+    static constexpr T compute(const uint8_t *p, const size_t n)
+    {
+        return compute(Init, p, n);
+    }
+
+    /**
+     * @brief 把src复制到dst的同时计算CRC，数据只读一遍
+     */
+    static T compute_copy(const T crc, uint8_t *dst, const void *src, const size_t n)
+    {
+        return process<true>(crc, dst, static_cast<const uint8_t *>(src), n);
+    }
+
+    /* 流式接口: 数据可分多次送入，如逐段解析的接收帧 */
+    constexpr Engine() = default;
+    explicit constexpr Engine(const T state) : crc_(state) {}
+
+    void reset() { crc_ = Init; }
+
+    Engine &update(const uint8_t *p, const size_t n)
+    {
+        crc_ = compute(crc_, p, n);
+        return *this;
+    }
+
+    Engine &update_copy(uint8_t *dst, const void *src, const size_t n)
+    {
+        crc_ = compute_copy(crc_, dst, src, n);
+        return *this;
+    }
+
+    Engine &update(const uint8_t byte)
+    {
+        crc_ = static_cast<T>((static_cast<uint32_t>(crc_) >> 8) ^ table[0][(crc_ ^ byte) & 0xFFu]);
+        return *this;
+    }
+
+    [[nodiscard]] T finalize() const { return crc_; }
+
+    /* 按小端序写出校验值，与Append_CRC*_Check_Sum的字节序一致 */
+    void finalize(uint8_t *dst) const
+    {
+        for (size_t i = 0; i < sizeof(T); i++)
+            dst[i] = static_cast<uint8_t>(crc_ >> (8 * i));
+    }
+
+private:
+    T crc_ = Init;
+
+    template <bool Copy>
+    static T process(const T crc, uint8_t *dst, const uint8_t *p, size_t n)
+    {
+        uint32_t c = crc;
+
+        if constexpr (Slices == 8) {
+            for (; n >= 8; n -= 8, p += 8) {
+                uint32_t w0, w1;
+                std::memcpy(&w0, p, 4);
+                std::memcpy(&w1, p + 4, 4);
+                if constexpr (Copy) {
+                    std::memcpy(dst, &w0, 4);
+                    std::memcpy(dst + 4, &w1, 4);
+                    dst += 8;
+                }
+                c ^= w0;
+                c = table[7][c & 0xFFu] ^ table[6][(c >> 8) & 0xFFu] ^
+                    table[5][(c >> 16) & 0xFFu] ^ table[4][c >> 24] ^
+                    table[3][w1 & 0xFFu] ^ table[2][(w1 >> 8) & 0xFFu] ^
+                    table[1][(w1 >> 16) & 0xFFu] ^ table[0][w1 >> 24];
+            }
+        }
+        else if constexpr (Slices == 4) {
+            for (; n >= 4; n -= 4, p += 4) {
+                uint32_t w;
+                std::memcpy(&w, p, 4);
+                if constexpr (Copy) {
+                    std::memcpy(dst, &w, 4);
+                    dst += 4;
+                }
+                c ^= w;
+                c = table[3][c & 0xFFu] ^ table[2][(c >> 8) & 0xFFu] ^
+                    table[1][(c >> 16) & 0xFFu] ^ table[0][c >> 24];
+            }
+        }
+        while (n--) {
+            if constexpr (Copy)
+                *dst++ = *p;
+            c = (c >> 8) ^ table[0][(c ^ *p++) & 0xFFu];
+        }
+        return static_cast<T>(c);
+    }
+};
+
+// crc8: G(x)=x8+x5+x4+1，crc16: CCITT(0x1021)，均为反射形式，初值全1
+using Crc8 = Engine<uint8_t, 0x8C, 0xFF, 4>;
+using Crc16 = Engine<uint16_t, 0x8408, 0xFFFF, 8>;
+
+} // namespace crc
+#endif
+
 #endif
@@ -0,0 +1,43 @@
+/**
+ * @file fast_trig.cpp
+ * @brief CMSIS-DSP快速三角函数用的sin表
+ * 本工程中的CMSIS-DSP源码不含arm_common_tables.c，arm_sin_cos_f32、arm_sin_f32等所需的
+ * sinTable_f32由trig::detail中的编译期生成器给出，取值与CMSIS-DSP原表相同(sin(2πi/512)舍入到float)
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "algorithm/fast_trig.h"
+#include "arm_math.h"
+#include "arm_common_tables.h"
+
+namespace {
+
+constexpr auto cmsis_sin = trig::detail::make_sin_table<FAST_MATH_TABLE_SIZE + 1>(FAST_MATH_TABLE_SIZE);
+
+static_assert(FAST_MATH_TABLE_SIZE == 512, "SIN_T256 below expands exactly 512 + 1 entries");
+static_assert(cmsis_sin[0] == 0.0f);
+static_assert(cmsis_sin[1] == 0.01227153829f);
+static_assert(cmsis_sin[FAST_MATH_TABLE_SIZE / 4] == 1.0f);
+
+} // namespace
+
+/*
+ * 定义须与arm_common_tables.h中的声明类型相同(float32_t[FAST_MATH_TABLE_SIZE + 1])，
+ * 非模板的数组定义只能用花括号列出初值，由预处理器按下标展开编译期生成的表
+ */
+#define SIN_T1(i)   cmsis_sin[i],
+#define SIN_T4(i)   SIN_T1(i) SIN_T1(i + 1) SIN_T1(i + 2) SIN_T1(i + 3)
+#define SIN_T16(i)  SIN_T4(i) SIN_T4(i + 4) SIN_T4(i + 8) SIN_T4(i + 12)
+#define SIN_T64(i)  SIN_T16(i) SIN_T16(i + 16) SIN_T16(i + 32) SIN_T16(i + 48)
+#define SIN_T256(i) SIN_T64(i) SIN_T64(i + 64) SIN_T64(i + 128) SIN_T64(i + 192)
+
+const float32_t sinTable_f32[FAST_MATH_TABLE_SIZE + 1] = {
+    SIN_T256(0) SIN_T256(256) cmsis_sin[FAST_MATH_TABLE_SIZE]
+};
+
+#undef SIN_T1
+#undef SIN_T4
+#undef SIN_T16
+#undef SIN_T64
+#undef SIN_T256
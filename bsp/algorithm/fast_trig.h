@@ -0,0 +1,203 @@
+#ifndef STANDARD_ROBOT_FAST_TRIG_H
+#define STANDARD_ROBOT_FAST_TRIG_H
+
+#include "typedef.h"
+
+#ifdef __cplusplus
+#include <array>
+
+/*
+ * 查表三角函数，表在编译期生成，表内插值用泰勒展开修正。
+ * 角度统一用二进制角(bangle)表示: uint32_t，一周为2^32，加减自然回绕，不需要归一化；
+ * 两个角的差转为int32_t即为(-180°, 180°]内的有符号差。
+ *
+ * 最大绝对误差(tools/trig_bench在全部2^32个二进制角中按步长4096扫描、对双精度参考给出):
+ *   sin_b/cos_b/sincos_b   7e-8          (arm_sin_cos_f32为2.2e-7)
+ *   atan2                  3e-7 rad      (atan2f为2.5e-7)
+ * 浮点弧度/角度输入还要加上转为二进制角时的舍入，不超过|rad| * 1.2e-7
+ */
+namespace trig {
+
+using bangle = uint32_t;
+
+constexpr double PI_D = 3.14159265358979323846;
+constexpr float BANGLE_PER_RAD = static_cast<float>(4294967296.0 / (2.0 * PI_D));
+constexpr float RAD_PER_BANGLE = static_cast<float>(2.0 * PI_D / 4294967296.0);
+constexpr float BANGLE_PER_DEG = static_cast<float>(4294967296.0 / 360.0);
+constexpr float DEG_PER_BANGLE = static_cast<float>(360.0 / 4294967296.0);
+
+constexpr bangle QUARTER = 1u << 30;
+constexpr bangle HALF = 1u << 31;
+
+namespace detail {
+
+/* 编译期使用的双精度函数，只用于生成表 */
+constexpr double sin_series(double x)
+{
+    // 归约到[-π/2, π/2]，泰勒级数在该区间内25项后误差远小于双精度舍入
+    while (x > PI_D) x -= 2.0 * PI_D;
+    while (x < -PI_D) x += 2.0 * PI_D;
+    if (x > PI_D / 2) x = PI_D - x;
+    if (x < -PI_D / 2) x = -PI_D - x;
+
+    double term = x, sum = x;
+    for (int n = 1; n < 25; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double sqrt_newton(const double x)
+{
+    double y = x > 1.0 ? x : 1.0;
+    for (int i = 0; i < 64; i++)
+        y = 0.5 * (y + x / y);
+    return y;
+}
+
+/* x在[0, 1]内: 先用半角公式把x缩小到0.42以内，再用泰勒级数 */
+constexpr double atan_series(const double x)
+{
+    const double r = x / (1.0 + sqrt_newton(1.0 + x * x));
+    double term = r, sum = r;
+    for (int n = 1; n < 60; n++) {
+        term *= -r * r;
+        sum += term / (2 * n + 1);
+    }
+    return 2.0 * sum;
+}
+
+template <size_t N>
+constexpr std::array<float, N> make_sin_table(const size_t period)
+{
+    std::array<float, N> t{};
+    for (size_t i = 0; i < N; i++)
+        t[i] = static_cast<float>(sin_series(2.0 * PI_D * static_cast<double>(i) / static_cast<double>(period)));
+    return t;
+}
+
+/* sin表: 一周SIN_BITS位，即256个点 */
+constexpr unsigned SIN_BITS = 8;
+constexpr size_t SIN_SIZE = size_t{1} << SIN_BITS;
+inline constexpr std::array<float, SIN_SIZE> sin_table = make_sin_table<SIN_SIZE>(SIN_SIZE);
+
+/*
+ * atan表: [0, 1]上ATAN_SIZE + 1个点，每点存atan(t0)及其1~3阶泰勒系数，
+ * atan(t0 + d) ≈ c0 + d * (c1 + d * (c2 + d * c3))，|d| <= 1 / (2 * ATAN_SIZE)
+ */
+constexpr size_t ATAN_SIZE = 32;
+constexpr std::array<std::array<float, 4>, ATAN_SIZE + 1> make_atan_table()
+{
+    std::array<std::array<float, 4>, ATAN_SIZE + 1> t{};
+    for (size_t i = 0; i <= ATAN_SIZE; i++) {
+        const double t0 = static_cast<double>(i) / ATAN_SIZE;
+        const double c1 = 1.0 / (1.0 + t0 * t0);
+        t[i][0] = static_cast<float>(atan_series(t0));
+        t[i][1] = static_cast<float>(c1);
+        t[i][2] = static_cast<float>(-t0 * c1 * c1);
+        t[i][3] = static_cast<float>((3.0 * t0 * t0 - 1.0) * c1 * c1 * c1 / 3.0);
+    }
+    return t;
+}
+inline constexpr auto atan_table = make_atan_table();
+
+} // namespace detail
+
+struct SinCos
+{
+    float sin;
+    float cos;
+};
+
+/* 弧度转二进制角，任意圈数自动回绕，|rad| < 1e9 */
+constexpr bangle from_rad(const float rad)
+{
+    float turns = rad * static_cast<float>(1.0 / (2.0 * PI_D));
+    turns -= static_cast<float>(static_cast<int32_t>(turns));   // (-1, 1)
+    return static_cast<bangle>(static_cast<int32_t>(turns * 2147483648.0f)) << 1;
+}
+
+/* 二进制角转弧度，结果在[-π, π) */
+constexpr float to_rad(const bangle a) { return static_cast<float>(static_cast<int32_t>(a)) * RAD_PER_BANGLE; }
+
+constexpr bangle from_deg(const float deg)
+{
+    float turns = deg * static_cast<float>(1.0 / 360.0);
+    turns -= static_cast<float>(static_cast<int32_t>(turns));
+    return static_cast<bangle>(static_cast<int32_t>(turns * 2147483648.0f)) << 1;
+}
+
+/* 二进制角转角度，结果在[-180, 180) */
+constexpr float to_deg(const bangle a) { return static_cast<float>(static_cast<int32_t>(a)) * DEG_PER_BANGLE; }
+
+/* 编码器读数转二进制角，如DJI电机为13位(0~8191) */
+template <unsigned Bits>
+constexpr bangle from_ecd(const uint32_t ecd)
+{
+    static_assert(Bits > 0 && Bits <= 32);
+    return static_cast<bangle>(ecd << (32 - Bits));
+}
+
+/* a相对b的有符号差，(-π, π]对应(INT32_MIN, INT32_MAX] */
+constexpr int32_t diff(const bangle a, const bangle b) { return static_cast<int32_t>(a - b); }
+
+/**
+ * @brief 同时计算sin与cos
+ * 取最近的表项(步长2π/256)，余下的|d| <= π/256用三阶泰勒展开:
+ * sin(a+d) ≈ s + d(c - d(s/2 + d c/6))，cos(a+d) ≈ c - d(s + d(c/2 - d s/6))
+ */
+constexpr SinCos sincos_b(const bangle a)
+{
+    constexpr unsigned shift = 32 - detail::SIN_BITS;
+    constexpr uint32_t mask = detail::SIN_SIZE - 1;
+
+    const uint32_t i = (a + (1u << (shift - 1))) >> shift;
+    const float d = static_cast<float>(static_cast<int32_t>(a - (i << shift))) * RAD_PER_BANGLE;
+    const float s = detail::sin_table[i & mask];
+    const float c = detail::sin_table[(i + detail::SIN_SIZE / 4) & mask];
+
+    return SinCos{
+        s + d * (c - d * (0.5f * s + d * (1.0f / 6.0f) * c)),
+        c - d * (s + d * (0.5f * c - d * (1.0f / 6.0f) * s)),
+    };
+}
+
+constexpr float sin_b(const bangle a) { return sincos_b(a).sin; }
+constexpr float cos_b(const bangle a) { return sincos_b(a).cos; }
+
+constexpr SinCos sincos(const float rad) { return sincos_b(from_rad(rad)); }
+constexpr float sin(const float rad) { return sin_b(from_rad(rad)); }
+constexpr float cos(const float rad) { return cos_b(from_rad(rad)); }
+
+/**
+ * @brief atan2，结果在[-π, π]，x、y都为0时返回0
+ * 先按八分圆归约到t = min/max ∈ [0, 1](一次除法)，再查表加三阶泰勒修正
+ */
+constexpr float atan2(const float y, const float x)
+{
+    const float ax = x < 0.0f ? -x : x;
+    const float ay = y < 0.0f ? -y : y;
+    const bool swap = ay > ax;
+    const float num = swap ? ax : ay;
+    const float den = swap ? ay : ax;
+    if (den == 0.0f)
+        return 0.0f;
+
+    const float t = num / den;
+    const uint32_t i = static_cast<uint32_t>(t * detail::ATAN_SIZE + 0.5f);
+    const float d = t - static_cast<float>(i) * (1.0f / detail::ATAN_SIZE);
+    const auto &c = detail::atan_table[i];
+    float r = c[0] + d * (c[1] + d * (c[2] + d * c[3]));
+
+    if (swap) r = static_cast<float>(PI_D / 2) - r;
+    if (x < 0.0f) r = static_cast<float>(PI_D) - r;
+    return y < 0.0f ? -r : r;
+}
+
+constexpr bangle atan2_b(const float y, const float x) { return from_rad(atan2(y, x)); }
+
+} // namespace trig
+#endif
+
+#endif //STANDARD_ROBOT_FAST_TRIG_H
@@ -0,0 +1,100 @@
+/**
+ * @file filter.cpp
+ * @brief 二阶节(biquad)级联滤波器的设计
+ * 由截止频率/中心频率和品质因数计算系数，模拟原型经预畸变的双线性变换离散化，
+ * 只在初始化时调用，使用双精度计算。滤波运算见filter.h，成块处理由CMSIS-DSP完成
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "algorithm/filter.h"
+#include <cmath>
+
+namespace filter {
+
+namespace {
+
+constexpr double pi = 3.14159265358979323846;
+
+bool valid_freq(const float fs, const float f)
+{
+    return fs > 0.0f && f > 0.0f && f < 0.5f * fs;
+}
+
+/**
+ * @brief 归一化并转换为CMSIS-DSP的符号约定
+ * 输入为 H(z) = (b0 + b1 z^-1 + b2 z^-2) / (a0 + a1 z^-1 + a2 z^-2)
+ */
+Biquad normalize(const double b0, const double b1, const double b2,
+                 const double a0, const double a1, const double a2)
+{
+    return Biquad{
+        static_cast<float>(b0 / a0),
+        static_cast<float>(b1 / a0),
+        static_cast<float>(b2 / a0),
+        static_cast<float>(-a1 / a0),
+        static_cast<float>(-a2 / a0),
+    };
+}
+
+} // namespace
+
+/**
+ * @brief Butterworth低通
+ * 模拟原型的极点均匀分布在左半单位圆上，每对共轭极点为一个二阶节，
+ * 第i节的品质因数 Q = 1 / (2 sin((2i+1)π / 2N))
+ */
+bool butter_lowpass(Biquad *out, const float fs, const float fc, const uint8_t order)
+{
+    if (order == 0 || !valid_freq(fs, fc))
+        return false;
+
+    const double k = std::tan(pi * fc / fs);
+    const double k2 = k * k;
+
+    for (uint8_t i = 0; i < order / 2; i++) {
+        const double q = 1.0 / (2.0 * std::sin((2 * i + 1) * pi / (2.0 * order)));
+        out[i] = normalize(k2, 2.0 * k2, k2,
+                           1.0 + k / q + k2, 2.0 * (k2 - 1.0), 1.0 - k / q + k2);
+    }
+    if (order & 1u) {
+        out[order / 2] = normalize(k, k, 0.0,
+                                   1.0 + k, k - 1.0, 0.0);
+    }
+    return true;
+}
+
+bool notch(Biquad *out, const float fs, const float f0, const float q)
+{
+    if (q <= 0.0f || !valid_freq(fs, f0))
+        return false;
+
+    const double w0 = 2.0 * pi * f0 / fs;
+    const double cw = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+
+    *out = normalize(1.0, -2.0 * cw, 1.0,
+                     1.0 + alpha, -2.0 * cw, 1.0 - alpha);
+    return true;
+}
+
+/**
+ * @brief 带阻，模拟原型 H(s) = (s² + W0²) / (s² + B s + W0²)
+ * 两个边界频率分别预畸变，W0取其几何平均、B取其差，离散化后两个边界处恰为-3dB
+ */
+bool band_stop(Biquad *out, const float fs, const float f_low, const float f_high)
+{
+    if (f_low >= f_high || !valid_freq(fs, f_low) || !valid_freq(fs, f_high))
+        return false;
+
+    const double wl = std::tan(pi * f_low / fs);
+    const double wh = std::tan(pi * f_high / fs);
+    const double w02 = wl * wh;
+    const double bw = wh - wl;
+
+    *out = normalize(1.0 + w02, 2.0 * (w02 - 1.0), 1.0 + w02,
+                     1.0 + bw + w02, 2.0 * (w02 - 1.0), 1.0 - bw + w02);
+    return true;
+}
+
+} // namespace filter
@@ -0,0 +1,195 @@
+#ifndef STANDARD_ROBOT_FILTER_H
+#define STANDARD_ROBOT_FILTER_H
+
+#include "typedef.h"
+
+#ifdef __cplusplus
+#include <cstring>
+#include "arm_math.h"
+
+namespace filter {
+
+/**
+ * @brief 一个二阶节(biquad)的系数，顺序与CMSIS-DSP df2T一致
+ * 差分方程 y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] + a1*y[n-1] + a2*y[n-2]，
+ * 注意a1、a2与教科书中的分母系数符号相反
+ */
+struct Biquad
+{
+    float b0, b1, b2, a1, a2;
+};
+
+/* 下列设计函数在初始化时调用，用双精度计算；参数不合法(频率不在(0, fs/2)内等)返回false */
+
+/* order阶Butterworth低通需要的二阶节数 */
+constexpr uint8_t butter_sections(const uint8_t order) { return (order + 1) / 2; }
+/* order阶Butterworth低通，写入butter_sections(order)个二阶节，奇数阶最后一节为一阶 */
+bool butter_lowpass(Biquad *out, float fs, float fc, uint8_t order);
+/* 中心频率f0、品质因数q的陷波器，q越大阻带越窄 */
+bool notch(Biquad *out, float fs, float f0, float q);
+/* -3dB边界为f_low、f_high的二阶带阻 */
+bool band_stop(Biquad *out, float fs, float f_low, float f_high);
+
+/**
+ * @brief 最多Stages节的系数表，由设计函数逐段追加，Cascade与Bank共用
+ */
+template <uint8_t Stages>
+class Sections
+{
+    static_assert(Stages > 0);
+
+protected:
+    float coeffs_[5 * Stages] = {};
+    uint8_t count_ = 0;
+
+public:
+    bool add(const Biquad &s)
+    {
+        if (count_ >= Stages)
+            return false;
+        std::memcpy(&coeffs_[5 * count_], &s, sizeof(s));
+        count_++;
+        return true;
+    }
+
+    bool add_butter_lowpass(const float fs, const float fc, const uint8_t order)
+    {
+        Biquad s[Stages];
+        const uint8_t n = butter_sections(order);
+        if (order == 0 || n > Stages - count_ || !butter_lowpass(s, fs, fc, order))
+            return false;
+        for (uint8_t i = 0; i < n; i++)
+            add(s[i]);
+        return true;
+    }
+
+    bool add_notch(const float fs, const float f0, const float q)
+    {
+        Biquad s;
+        return notch(&s, fs, f0, q) && add(s);
+    }
+
+    bool add_band_stop(const float fs, const float f_low, const float f_high)
+    {
+        Biquad s;
+        return band_stop(&s, fs, f_low, f_high) && add(s);
+    }
+
+    void clear() { count_ = 0; }
+
+    [[nodiscard]] uint8_t stages() const { return count_; }
+    [[nodiscard]] const float *coeffs() const { return coeffs_; }
+};
+
+/**
+ * @brief 单通道级联滤波器，成块处理时调用CMSIS-DSP的arm_biquad_cascade_df2T_f32
+ * 适合一次有多个采样的信号，如IMU FIFO读出的一批数据
+ */
+template <uint8_t Stages>
+class Cascade : public Sections<Stages>
+{
+    using Sections<Stages>::coeffs_;
+    using Sections<Stages>::count_;
+
+private:
+    float state_[2 * Stages] = {};
+    arm_biquad_cascade_df2T_instance_f32 inst_{};
+
+public:
+    Cascade() { arm_biquad_cascade_df2T_init_f32(&inst_, 0, coeffs_, state_); }
+    Cascade(const Cascade &) = delete;
+    Cascade &operator=(const Cascade &) = delete;
+
+    /* 一节都没有时直通，in与out可以相同 */
+    void process(const float *in, float *out, const uint32_t n)
+    {
+        // 节数在add()后可能变化，CMSIS-DSP的实例只保存指针，这里同步节数即可
+        inst_.numStages = count_;
+        if (count_ == 0)
+            std::memmove(out, in, n * sizeof(float));
+        else
+            arm_biquad_cascade_df2T_f32(&inst_, in, out, n);
+    }
+
+    float process(const float x)
+    {
+        float y;
+        process(&x, &y, 1);
+        return y;
+    }
+
+    void reset() { std::memset(state_, 0, sizeof(state_)); }
+};
+
+/**
+ * @brief 多通道共用同一组系数的滤波器组，每次处理所有通道的一个采样
+ * 状态按[节][通道]存放，内层循环遍历通道，系数只加载一次，
+ * 适合每个控制周期各来一个采样的信号，如4个M3508的转速、IMU的3个轴。
+ * 运算顺序与arm_biquad_cascade_df2T_f32相同，编译选项相同时结果与逐通道调用CMSIS-DSP逐位一致
+ */
+template <uint8_t Stages, uint8_t Channels>
+class Bank : public Sections<Stages>
+{
+    static_assert(Channels > 0);
+    using Sections<Stages>::coeffs_;
+    using Sections<Stages>::count_;
+
+private:
+    float d1_[Stages][Channels] = {};
+    float d2_[Stages][Channels] = {};
+
+public:
+    Bank() = default;
+    Bank(const Bank &) = delete;
+    Bank &operator=(const Bank &) = delete;
+
+    /**
+     * @param[in]  in  Channels个通道各一个采样
+     * @param[out] out Channels个输出，可与in相同
+     */
+    void process(const float *in, float *out)
+    {
+        if (out != in)
+            std::memcpy(out, in, Channels * sizeof(float));
+
+        for (uint8_t s = 0; s < count_; s++) {
+            const float b0 = coeffs_[5 * s + 0];
+            const float b1 = coeffs_[5 * s + 1];
+            const float b2 = coeffs_[5 * s + 2];
+            const float a1 = coeffs_[5 * s + 3];
+            const float a2 = coeffs_[5 * s + 4];
+            float *d1 = d1_[s];
+            float *d2 = d2_[s];
+
+            for (uint8_t c = 0; c < Channels; c++) {
+                const float x = out[c];
+                const float y = b0 * x + d1[c];
+                float t = b1 * x + d2[c];
+                t += a1 * y;
+                d1[c] = t;
+                t = b2 * x;
+                t += a2 * y;
+                d2[c] = t;
+                out[c] = y;
+            }
+        }
+    }
+
+    /* 按帧交错存放的frames帧数据: in[frame * Channels + channel] */
+    void process(const float *in, float *out, const uint32_t frames)
+    {
+        for (uint32_t f = 0; f < frames; f++)
+            process(in + f * Channels, out + f * Channels);
+    }
+
+    void reset()
+    {
+        std::memset(d1_, 0, sizeof(d1_));
+        std::memset(d2_, 0, sizeof(d2_));
+    }
+};
+
+} // namespace filter
+#endif
+
+#endif //STANDARD_ROBOT_FILTER_H
@@ -0,0 +1,161 @@
+#ifndef STANDARD_ROBOT_PID_H
+#define STANDARD_ROBOT_PID_H
+
+#include "typedef.h"
+
+#ifdef __cplusplus
+#include <cstring>
+
+namespace pid {
+
+/**
+ * @brief 一个PID环的参数
+ * 输出 = kp*e + ∫ki*e dt - kd*d(meas)/dt + 前馈，微分作用于测量值，设定值阶跃不会产生微分冲击
+ */
+struct Params
+{
+    float kp, ki, kd;
+    float i_max;        // 积分项限幅，输出单位
+    float out_max;      // 输出限幅
+    float d_alpha;      // 微分项一阶低通系数，(0, 1]，1为不滤波
+    float slew;         // 输出每秒最大变化量，0为不限制
+};
+
+/**
+ * @brief N个通道的同一级PID，按结构体数组(SoA)存放
+ * 参数与状态按字段各成一个数组，一次调用更新所有通道，内层循环无分支，
+ * 适合同一组电机(如4个底盘M3508)每个控制周期各更新一次
+ */
+template <uint8_t N>
+class Loop
+{
+    static_assert(N > 0 && N <= 32);
+
+private:
+    float kp_[N] = {}, ki_[N] = {}, kd_[N] = {};
+    float i_max_[N] = {}, out_max_[N] = {}, d_alpha_[N] = {}, slew_[N] = {};
+    float integ_[N] = {}, last_meas_[N] = {}, d_filt_[N] = {}, out_[N] = {};
+    uint32_t primed_ = 0;   // 上一周期已使能的通道，刚使能的第一次更新不计算微分
+
+public:
+    void set(const uint8_t ch, const Params &p)
+    {
+        kp_[ch] = p.kp;
+        ki_[ch] = p.ki;
+        kd_[ch] = p.kd;
+        i_max_[ch] = p.i_max;
+        out_max_[ch] = p.out_max;
+        d_alpha_[ch] = p.d_alpha;
+        slew_[ch] = p.slew > 0.0f ? p.slew : 3.0e38f;
+    }
+
+    void set_all(const Params &p)
+    {
+        for (uint8_t c = 0; c < N; c++)
+            set(c, p);
+    }
+
+    void reset(const uint8_t ch)
+    {
+        integ_[ch] = 0.0f;
+        d_filt_[ch] = 0.0f;
+        primed_ &= ~(1u << ch);
+    }
+
+    void reset()
+    {
+        std::memset(integ_, 0, sizeof(integ_));
+        std::memset(d_filt_, 0, sizeof(d_filt_));
+        primed_ = 0;
+    }
+
+    /**
+     * @param[in]  ref  N个设定值
+     * @param[in]  meas N个测量值
+     * @param[in]  ff   N个前馈，加在PID输出上，可为nullptr
+     * @param[out] out  N个输出；mask中未使能的通道输出前馈并清除积分
+     * @param dt        距上次更新的时间 s
+     * @param mask      第c位为1时第c个通道闭环
+     */
+    void update(const float *ref, const float *meas, const float *ff, float *out, const float dt,
+                const uint32_t mask)
+    {
+        const float inv_dt = dt > 0.0f ? 1.0f / dt : 0.0f;
+
+        for (uint8_t c = 0; c < N; c++) {
+            const bool on = (mask >> c) & 1u;
+            const bool primed = (primed_ >> c) & 1u;
+            const float f = ff ? ff[c] : 0.0f;
+            const float e = ref[c] - meas[c];
+
+            float i = integ_[c] + ki_[c] * e * dt;
+            i = i > i_max_[c] ? i_max_[c] : (i < -i_max_[c] ? -i_max_[c] : i);
+
+            const float d_raw = primed ? (last_meas_[c] - meas[c]) * inv_dt : 0.0f;
+            const float d = d_filt_[c] + d_alpha_[c] * (d_raw - d_filt_[c]);
+
+            float u = kp_[c] * e + i + kd_[c] * d + f;
+            u = u > out_max_[c] ? out_max_[c] : (u < -out_max_[c] ? -out_max_[c] : u);
+
+            // 从上一周期的输出(未使能时即前馈)开始限制变化量，切换使能时输出无跳变
+            const float step = slew_[c] * dt;
+            const float prev = out_[c];
+            u = u > prev + step ? prev + step : (u < prev - step ? prev - step : u);
+
+            integ_[c] = on ? i : 0.0f;
+            d_filt_[c] = on ? d : 0.0f;
+            last_meas_[c] = meas[c];
+            out_[c] = on ? u : f;
+            out[c] = out_[c];
+        }
+        primed_ = mask;
+    }
+};
+
+/**
+ * @brief 位置→速度串级，输出电流指令，电流环由电调完成
+ * 位置环输出加上速度前馈作为速度环设定值，速度环输出加上电流前馈作为电流指令。
+ * 位置环未使能的通道直接以target.speed为速度设定；速度环未使能的通道直接输出target.current
+ */
+template <uint8_t N>
+class Cascade
+{
+public:
+    struct Target
+    {
+        float pos[N];       // 位置设定
+        float speed[N];     // 速度前馈/位置环未使能时的速度设定
+        float current[N];   // 电流前馈/速度环未使能时的电流指令
+        uint32_t pos_mask;  // 位置环使能
+        uint32_t speed_mask;// 速度环使能
+    };
+
+    Loop<N> pos;
+    Loop<N> speed;
+
+    /**
+     * @param[in]  t          设定值与各环使能
+     * @param[in]  pos_meas   N个位置测量值
+     * @param[in]  speed_meas N个速度测量值
+     * @param[out] current    N个电流指令
+     * @param dt              s
+     */
+    void update(const Target &t, const float *pos_meas, const float *speed_meas, float *current, const float dt)
+    {
+        float speed_ref[N];
+        // 位置环使能的通道速度环也必须使能
+        pos.update(t.pos, pos_meas, t.speed, speed_ref, dt, t.pos_mask & t.speed_mask);
+        speed.update(speed_ref, speed_meas, t.current, current, dt, t.speed_mask);
+    }
+
+    void reset()
+    {
+        pos.reset();
+        speed.reset();
+    }
+};
+
+} // namespace pid
+#endif
+
+#endif //STANDARD_ROBOT_PID_H
@@ -2,14 +2,50 @@
  * @file user_lib.c
  * @brief 数学函数模块
  * 常见数学函数。
- * @version 1.0
- * @date 2026-01-17
+ * 目标板上要求使用单精度硬件FPU(-mfpu=fpv4-sp-d16 -mfloat-abi=hard)，开方直接使用VSQRT指令；
+ * int16数组运算在有DSP扩展时用SIMD指令每次处理两个数，上位机编译时退化为逐个处理
+ * @version 1.1
+ * @date 2026-10-19
  */
 
 #include "string.h"
 #include "algorithm/user_lib.h"
 #include "math.h"
 
+#if defined(__arm__) && !(defined(__ARM_FP) && (__ARM_FP & 4))
+#error "user_lib requires the single-precision hardware FPU (-mfpu=fpv4-sp-d16 -mfloat-abi=hard)"
+#endif
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "cmsis_compiler.h"
+#define USER_LIB_SIMD 1
+#endif
+
+/*
+ * 硬件开方，约14个周期。
+ * 不用sqrtf: 未加-fno-math-errno时GCC会在VSQRT后插入NaN判断和库函数调用，
+ * CMSIS-DSP的arm_sqrt_f32在GCC下也是调用sqrtf
+ */
+static inline float vsqrtf(float x)
+{
+#if defined(__arm__)
+    float y;
+    __asm("vsqrt.f32 %0, %1" : "=t"(y) : "t"(x));
+    return y;
+#else
+    return sqrtf(x);
+#endif
+}
+
+/* 向上取整，用于q > 0 */
+static inline int32_t ceil_positive(float q)
+{
+    int32_t n = (int32_t)q;
+    if ((float)n < q)
+        n++;
+    return n;
+}
+
 /*---------------------------------------数据转换--------------------------------------- */
 /**
   * @brief          将4位uint8_t转换为1个float
@@ -45,43 +81,20 @@ void pack_float_to_4bytes(float f1, uint8_t data[4]) {
 /*------------------------------------------------------------------------------------- */
 
 /*-------------------------------------常用数学函数------------------------------------- */
-// 快速开方
+// 开方，x <= 0时返回0
 float q_sqrt(float x)
 {
-    float y;
-    float delta;
-    float maxError;
-
     if (x <= 0)
     {
         return 0;
     }
-
-    // initial guess
-    y = x / 2;
-
-    // refine
-    maxError = x * 0.001f;
-
-    do
-    {
-        delta = (y * y) - x;
-        y -= delta / (2 * y);
-    } while (delta > maxError || delta < -maxError);
-
-    return y;
+    return vsqrtf(x);
 }
 
-// 快速平方倒数
+// 平方倒数，VSQRT + VDIV，精确到单精度舍入误差
 float invSqrt(float num)
 {
-    float halfnum = 0.5f * num;
-    float y = num;
-    long i = *(long *)&y;
-    i = 0x5f375a86- (i >> 1);
-    y = *(float *)&i;
-    y = y * (1.5f - (halfnum * y * y));
-    return y;
+    return 1.0f / vsqrtf(num);
 }
 
 // 绝对值限制
@@ -149,7 +162,99 @@ void int16_constrain(int16_t* Value, int16_t minValue, int16_t maxValue)
         *Value = maxValue;
 }
 
-//float循环限幅
+/**
+  * @brief          int16数组限幅，如一组电机的电流指令
+  *                 SIMD路径每次处理两个数: SSUB16按半字比较并置GE标志，SEL按GE标志逐半字选择
+  * @param[in,out]  数组，无对齐要求
+  * @param[in]      长度
+  * @param[in]      最小值、最大值，需minValue <= maxValue
+  * @retval         无
+  */
+void int16_constrain_array(int16_t *data, uint32_t n, int16_t minValue, int16_t maxValue)
+{
+    uint32_t i = 0;
+#ifdef USER_LIB_SIMD
+    const uint32_t min2 = (uint16_t)minValue * 0x00010001u;
+    const uint32_t max2 = (uint16_t)maxValue * 0x00010001u;
+    for (; i + 2 <= n; i += 2)
+    {
+        uint32_t x;
+        memcpy(&x, &data[i], sizeof(x));
+        __SSUB16(x, min2);
+        x = __SEL(x, min2);     // x >= min ? x : min
+        __SSUB16(max2, x);
+        x = __SEL(x, max2);     // max >= x ? x : max
+        memcpy(&data[i], &x, sizeof(x));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        int16_constrain(&data[i], minValue, maxValue);
+    }
+}
+
+/**
+  * @brief          int16数组死区，minValue < x < maxValue的元素置0
+  *                 SIMD路径分别选出x >= max与x <= min的部分再按位或合并，两部分都选中时二者相同
+  * @param[in,out]  数组，无对齐要求
+  * @param[in]      长度
+  * @param[in]      死区下界、上界
+  * @retval         无
+  */
+void int16_deadband_array(int16_t *data, uint32_t n, int16_t minValue, int16_t maxValue)
+{
+    uint32_t i = 0;
+#ifdef USER_LIB_SIMD
+    const uint32_t min2 = (uint16_t)minValue * 0x00010001u;
+    const uint32_t max2 = (uint16_t)maxValue * 0x00010001u;
+    for (; i + 2 <= n; i += 2)
+    {
+        uint32_t x;
+        memcpy(&x, &data[i], sizeof(x));
+        __SSUB16(x, max2);
+        const uint32_t above = __SEL(x, 0);
+        __SSUB16(min2, x);
+        const uint32_t below = __SEL(x, 0);
+        x = above | below;
+        memcpy(&data[i], &x, sizeof(x));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        data[i] = int16_deadband(data[i], minValue, maxValue);
+    }
+}
+
+/**
+  * @brief          int16数组点积，如Σ电流×转速估算底盘功率
+  *                 SIMD路径用SMLALD每次乘加两对，64位累加不会溢出
+  * @param[in]      两个数组，无对齐要求
+  * @param[in]      长度
+  * @retval         点积
+  */
+int64_t int16_dot(const int16_t *a, const int16_t *b, uint32_t n)
+{
+    int64_t sum = 0;
+    uint32_t i = 0;
+#ifdef USER_LIB_SIMD
+    uint64_t acc = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        uint32_t x, y;
+        memcpy(&x, &a[i], sizeof(x));
+        memcpy(&y, &b[i], sizeof(y));
+        acc = __SMLALD(x, y, acc);
+    }
+    sum = (int64_t)acc;
+#endif
+    for (; i < n; i++)
+    {
+        sum += (int32_t)a[i] * b[i];
+    }
+    return sum;
+}
+
+//float循环限幅，结果在[minValue, maxValue]内，不论输入离区间多远都是常数时间
 float loop_float_constrain(float Input, float minValue, float maxValue)
 {
     if (maxValue < minValue)
@@ -157,21 +262,27 @@ float loop_float_constrain(float Input, float minValue, float maxValue)
         return Input;
     }
 
+    const float len = maxValue - minValue;
     if (Input > maxValue)
     {
-        float len = maxValue - minValue;
-        while (Input > maxValue)
-        {
+        if (len <= 0.0f)
+            return maxValue;
+        Input -= len * (float)ceil_positive((Input - maxValue) / len);
+        // 浮点舍入可能多减或少减一个周期
+        if (Input < minValue)
+            Input += len;
+        else if (Input > maxValue)
             Input -= len;
-        }
     }
     else if (Input < minValue)
     {
-        float len = maxValue - minValue;
-        while (Input < minValue)
-        {
+        if (len <= 0.0f)
+            return minValue;
+        Input += len * (float)ceil_positive((minValue - Input) / len);
+        if (Input > maxValue)
+            Input -= len;
+        else if (Input < minValue)
             Input += len;
-        }
     }
     return Input;
 }
@@ -184,21 +295,18 @@ int loop_int_constrain(int Input, int minValue, int maxValue)
         return Input;
     }
 
+    const int len = maxValue - minValue;
+    if (len == 0)
+    {
+        return minValue;
+    }
     if (Input > maxValue)
     {
-        float len = maxValue - minValue;
-        while (Input > maxValue)
-        {
-            Input -= len;
-        }
+        Input -= len * ((Input - maxValue + len - 1) / len);
     }
     else if (Input < minValue)
     {
-        float len = maxValue - minValue;
-        while (Input < minValue)
-        {
-            Input += len;
-        }
+        Input += len * ((minValue - Input + len - 1) / len);
     }
     return Input;
 }
@@ -301,65 +409,148 @@ float ramp_calc(ramp_function_source_t *ramp_source_type, float input)
 /*------------------------------------------------------------------------------------- */
 
 /*--------------------------------------最小二乘法-------------------------------------- */
+/*
+ * 滑动窗口最小二乘: x、y存放在长度为Order的环形缓冲区中，t[]维护窗口内的累加和
+ * (t[0]=Σx², t[1]=Σx, t[2]=Σxy, t[3]=Σy, Syy=Σy²)，新样本进入时加上、最旧样本离开时减去，
+ * 每个样本O(1)。加减累积的浮点误差由每Order个样本一次的重新归一化消除：
+ * 以窗口内最旧样本为新原点，整体平移x、y后从头重算累加和(均摊O(1))。
+ * y也相对原点存放，输入为不断增长的编码器累计位置时不会因数值过大而损失精度。
+ */
+
 /**
-  * @brief          获取最小二乘法的初始化
+  * @brief          使用调用者提供的缓冲区初始化最小二乘法，不申请内存
   * @param[in]      最小二乘法结构体
-  * @param[in]      阶数
+  * @param[in]      阶数(窗口长度)
+  * @param[in]      x、y缓冲区，长度均不小于order
   * @retval         无
   */
-void OLS_Init(Ordinary_Least_Squares_t *OLS, uint16_t order)
+void OLS_InitStatic(Ordinary_Least_Squares_t *OLS, uint16_t order, float *x_buf, float *y_buf)
 {
     OLS->Order = order;
     OLS->Count = 0;
-    OLS->x = (float *)user_malloc(sizeof(float) * order);
-    OLS->y = (float *)user_malloc(sizeof(float) * order);
+    OLS->x = x_buf;
+    OLS->y = y_buf;
     OLS->k = 0;
     OLS->b = 0;
+    OLS->StandardDeviation = 0;
+    OLS->Syy = 0;
+    OLS->XLast = 0;
+    OLS->YOrigin = 0;
+    OLS->Head = 0;
+    OLS->SinceRenorm = 0;
     memset((void *)OLS->x, 0, sizeof(float) * order);
     memset((void *)OLS->y, 0, sizeof(float) * order);
     memset((void *)OLS->t, 0, sizeof(float) * 4);
 }
 
+#ifdef user_malloc
 /**
-  * @brief          获取最小二乘法的导数
+  * @brief          获取最小二乘法的初始化
   * @param[in]      最小二乘法结构体
-  * @param[in]      输入时间增量
-  * @param[in]      输入值
+  * @param[in]      阶数
+  * @retval         无
   */
-void OLS_Update(Ordinary_Least_Squares_t *OLS, float deltax, float y)
+void OLS_Init(Ordinary_Least_Squares_t *OLS, uint16_t order)
+{
+    OLS_InitStatic(OLS, order, (float *)user_malloc(sizeof(float) * order), (float *)user_malloc(sizeof(float) * order));
+}
+#endif
+
+static void OLS_Renormalize(Ordinary_Least_Squares_t *OLS)
 {
-    static float temp = 0;
-    temp = OLS->x[1];
-    for (uint16_t i = 0; i < OLS->Order - 1; ++i)
+    const uint16_t oldest = (OLS->Count < OLS->Order) ? 0 : OLS->Head;
+    const float origin = OLS->x[oldest];
+    const float y_origin = OLS->y[oldest];
+
+    memset((void *)OLS->t, 0, sizeof(float) * 4);
+    OLS->Syy = 0;
+    for (uint16_t n = 0, i = oldest; n < OLS->Count; ++n)
     {
-        OLS->x[i] = OLS->x[i + 1] - temp;
-        OLS->y[i] = OLS->y[i + 1];
+        const float x = OLS->x[i] - origin;
+        const float y = OLS->y[i] - y_origin;
+        OLS->x[i] = x;
+        OLS->y[i] = y;
+        OLS->t[0] += x * x;
+        OLS->t[1] += x;
+        OLS->t[2] += x * y;
+        OLS->t[3] += y;
+        OLS->Syy += y * y;
+        if (++i == OLS->Order) i = 0;
     }
-    OLS->x[OLS->Order - 1] = OLS->x[OLS->Order - 2] + deltax;
-    OLS->y[OLS->Order - 1] = y;
+    OLS->XLast -= origin;
+    OLS->YOrigin += y_origin;
+    OLS->SinceRenorm = 0;
+}
+
+static void OLS_Push(Ordinary_Least_Squares_t *OLS, float deltax, float y)
+{
+    const float x = OLS->XLast + deltax;
+    y -= OLS->YOrigin;
+    const uint16_t i = OLS->Head;
 
-    if (OLS->Count < OLS->Order)
+    if (OLS->Count == OLS->Order)
+    {
+        const float xo = OLS->x[i];
+        const float yo = OLS->y[i];
+        OLS->t[0] -= xo * xo;
+        OLS->t[1] -= xo;
+        OLS->t[2] -= xo * yo;
+        OLS->t[3] -= yo;
+        OLS->Syy -= yo * yo;
+    }
+    else
     {
         OLS->Count++;
     }
-    memset((void *)OLS->t, 0, sizeof(float) * 4);
-    for (uint16_t i = OLS->Order - OLS->Count; i < OLS->Order; ++i)
+
+    OLS->x[i] = x;
+    OLS->y[i] = y;
+    OLS->t[0] += x * x;
+    OLS->t[1] += x;
+    OLS->t[2] += x * y;
+    OLS->t[3] += y;
+    OLS->Syy += y * y;
+    OLS->XLast = x;
+    OLS->Head = (i + 1 == OLS->Order) ? 0 : i + 1;
+
+    if (++OLS->SinceRenorm >= OLS->Order)
     {
-        OLS->t[0] += OLS->x[i] * OLS->x[i];
-        OLS->t[1] += OLS->x[i];
-        OLS->t[2] += OLS->x[i] * OLS->y[i];
-        OLS->t[3] += OLS->y[i];
+        OLS_Renormalize(OLS);
     }
+}
 
-    OLS->k = (OLS->t[2] * OLS->Order - OLS->t[1] * OLS->t[3]) / (OLS->t[0] * OLS->Order - OLS->t[1] * OLS->t[1]);
-    OLS->b = (OLS->t[0] * OLS->t[3] - OLS->t[1] * OLS->t[2]) / (OLS->t[0] * OLS->Order - OLS->t[1] * OLS->t[1]);
+/* 由累加和求k、b与残差均方根，窗口内样本数不足2或x全相同时保持上一次结果 */
+static void OLS_Solve(Ordinary_Least_Squares_t *OLS)
+{
+    const float n = (float)OLS->Count;
+    const float den = OLS->t[0] * n - OLS->t[1] * OLS->t[1];
 
-    OLS->StandardDeviation = 0;
-    for (uint16_t i = OLS->Order - OLS->Count; i < OLS->Order; ++i)
+    if (OLS->Count < 2 || den <= 1e-12f)
     {
-        OLS->StandardDeviation += fabsf(OLS->k * OLS->x[i] + OLS->b - OLS->y[i]);
+        return;
     }
-    OLS->StandardDeviation /= OLS->Order;
+    OLS->k = (OLS->t[2] * n - OLS->t[1] * OLS->t[3]) / den;
+    const float k = OLS->k;
+    const float b = (OLS->t[3] - k * OLS->t[1]) / n;
+    OLS->b = b + OLS->YOrigin;
+
+    // Σ(kx+b-y)² 展开为累加和的组合
+    float sse = OLS->Syy + k * k * OLS->t[0] + n * b * b
+              - 2.0f * k * OLS->t[2] - 2.0f * b * OLS->t[3] + 2.0f * k * b * OLS->t[1];
+    if (sse < 0.0f) sse = 0.0f;
+    OLS->StandardDeviation = sqrtf(sse / n);
+}
+
+/**
+  * @brief          获取最小二乘法的导数
+  * @param[in]      最小二乘法结构体
+  * @param[in]      输入时间增量
+  * @param[in]      输入值
+  */
+void OLS_Update(Ordinary_Least_Squares_t *OLS, float deltax, float y)
+{
+    OLS_Push(OLS, deltax, y);
+    OLS_Solve(OLS);
 }
 
 /**
@@ -371,39 +562,8 @@ void OLS_Update(Ordinary_Least_Squares_t *OLS, float deltax, float y)
   */
 float OLS_Derivative(Ordinary_Least_Squares_t *OLS, float deltax, float y)
 {
-    static float temp = 0;
-    temp = OLS->x[1];
-    for (uint16_t i = 0; i < OLS->Order - 1; ++i)
-    {
-        OLS->x[i] = OLS->x[i + 1] - temp;
-        OLS->y[i] = OLS->y[i + 1];
-    }
-    OLS->x[OLS->Order - 1] = OLS->x[OLS->Order - 2] + deltax;
-    OLS->y[OLS->Order - 1] = y;
-
-    if (OLS->Count < OLS->Order)
-    {
-        OLS->Count++;
-    }
-
-    memset((void *)OLS->t, 0, sizeof(float) * 4);
-    for (uint16_t i = OLS->Order - OLS->Count; i < OLS->Order; ++i)
-    {
-        OLS->t[0] += OLS->x[i] * OLS->x[i];
-        OLS->t[1] += OLS->x[i];
-        OLS->t[2] += OLS->x[i] * OLS->y[i];
-        OLS->t[3] += OLS->y[i];
-    }
-
-    OLS->k = (OLS->t[2] * OLS->Order - OLS->t[1] * OLS->t[3]) / (OLS->t[0] * OLS->Order - OLS->t[1] * OLS->t[1]);
-
-    OLS->StandardDeviation = 0;
-    for (uint16_t i = OLS->Order - OLS->Count; i < OLS->Order; ++i)
-    {
-        OLS->StandardDeviation += fabsf(OLS->k * OLS->x[i] + OLS->b - OLS->y[i]);
-    }
-    OLS->StandardDeviation /= OLS->Order;
-
+    OLS_Push(OLS, deltax, y);
+    OLS_Solve(OLS);
     return OLS->k;
 }
 
@@ -426,41 +586,9 @@ float Get_OLS_Derivative(Ordinary_Least_Squares_t *OLS)
   */
 float OLS_Smooth(Ordinary_Least_Squares_t *OLS, float deltax, float y)
 {
-    static float temp = 0;
-    temp = OLS->x[1];
-    for (uint16_t i = 0; i < OLS->Order - 1; ++i)
-    {
-        OLS->x[i] = OLS->x[i + 1] - temp;
-        OLS->y[i] = OLS->y[i + 1];
-    }
-    OLS->x[OLS->Order - 1] = OLS->x[OLS->Order - 2] + deltax;
-    OLS->y[OLS->Order - 1] = y;
-
-    if (OLS->Count < OLS->Order)
-    {
-        OLS->Count++;
-    }
-
-    memset((void *)OLS->t, 0, sizeof(float) * 4);
-    for (uint16_t i = OLS->Order - OLS->Count; i < OLS->Order; ++i)
-    {
-        OLS->t[0] += OLS->x[i] * OLS->x[i];
-        OLS->t[1] += OLS->x[i];
-        OLS->t[2] += OLS->x[i] * OLS->y[i];
-        OLS->t[3] += OLS->y[i];
-    }
-
-    OLS->k = (OLS->t[2] * OLS->Order - OLS->t[1] * OLS->t[3]) / (OLS->t[0] * OLS->Order - OLS->t[1] * OLS->t[1]);
-    OLS->b = (OLS->t[0] * OLS->t[3] - OLS->t[1] * OLS->t[2]) / (OLS->t[0] * OLS->Order - OLS->t[1] * OLS->t[1]);
-
-    OLS->StandardDeviation = 0;
-    for (uint16_t i = OLS->Order - OLS->Count; i < OLS->Order; ++i)
-    {
-        OLS->StandardDeviation += fabsf(OLS->k * OLS->x[i] + OLS->b - OLS->y[i]);
-    }
-    OLS->StandardDeviation /= OLS->Order;
-
-    return OLS->k * OLS->x[OLS->Order - 1] + OLS->b;
+    OLS_Push(OLS, deltax, y);
+    OLS_Solve(OLS);
+    return OLS->k * OLS->XLast + OLS->b;
 }
 
 /**
@@ -470,5 +598,5 @@ float OLS_Smooth(Ordinary_Least_Squares_t *OLS, float deltax, float y)
   */
 float Get_OLS_Smooth(Ordinary_Least_Squares_t *OLS)
 {
-    return OLS->k * OLS->x[OLS->Order - 1] + OLS->b;
+    return OLS->k * OLS->XLast + OLS->b;
 }
@@ -3,10 +3,17 @@
 #include "typedef.h"
 #include "cmsis_os.h"
 
+/*
+ * 定义POOL_ROUTE_MALLOC时从bsp/pool的内存池分配，可在中断中调用；
+ * 否则FreeRTOS关闭动态分配时没有pvPortMalloc，不定义user_malloc，需要动态内存的接口也不提供
+ */
 #ifndef user_malloc
-#ifdef _CMSIS_OS_H
+#if defined(POOL_ROUTE_MALLOC)
+#include "pool/pool.h"
+#define user_malloc pool_malloc
+#elif defined(_CMSIS_OS_H) && configSUPPORT_DYNAMIC_ALLOCATION
 #define user_malloc pvPortMalloc
-#else
+#elif !defined(_CMSIS_OS_H)
 #define user_malloc malloc
 #endif
 #endif
@@ -81,9 +88,14 @@ typedef struct
     float k;
     float b;
 
-    float StandardDeviation;
+    float StandardDeviation;    // 残差均方根
 
-    float t[4];
+    float t[4];                 // 窗口内Σx², Σx, Σxy, Σy
+    float Syy;                  // 窗口内Σy²
+    float XLast;                // 最新样本的x
+    float YOrigin;              // 缓冲区中y相对的原点
+    uint16_t Head;              // 环形缓冲区中最旧样本(写入位置)
+    uint16_t SinceRenorm;       // 距上次重新归一化的样本数
 } Ordinary_Least_Squares_t;
 
 typedef struct
@@ -99,6 +111,7 @@ extern "C" {
 #endif
 
 float q_sqrt(float x);
+float invSqrt(float num);
 
 void ramp_init(ramp_function_source_t *ramp_source_type, float frame_period, float max, float min);
 float ramp_calc(ramp_function_source_t *ramp_source_type, float input);
@@ -109,6 +122,9 @@ float float_deadband(float Value, float minValue, float maxValue);
 int16_t int16_deadband(int16_t Value, int16_t minValue, int16_t maxValue);
 void float_constrain(float* Value, float minValue, float maxValue);
 void int16_constrain(int16_t* Value, int16_t minValue, int16_t maxValue);
+void int16_constrain_array(int16_t *data, uint32_t n, int16_t minValue, int16_t maxValue);
+void int16_deadband_array(int16_t *data, uint32_t n, int16_t minValue, int16_t maxValue);
+int64_t int16_dot(const int16_t *a, const int16_t *b, uint32_t n);
 float loop_float_constrain(float Input, float minValue, float maxValue);
 int loop_int_constrain(int Input, int minValue, int maxValue);
 float radian_format(float Rad);
@@ -120,7 +136,16 @@ int float_rounding(float raw);
 void first_order_filter_init(first_order_filter_type_t *first_order_filter_type, fp32 frame_period, const fp32 num[1]);
 void first_order_filter_cali(first_order_filter_type_t *first_order_filter_type, fp32 input);
 
+#ifdef user_malloc
 void OLS_Init(Ordinary_Least_Squares_t *OLS, uint16_t order);
+#endif
+void OLS_InitStatic(Ordinary_Least_Squares_t *OLS, uint16_t order, float *x_buf, float *y_buf);
+/* 用静态缓冲区初始化，order须为常量，每个调用点各有一份缓冲区 */
+#define OLS_INIT_STATIC(OLS, order)                              \
+    do {                                                         \
+        static float ols_x_buf_[order], ols_y_buf_[order];       \
+        OLS_InitStatic((OLS), (order), ols_x_buf_, ols_y_buf_);  \
+    } while (0)
 void OLS_Update(Ordinary_Least_Squares_t *OLS, float deltax, float y);
 float OLS_Derivative(Ordinary_Least_Squares_t *OLS, float deltax, float y);
 float OLS_Smooth(Ordinary_Least_Squares_t *OLS, float deltax, float y);
@@ -131,5 +156,36 @@ void unpack_4bytes_to_floats(const uint8_t data[4], float* f1);
 void pack_float_to_4bytes(float f1, uint8_t data[4]);
 #ifdef __cplusplus
 }
+
+/**
+ * @brief 窗口长度由模板参数确定、缓冲区内联存放的滑动窗口最小二乘，不使用堆
+ * 每个实例独立，可在不同任务中分别使用；每个样本O(1)
+ */
+template <uint16_t N>
+class SlidingOLS
+{
+    static_assert(N >= 2, "window must hold at least 2 samples");
+
+private:
+    float x_[N];
+    float y_[N];
+    Ordinary_Least_Squares_t ols_;
+
+public:
+    SlidingOLS() { OLS_InitStatic(&ols_, N, x_, y_); }
+    SlidingOLS(const SlidingOLS&) = delete;
+    SlidingOLS& operator=(const SlidingOLS&) = delete;
+
+    void reset() { OLS_InitStatic(&ols_, N, x_, y_); }
+    void update(const float dx, const float y) { OLS_Update(&ols_, dx, y); }
+    float derivative(const float dx, const float y) { return OLS_Derivative(&ols_, dx, y); }
+    float smooth(const float dx, const float y) { return OLS_Smooth(&ols_, dx, y); }
+
+    [[nodiscard]] float k() const { return ols_.k; }
+    [[nodiscard]] float b() const { return ols_.b; }
+    [[nodiscard]] float value() const { return ols_.k * ols_.XLast + ols_.b; }
+    [[nodiscard]] float residual_rms() const { return ols_.StandardDeviation; }
+    [[nodiscard]] uint32_t count() const { return ols_.Count; }
+};
 #endif
 #endif
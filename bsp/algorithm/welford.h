@@ -0,0 +1,84 @@
+#ifndef STANDARD_ROBOT_WELFORD_H
+#define STANDARD_ROBOT_WELFORD_H
+
+#include "typedef.h"
+
+#ifdef __cplusplus
+
+namespace stats {
+
+/**
+ * @brief N维样本的均值与方差，Welford在线算法
+ * 每个样本更新一次，不保存样本，也没有先求和再相减的舍入问题，
+ * float下累计数万个均值远大于方差的样本(如陀螺仪零偏)仍然准确。
+ * merge按Chan等的并行公式合并两组统计量，用于把一个窗口的结果并入长期统计
+ */
+template <uint8_t N>
+class Welford
+{
+    static_assert(N > 0);
+
+public:
+    void reset()
+    {
+        n_ = 0;
+        for (uint8_t i = 0; i < N; i++)
+            mean_[i] = m2_[i] = 0.0f;
+    }
+
+    void add(const float *x)
+    {
+        n_++;
+        const float inv = 1.0f / static_cast<float>(n_);
+        for (uint8_t i = 0; i < N; i++) {
+            const float d = x[i] - mean_[i];
+            mean_[i] += d * inv;
+            m2_[i] += d * (x[i] - mean_[i]);
+        }
+    }
+
+    void merge(const Welford &other)
+    {
+        if (other.n_ == 0)
+            return;
+        const uint32_t n = n_ + other.n_;
+        const float wb = static_cast<float>(other.n_) / static_cast<float>(n);
+        for (uint8_t i = 0; i < N; i++) {
+            const float d = other.mean_[i] - mean_[i];
+            mean_[i] += d * wb;
+            m2_[i] += other.m2_[i] + d * d * static_cast<float>(n_) * wb;    // d²·na·nb/n
+        }
+        n_ = n;
+    }
+
+    /* 样本数超过max_count时降为max_count，均值与方差不变；之后新样本的权重不低于1/max_count，相当于指数遗忘 */
+    void limit(const uint32_t max_count)
+    {
+        if (n_ <= max_count || max_count < 2)
+            return;
+        const float k = static_cast<float>(max_count - 1) / static_cast<float>(n_ - 1);
+        for (uint8_t i = 0; i < N; i++)
+            m2_[i] *= k;
+        n_ = max_count;
+    }
+
+    [[nodiscard]] uint32_t count() const { return n_; }
+    [[nodiscard]] const float *mean() const { return mean_; }
+    [[nodiscard]] float mean(const uint8_t i) const { return mean_[i]; }
+
+    /* 样本方差(除以n-1)，不足2个样本时为0 */
+    [[nodiscard]] float variance(const uint8_t i) const
+    {
+        return n_ > 1 ? m2_[i] / static_cast<float>(n_ - 1) : 0.0f;
+    }
+
+private:
+    uint32_t n_ = 0;
+    float mean_[N] = {};
+    float m2_[N] = {};
+};
+
+} // namespace stats
+#endif
+
+#endif //STANDARD_ROBOT_WELFORD_H
@@ -0,0 +1,536 @@
+/**
+ * @file bench.cpp
+ * @brief 片上微基准测试
+ * 通过USB虚拟串口发送"bench [-j] [名称前缀]"，逐个运行匹配的用例，每个用例重复BENCH_REPEAT次，
+ * 以DWT周期计数，输出CSV: 名称,字节数,最小周期,平均周期,每千周期字节数,中位数,90分位,最大周期,重复次数；
+ * 带-j时每个用例输出一行JSON，字段相同。用例之间让出CPU，由UlogTask发送已输出的结果。
+ * 主机上由tools/sim的fw_bench运行同一组用例。
+ * 仅在定义PROFILE_ENABLE时注册命令。
+ * @version 1.1
+ * @date 2026-10-19
+ */
+
+#include "bench/bench.h"
+#include "cmd/cmd.h"
+#include "dwt/bsp_dwt.h"
+#include "ulog/ulog.h"
+#include "algorithm/crc.h"
+#include "algorithm/filter.h"
+#include "algorithm/attitude.h"
+#include "algorithm/fast_trig.h"
+#include "algorithm/pid.h"
+#include "algorithm/user_lib.h"
+#include "can/bsp_can.h"
+#include "dtm/dtm.h"
+#include "online_detect/onl_det.h"
+#include "motor/dji/dji_motor.h"
+#include "upc/upc.h"
+#include "pool/pool.h"
+#include "cmsis_os.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef PROFILE_ENABLE
+
+namespace {
+
+uint8_t bench_data[256];
+volatile uint32_t bench_sink;
+
+/* upc帧长(22)与trace帧长(207)下逐字节与slice-by-N的对比 */
+template <typename Engine, uint32_t N>
+void bench_crc()
+{
+    bench_sink = Engine::compute(bench_data, N);
+}
+
+using Crc16Bytewise = crc::Engine<uint16_t, 0x8408, 0xFFFF, 1>;
+using Crc16Slice4 = crc::Engine<uint16_t, 0x8408, 0xFFFF, 4>;
+using Crc16Slice8 = crc::Engine<uint16_t, 0x8408, 0xFFFF, 8>;
+using Crc8Bytewise = crc::Engine<uint8_t, 0x8C, 0xFF, 1>;
+using Crc8Slice4 = crc::Engine<uint8_t, 0x8C, 0xFF, 4>;
+
+/* 四阶Butterworth低通 + 陷波，与tools/filter_bench相同的配置 */
+constexpr float BENCH_FS = 1000.0f;
+constexpr uint32_t BENCH_BLOCK = 64;
+float bench_signal[BENCH_BLOCK];
+float bench_out[BENCH_BLOCK];
+filter::Cascade<3> bench_cascade[4];
+filter::Bank<3, 4> bench_bank4;
+filter::Bank<3, 6> bench_bank6;
+
+template <typename F>
+void bench_filter_design(F &f)
+{
+    f.add_butter_lowpass(BENCH_FS, 80.0f, 4);
+    f.add_notch(BENCH_FS, 50.0f, 5.0f);
+}
+
+/* 单通道成块处理(CMSIS-DSP) */
+void bench_biquad_block()
+{
+    bench_cascade[0].process(bench_signal, bench_out, BENCH_BLOCK);
+}
+
+/* 4个电机转速各一个采样: 逐通道调用与滤波器组的对比 */
+void bench_biquad_single4()
+{
+    for (uint32_t c = 0; c < 4; c++)
+        bench_out[c] = bench_cascade[c].process(bench_signal[c]);
+}
+
+void bench_biquad_bank4()
+{
+    bench_bank4.process(bench_signal, bench_out);
+}
+
+/* IMU陀螺仪与加速度计6轴 */
+void bench_biquad_bank6()
+{
+    bench_bank6.process(bench_signal, bench_out);
+}
+
+/* user_lib改用硬件FPU与SIMD之前的实现，作为对照 */
+float legacy_q_sqrt(const float x)
+{
+    if (x <= 0)
+        return 0;
+    float y = x / 2;
+    const float max_error = x * 0.001f;
+    float delta;
+    do {
+        delta = (y * y) - x;
+        y -= delta / (2 * y);
+    } while (delta > max_error || delta < -max_error);
+    return y;
+}
+
+float legacy_inv_sqrt(const float num)
+{
+    const float halfnum = 0.5f * num;
+    float y = num;
+    int32_t i;
+    std::memcpy(&i, &y, sizeof(i));
+    i = 0x5f375a86 - (i >> 1);
+    std::memcpy(&y, &i, sizeof(y));
+    return y * (1.5f - (halfnum * y * y));
+}
+
+float legacy_loop_float_constrain(float input, const float min, const float max)
+{
+    const float len = max - min;
+    while (input > max)
+        input -= len;
+    while (input < min)
+        input += len;
+    return input;
+}
+
+volatile float bench_x = 1234.5f;
+volatile float bench_angle = 3600.0f + 37.0f;    // 电机多圈角度，十圈之外
+float bench_fsink;
+int16_t bench_i16[8];
+int16_t bench_i16b[8];
+
+void bench_sqrt_legacy() { bench_fsink = legacy_q_sqrt(bench_x); }
+void bench_sqrt() { bench_fsink = q_sqrt(bench_x); }
+void bench_inv_sqrt_legacy() { bench_fsink = legacy_inv_sqrt(bench_x); }
+void bench_inv_sqrt() { bench_fsink = invSqrt(bench_x); }
+void bench_loop_legacy() { bench_fsink = legacy_loop_float_constrain(bench_angle, -180.0f, 180.0f); }
+void bench_loop() { bench_fsink = loop_float_constrain(bench_angle, -180.0f, 180.0f); }
+
+/* 8个电机电流指令: 逐个调用与数组SIMD版本的对比 */
+void bench_i16_constrain_scalar()
+{
+    for (auto &v : bench_i16)
+        int16_constrain(&v, -10000, 10000);
+}
+void bench_i16_constrain_array() { int16_constrain_array(bench_i16, 8, -10000, 10000); }
+void bench_i16_deadband_scalar()
+{
+    for (auto &v : bench_i16)
+        v = int16_deadband(v, -50, 50);
+}
+void bench_i16_deadband_array() { int16_deadband_array(bench_i16, 8, -50, 50); }
+void bench_i16_dot_scalar()
+{
+    int64_t sum = 0;
+    for (uint32_t i = 0; i < 8; i++)
+        sum += (int32_t)bench_i16[i] * bench_i16b[i];
+    bench_sink = (uint32_t)sum;
+}
+void bench_i16_dot() { bench_sink = (uint32_t)int16_dot(bench_i16, bench_i16b, 8); }
+
+/* 查表三角函数与CMSIS-DSP、libm的对比 */
+volatile float bench_rad = 2.3456f;
+volatile uint32_t bench_bangle = 0x3A5B7C9Du;
+void bench_trig_sincos_b()
+{
+    const trig::SinCos sc = trig::sincos_b(bench_bangle);
+    bench_fsink = sc.sin + sc.cos;
+}
+void bench_trig_sincos()
+{
+    const trig::SinCos sc = trig::sincos(bench_rad);
+    bench_fsink = sc.sin + sc.cos;
+}
+void bench_cmsis_sin_cos()
+{
+    float s, c;
+    arm_sin_cos_f32(bench_rad * RADIAN_COEF, &s, &c);
+    bench_fsink = s + c;
+}
+void bench_libm_sin_cos() { bench_fsink = sinf(bench_rad) + cosf(bench_rad); }
+void bench_trig_atan2() { bench_fsink = trig::atan2(bench_rad, -1.25f * bench_rad + 0.5f); }
+void bench_libm_atan2() { bench_fsink = atan2f(bench_rad, -1.25f * bench_rad + 0.5f); }
+
+/* 改为dji::decode之前M3508::decode的实现: 逐字段解码后按名字查找DTM话题发布 */
+struct legacy_m3508_t
+{
+    uint16_t ecd;
+    int16_t speed;
+    int16_t current;
+    int16_t temperature;
+    int16_t last_ecd;
+};
+legacy_m3508_t bench_legacy_measure[4];
+DTM_DEFINE_TOPIC(legacy_m3508_t[4], bench_m3508);
+dji::Measure bench_measure[4];
+uint8_t bench_can_frame[8] = {0x1F, 0xF0, 0x03, 0xE8, 0xFC, 0x18, 0x28, 0x00};
+
+void bench_motor_decode_legacy()
+{
+    bench_can_frame[1] += 97;   // 每次编码值都变化并不时跨越0/8191
+    auto &m = bench_legacy_measure[1];
+    m.last_ecd = static_cast<int16_t>(m.ecd);
+    m.ecd = static_cast<uint16_t>(bench_can_frame[0] << 8 | bench_can_frame[1]);
+    m.speed = static_cast<int16_t>(bench_can_frame[2] << 8 | bench_can_frame[3]);
+    m.current = static_cast<int16_t>(bench_can_frame[4] << 8 | bench_can_frame[5]);
+    m.temperature = bench_can_frame[6];
+    DTM_PUBLISH(bench_m3508, bench_legacy_measure);
+}
+
+void bench_motor_decode()
+{
+    bench_can_frame[1] += 97;
+    dji::decode(bench_can_frame, bench_measure[1]);
+}
+
+void bench_motor_pack()
+{
+    uint8_t tx[8];
+    dji::pack(tx, bench_i16, 4, dji::M3508Traits::cmd_max);
+    std::memcpy(bench_data, tx, sizeof(tx));
+}
+
+/* 8个电机的串级PID，一个控制周期的计算量 */
+pid::Cascade<8> bench_pid;
+pid::Cascade<8>::Target bench_pid_target;
+float bench_pid_pos[8], bench_pid_speed[8], bench_pid_out[8];
+
+void bench_pid_speed_8()
+{
+    bench_pid.speed.update(bench_pid_target.speed, bench_pid_speed, bench_pid_target.current, bench_pid_out,
+                           0.001f, 0xFF);
+}
+void bench_pid_cascade_8() { bench_pid.update(bench_pid_target, bench_pid_pos, bench_pid_speed, bench_pid_out, 0.001f); }
+
+/* 64字节的一次分配与释放，内存池与newlib的malloc对比 */
+void bench_pool_alloc_free()
+{
+    void *p = pool_malloc(64);
+    bench_sink = reinterpret_cast<uintptr_t>(p);
+    pool_free(p);
+}
+
+void bench_malloc_free()
+{
+    void *p = malloc(64);
+    bench_sink = reinterpret_cast<uintptr_t>(p);
+    free(p);
+}
+
+/*
+ * 主SRAM与CCM RAM的对比。USB、串口DMA传输期间主SRAM上有总线争用，CCM不受影响，
+ * 应分别在空闲与大量串口收发时运行"bench mem"比较
+ */
+constexpr uint32_t BENCH_MEM_SIZE = 1024;
+alignas(4) uint8_t bench_sram[2][BENCH_MEM_SIZE];
+alignas(4) CCM_BSS uint8_t bench_ccm[2][BENCH_MEM_SIZE];
+CCM_BSS pid::Cascade<8> bench_pid_ccm;
+
+void bench_mem_copy_sram() { std::memcpy(bench_sram[1], bench_sram[0], BENCH_MEM_SIZE); }
+void bench_mem_copy_ccm() { std::memcpy(bench_ccm[1], bench_ccm[0], BENCH_MEM_SIZE); }
+void bench_mem_pid_cascade_ccm()
+{
+    bench_pid_ccm.update(bench_pid_target, bench_pid_pos, bench_pid_speed, bench_pid_out, 0.001f);
+}
+
+/*
+ * 姿态估计的一次更新(每个陀螺仪样本，2kHz)。加速度模长与方向在门限内，EKF每次都走完整的预测+观测路径，
+ * max即最坏情况
+ */
+attitude::Mahony bench_mahony(0.3f, 0.03f);
+attitude::Ekf bench_ekf;
+const float bench_gyro[3] = {0.01f, -0.02f, 0.3f};
+const float bench_accel[3] = {0.3f, -0.2f, 9.79f};
+
+void bench_att_mahony() { bench_sink = bench_mahony.update(bench_gyro, bench_accel, 0.001f); }
+void bench_att_ekf() { bench_sink = bench_ekf.update(bench_gyro, bench_accel, 0.001f); }
+void bench_att_euler() { bench_fsink = attitude::to_euler(bench_ekf.quat()).yaw; }
+
+/*
+ * 框架热路径。CAN回调、OD设备与upc实例在第一次运行bench时创建，不影响正常启动；
+ * 回调注册在can_map末尾，命中用例为当前注册数下的最坏查找
+ */
+constexpr uint32_t BENCH_CAN_ID = 0x7FF;
+constexpr uint32_t BENCH_CAN_MISS_ID = 0x7FE;
+int32_t bench_od = -1;
+upc *bench_upc = nullptr;
+uint8_t bench_upc_frame[UPC_TOTAL_LEN];
+DTM_DEFINE_TOPIC(float, bench_f);
+SlidingOLS<20> bench_ols;
+float bench_ols_y;
+
+void bench_setup()
+{
+    static bool done = false;
+    if (done)
+        return;
+    done = true;
+
+    static CANInstance can(&hcan2, 0, BENCH_CAN_ID, CAN_ID_STD, 8, CAN_RTR_DATA,
+                           [](const uint8_t *data) { bench_sink = data[0]; });
+    bench_od = OD::register_device("od_bench");
+
+    // 不接收串口数据，只直接调用decode；云台命令只更新内部状态，不会向总线发送
+    static upc pc(&huart1);
+    pc.cb_unregister();
+    pc.enable();
+    bench_upc = &pc;
+
+    struct __attribute__((packed)) GimbalPayload
+    {
+        float yaw, small_yaw, small_pitch;
+    };
+    upc_frame::Builder<0x0403, GimbalPayload, UPC_DATA_LEN>::build(bench_upc_frame, {0.5f, -0.25f, 0.125f});
+}
+
+void bench_can_dispatch_hit() { cb_handle(CAN2, BENCH_CAN_ID, bench_can_frame); }
+void bench_can_dispatch_miss() { cb_handle(CAN2, BENCH_CAN_MISS_ID, bench_can_frame); }
+
+void bench_dtm_publish()
+{
+    const float v = bench_x;
+    DTM_PUBLISH(bench_f, v);
+}
+void bench_dtm_get()
+{
+    float v;
+    DTM_GET(bench_f, v);
+    bench_fsink = v;
+}
+void bench_dtm_ref() { DTM_TOPIC_REF(bench_f) = bench_x; }
+
+void bench_od_update() { OD::update(bench_od); }
+void bench_od_update_by_name() { OD::update_by_name("od_bench"); }
+void bench_od_detect() { bench_sink = OD::detect(bench_od, 0.1f); }
+
+void bench_ols_update()
+{
+    bench_ols_y += 0.37f;
+    bench_ols.update(0.001f, bench_ols_y);
+}
+void bench_ols_derivative()
+{
+    bench_ols_y += 0.37f;
+    bench_fsink = bench_ols.derivative(0.001f, bench_ols_y);
+}
+
+/* upc::decode接收一帧时的校验: CRC8帧头 + CRC16全帧 */
+void bench_crc_verify_upc()
+{
+    bench_sink = Verify_CRC8_Check_Sum(bench_upc_frame, UPC_HEADER_LEN) &&
+                 Verify_CRC16_Check_Sum(bench_upc_frame, UPC_TOTAL_LEN);
+}
+void bench_upc_decode() { bench_upc->decode(bench_upc_frame); }
+
+/*
+ * 文本日志含格式化，二进制日志只复制参数。写入与日志缓冲区相同实现的私有环形缓冲区，
+ * 记录不会被发送，不会混进测试结果的输出；每个用例开始前清空。
+ * 重复次数限制在私有缓冲区放得下最长记录的范围内，否则后面测到的是缓冲区满时的丢弃路径
+ */
+constexpr uint32_t BENCH_LOG_RING_SIZE = 4096;
+constexpr uint32_t BENCH_LOG_REPEAT = BENCH_LOG_RING_SIZE / (LOG_BUFFER_SIZE + 4);
+alignas(4) uint8_t bench_log_buf[BENCH_LOG_RING_SIZE];
+ulog_ring_t bench_log_ring;
+void bench_log_write()
+{
+    log_write_to(&bench_log_ring, LOG_LEVEL_DEBUG, __FILE__, __LINE__, "bench %d %.3f", 42, 1.5);
+}
+void bench_log_write_bin()
+{
+    const uint32_t args[2] = {42, ulog_arg(1.5f)};
+    log_write_bin_to(&bench_log_ring, 0, args, 2);
+}
+
+const bench_case_t bench_cases[] = {
+    {"crc16_b1_22", 22, bench_crc<Crc16Bytewise, 22>},
+    {"crc16_s4_22", 22, bench_crc<Crc16Slice4, 22>},
+    {"crc16_s8_22", 22, bench_crc<Crc16Slice8, 22>},
+    {"crc16_b1_207", 207, bench_crc<Crc16Bytewise, 207>},
+    {"crc16_s4_207", 207, bench_crc<Crc16Slice4, 207>},
+    {"crc16_s8_207", 207, bench_crc<Crc16Slice8, 207>},
+    {"crc8_b1_5", 5, bench_crc<Crc8Bytewise, 5>},
+    {"crc8_s4_5", 5, bench_crc<Crc8Slice4, 5>},
+    {"crc8_b1_207", 207, bench_crc<Crc8Bytewise, 207>},
+    {"crc8_s4_207", 207, bench_crc<Crc8Slice4, 207>},
+    {"biquad_block_64", BENCH_BLOCK * sizeof(float), bench_biquad_block},
+    {"biquad_single_4ch", 4 * sizeof(float), bench_biquad_single4},
+    {"biquad_bank_4ch", 4 * sizeof(float), bench_biquad_bank4},
+    {"biquad_bank_6ch", 6 * sizeof(float), bench_biquad_bank6},
+    {"math_sqrt_legacy", 0, bench_sqrt_legacy},
+    {"math_sqrt", 0, bench_sqrt},
+    {"math_inv_sqrt_legacy", 0, bench_inv_sqrt_legacy},
+    {"math_inv_sqrt", 0, bench_inv_sqrt},
+    {"math_loop_constrain_legacy", 0, bench_loop_legacy},
+    {"math_loop_constrain", 0, bench_loop},
+    {"math_i16_constrain_scalar_8", 16, bench_i16_constrain_scalar},
+    {"math_i16_constrain_8", 16, bench_i16_constrain_array},
+    {"math_i16_deadband_scalar_8", 16, bench_i16_deadband_scalar},
+    {"math_i16_deadband_8", 16, bench_i16_deadband_array},
+    {"math_i16_dot_scalar_8", 32, bench_i16_dot_scalar},
+    {"math_i16_dot_8", 32, bench_i16_dot},
+    {"trig_sincos_b", 0, bench_trig_sincos_b},
+    {"trig_sincos_rad", 0, bench_trig_sincos},
+    {"trig_cmsis_sin_cos", 0, bench_cmsis_sin_cos},
+    {"trig_libm_sin_cos", 0, bench_libm_sin_cos},
+    {"trig_atan2", 0, bench_trig_atan2},
+    {"trig_libm_atan2", 0, bench_libm_atan2},
+    {"motor_decode_legacy", 8, bench_motor_decode_legacy},
+    {"motor_decode", 8, bench_motor_decode},
+    {"motor_pack", 8, bench_motor_pack},
+    {"pid_speed_8", 0, bench_pid_speed_8},
+    {"pid_cascade_8", 0, bench_pid_cascade_8},
+    {"pool_alloc_free", 64, bench_pool_alloc_free},
+    {"pool_libc_malloc_free", 64, bench_malloc_free},
+    {"mem_copy_sram_1k", BENCH_MEM_SIZE, bench_mem_copy_sram},
+    {"mem_copy_ccm_1k", BENCH_MEM_SIZE, bench_mem_copy_ccm},
+    {"mem_pid_cascade_8_sram", 0, bench_pid_cascade_8},
+    {"mem_pid_cascade_8_ccm", 0, bench_mem_pid_cascade_ccm},
+    {"att_mahony", 0, bench_att_mahony},
+    {"att_ekf", 0, bench_att_ekf},
+    {"att_euler", 0, bench_att_euler},
+    {"can_dispatch_hit", 8, bench_can_dispatch_hit},
+    {"can_dispatch_miss", 8, bench_can_dispatch_miss},
+    {"dtm_publish", sizeof(float), bench_dtm_publish},
+    {"dtm_get", sizeof(float), bench_dtm_get},
+    {"dtm_topic_ref", sizeof(float), bench_dtm_ref},
+    {"od_update", 0, bench_od_update},
+    {"od_update_by_name", 0, bench_od_update_by_name},
+    {"od_detect", 0, bench_od_detect},
+    {"ols_update_20", 0, bench_ols_update},
+    {"ols_derivative_20", 0, bench_ols_derivative},
+    {"crc_verify_upc_22", UPC_TOTAL_LEN, bench_crc_verify_upc},
+    {"upc_decode_22", UPC_TOTAL_LEN, bench_upc_decode},
+    {"log_write_text", 0, bench_log_write, BENCH_LOG_REPEAT},
+    {"log_write_bin", 0, bench_log_write_bin, BENCH_LOG_REPEAT},
+};
+
+uint32_t bench_samples[BENCH_REPEAT];
+
+/* 第一次运行冷缓存、分支预测未训练，计入max；min与分位数反映稳态 */
+void bench_run(const bench_case_t &c, const bool json)
+{
+    const uint32_t repeat = (c.repeat && c.repeat < BENCH_REPEAT) ? c.repeat : BENCH_REPEAT;
+    uint64_t sum = 0;
+
+    for (uint32_t i = 0; i < repeat; i++) {
+        const uint32_t t0 = DWT->CYCCNT;
+        c.run();
+        uint32_t cycles = DWT->CYCCNT - t0;
+        cycles = (cycles > DWT_Cost.cyccnt) ? cycles - DWT_Cost.cyccnt : 0;
+        sum += cycles;
+        bench_samples[i] = cycles;
+    }
+    std::sort(bench_samples, bench_samples + repeat);
+
+    const uint32_t min = bench_samples[0];
+    const uint32_t median = bench_samples[repeat / 2];
+    const uint32_t p90 = bench_samples[repeat * 9 / 10];
+    const uint32_t max = bench_samples[repeat - 1];
+    const uint32_t avg = (uint32_t)(sum / repeat);
+    const uint32_t per_kcycle = min ? (uint32_t)((uint64_t)c.bytes * 1000u / min) : 0;
+
+    if (json)
+        log_printf_raw("{\"name\":\"%s\",\"bytes\":%lu,\"min\":%lu,\"avg\":%lu,\"bytes_per_kcycle\":%lu,"
+                       "\"median\":%lu,\"p90\":%lu,\"max\":%lu,\"repeat\":%lu}\r\n",
+                       c.name, (unsigned long)c.bytes, (unsigned long)min, (unsigned long)avg,
+                       (unsigned long)per_kcycle, (unsigned long)median, (unsigned long)p90, (unsigned long)max,
+                       (unsigned long)repeat);
+    else
+        log_printf_raw("%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\r\n", c.name, (unsigned long)c.bytes,
+                       (unsigned long)min, (unsigned long)avg, (unsigned long)per_kcycle, (unsigned long)median,
+                       (unsigned long)p90, (unsigned long)max, (unsigned long)repeat);
+}
+
+void bench_cmd(const char *args)
+{
+    static const char header[] =
+        "name,bytes,min_cycles,avg_cycles,bytes_per_kcycle,median_cycles,p90_cycles,max_cycles,repeat\r\n";
+
+    const bool json = strncmp(args, "-j", 2) == 0 && (args[2] == '\0' || args[2] == ' ');
+    if (json) {
+        args += 2;
+        while (*args == ' ')
+            args++;
+    }
+    const size_t prefix = strlen(args);
+
+    bench_setup();
+    if (!json)
+        log_write_raw(header, sizeof(header) - 1);
+    for (const auto &c : bench_cases) {
+        if (strncmp(c.name, args, prefix) == 0) {
+            ulog_ring_init(&bench_log_ring, bench_log_buf, sizeof(bench_log_buf));
+            bench_run(c, json);
+            osDelay(1);
+        }
+    }
+}
+
+} // namespace
+
+#endif
+
+void bench_init(void)
+{
+#ifdef PROFILE_ENABLE
+    for (size_t i = 0; i < sizeof(bench_data); i++)
+        bench_data[i] = (uint8_t)(i * 131u + 7u);
+    for (uint32_t i = 0; i < BENCH_BLOCK; i++)
+        bench_signal[i] = (float)((int32_t)(i * 37u % 101u) - 50);
+    for (uint32_t i = 0; i < 8; i++) {
+        bench_i16[i] = (int16_t)(i * 5003u - 16000);
+        bench_i16b[i] = (int16_t)(i * 977u - 3000);
+    }
+    for (auto &f : bench_cascade)
+        bench_filter_design(f);
+    bench_filter_design(bench_bank4);
+    bench_filter_design(bench_bank6);
+    DTM_REGISTER_TOPIC(legacy_m3508_t[4], bench_m3508);
+    DTM_REGISTER_TOPIC(float, bench_f);
+    bench_pid.speed.set_all({2000.0f, 20000.0f, 0.0f, 5000.0f, 16000.0f, 1.0f, 0.0f});
+    bench_pid.pos.set_all({10.0f, 0.0f, 0.2f, 0.0f, 40.0f, 0.2f, 2000.0f});
+    bench_pid_target.pos_mask = 0xFF;
+    bench_pid_target.speed_mask = 0xFF;
+    for (uint32_t i = 0; i < 8; i++) {
+        bench_pid_target.pos[i] = (float)i;
+        bench_pid_pos[i] = bench_signal[i] * 0.01f;
+        bench_pid_speed[i] = bench_signal[i + 8] * 0.1f;
+    }
+    cmd_register("bench", bench_cmd);
+#endif
+}
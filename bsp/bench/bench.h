@@ -0,0 +1,32 @@
+#ifndef STANDARD_ROBOT_BENCH_H
+#define STANDARD_ROBOT_BENCH_H
+#include "typedef.h"
+
+/* 每个用例的重复次数，主机上可定义得更大以得到稳定的分位数 */
+#ifndef BENCH_REPEAT
+#define BENCH_REPEAT 32
+#endif
+
+/*
+ * 一个基准用例，run()执行一次被测代码，bytes为每次处理的数据量(不涉及数据量时为0)，
+ * repeat为重复次数的上限(0为BENCH_REPEAT)，用于有副作用、不能无限重复的用例
+ */
+typedef struct
+{
+    const char *name;
+    uint32_t bytes;
+    void (*run)(void);
+    uint32_t repeat;
+} bench_case_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void bench_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //STANDARD_ROBOT_BENCH_H
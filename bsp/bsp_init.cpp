@@ -4,20 +4,28 @@
 #include "dtm/dtm.h"
 #include "dwt/bsp_dwt.h"
 #include "online_detect/onl_det.h"
+#include "profile/profile.h"
+#include "trace/trace.h"
+#include "bench/bench.h"
+#include "tick/tick.h"
+#include "pool/pool.h"
 
 extern "C"
 {
 
-float get_current_time() {
-    return DWT_GetTimeline_s();  // 使用原来的时间函数
-}
-
 void bsp_init()
 {
-
-    // 初始化dtm数据中转站与OD在线状态监控器
+    // 初始化DWT时间模块，之后由TIM14中断维护64位周期计数
+    DWT_Init(SystemCoreClock / 1000000);
+    // 初始化dtm数据中转站与OD在线状态监控器，须在注册话题的bench_init等之前
     dtm::Manager::init();
-    OD::init(get_current_time);
+    OD::init(DWT_GetTime_us);
+    profile_init();
+    trace_init();
+    bench_init();
+    tick_init();
+    pool_init();
+
     // 初始化CAN滤波器
     can_filter_init(&hcan1);
     can_filter_init(&hcan2);
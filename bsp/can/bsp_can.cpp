@@ -6,6 +6,7 @@
  */
 
 #include "can/bsp_can.h"
+#include "profile/profile.h"
 
 typedef struct CAN_Callback
 {
@@ -13,7 +14,7 @@ typedef struct CAN_Callback
     uint32_t rx_id{};
     CAN_DecodeFunc decode;
 } CAN_Callback;
-static CAN_Callback can_map[50];
+static CCM_BSS CAN_Callback can_map[50];   // 每帧接收中断中查找，放在CCM RAM
 static uint16_t can_count = 0;
 
 CANInstance::CANInstance(CAN_HandleTypeDef* handler, const uint32_t tx_id, const uint32_t rx_id,
@@ -86,7 +87,8 @@ void can_filter_init(CAN_HandleTypeDef* hcan)
 {
     CAN_FilterTypeDef canfilter;
 
-    canfilter.FilterBank = 0;
+    // CAN1使用0~13号过滤器，CAN2使用14~27号，两路共用一组寄存器，SlaveStartFilterBank只在配置CAN1时生效
+    canfilter.FilterBank = (hcan->Instance == CAN2) ? 14 : 0;
     canfilter.FilterMode = CAN_FILTERMODE_IDMASK;
     canfilter.FilterScale = CAN_FILTERSCALE_32BIT;
     canfilter.FilterIdHigh = 0x0000;
@@ -95,10 +97,11 @@ void can_filter_init(CAN_HandleTypeDef* hcan)
     canfilter.FilterMaskIdLow = 0x0000;
     canfilter.FilterFIFOAssignment = CAN_RX_FIFO0;
     canfilter.FilterActivation = ENABLE;
-    canfilter.SlaveStartFilterBank = 13;
+    canfilter.SlaveStartFilterBank = 14;
 
     HAL_CAN_ConfigFilter(hcan, &canfilter);
     HAL_CAN_Start(hcan);
+    HAL_CAN_ActivateNotification(hcan, CAN_IT_RX_FIFO0_MSG_PENDING);
 }
 
 void cb_handle(const CAN_TypeDef* CANx, const uint32_t RxId, uint8_t* data) // @TODO: 如何提高找到正确回调速度
@@ -115,6 +118,7 @@ extern "C"{
 
 void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
 {
+    PROFILE_SCOPE(can_rx);
     CAN_RxHeaderTypeDef rx_header;
     uint8_t rx_data[8];
 	HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &rx_header, rx_data);
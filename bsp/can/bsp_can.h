@@ -28,4 +28,6 @@ public:
 
 };
 void can_filter_init(CAN_HandleTypeDef* hcan);
+/* 按总线与ID查找回调并调用，由接收中断调用 */
+void cb_handle(const CAN_TypeDef* CANx, uint32_t RxId, uint8_t* data);
 #endif //BSP_CAN_H
\ No newline at end of file
@@ -0,0 +1,81 @@
+/**
+ * @file cmd.c
+ * @brief USB虚拟串口调试命令
+ * 在USB中断中按行收集命令，在任务中调用cmd_poll执行，命令格式为"名称 参数\n"。
+ * 命令处理函数可能阻塞(例如大量输出日志)，因此不能在UlogTask中调用cmd_poll。
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "cmd/cmd.h"
+
+typedef struct
+{
+    const char *name;
+    cmd_handler_t handler;
+} cmd_entry_t;
+
+static cmd_entry_t cmd_map[CMD_MAX_COMMANDS];
+static uint8_t cmd_count = 0;
+
+static char cmd_rx_line[CMD_LINE_SIZE];
+static uint8_t cmd_rx_len = 0;
+static char cmd_line[CMD_LINE_SIZE];
+static volatile uint8_t cmd_pending = 0;
+
+int8_t cmd_register(const char *name, const cmd_handler_t handler)
+{
+    if (name == NULL || handler == NULL || cmd_count >= CMD_MAX_COMMANDS)
+        return -1;
+
+    cmd_map[cmd_count].name = name;
+    cmd_map[cmd_count].handler = handler;
+    return (int8_t)cmd_count++;
+}
+
+/**
+ * @brief 在USB接收中断中调用，上一条命令未执行完时丢弃新命令
+ */
+void cmd_receive(const uint8_t *buf, const uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        const char c = (char)buf[i];
+        if (c == '\r' || c == '\n')
+        {
+            if (cmd_rx_len > 0 && !cmd_pending)
+            {
+                memcpy(cmd_line, cmd_rx_line, cmd_rx_len);
+                cmd_line[cmd_rx_len] = '\0';
+                cmd_pending = 1;
+            }
+            cmd_rx_len = 0;
+        }
+        else if (cmd_rx_len < CMD_LINE_SIZE - 1)
+        {
+            cmd_rx_line[cmd_rx_len++] = c;
+        }
+    }
+}
+
+void cmd_poll(void)
+{
+    if (!cmd_pending)
+        return;
+
+    char *args = strchr(cmd_line, ' ');
+    if (args != NULL)
+        *args++ = '\0';
+    else
+        args = cmd_line + strlen(cmd_line);
+
+    for (uint8_t i = 0; i < cmd_count; i++)
+    {
+        if (strcmp(cmd_map[i].name, cmd_line) == 0)
+        {
+            cmd_map[i].handler(args);
+            break;
+        }
+    }
+    cmd_pending = 0;
+}
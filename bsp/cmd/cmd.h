@@ -0,0 +1,25 @@
+#ifndef STANDARD_ROBOT_CMD_H
+#define STANDARD_ROBOT_CMD_H
+#include "typedef.h"
+
+#ifndef CMD_MAX_COMMANDS
+#define CMD_MAX_COMMANDS 8
+#endif
+
+#define CMD_LINE_SIZE 64
+
+typedef void (*cmd_handler_t)(const char *args);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int8_t cmd_register(const char *name, cmd_handler_t handler);
+void cmd_receive(const uint8_t *buf, uint32_t len);
+void cmd_poll(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //STANDARD_ROBOT_CMD_H
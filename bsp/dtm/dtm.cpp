@@ -9,7 +9,8 @@
 
 namespace dtm {
 
-TopicInfo Manager::s_topics[DTM_MAX_TOPICS];
+// 每个控制周期都按名字/指针查找，放在CCM RAM，不与DMA争用总线
+CCM_BSS TopicInfo Manager::s_topics[DTM_MAX_TOPICS];
 uint32_t Manager::s_topic_count = 0;
 
 void Manager::init() {
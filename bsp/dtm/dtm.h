@@ -2,6 +2,7 @@
 
 #include <cstring>
 #include <cstdint>
+#include "main.h"
 #include "ulog/ulog.h"
 // 配置参数
 #ifndef DTM_MAX_TOPICS
@@ -47,6 +48,21 @@ public:
     T* ptr() { return &data_; }
     const T* ptr() const { return &data_; }
     static constexpr size_t size() { return sizeof(T); }
+
+    /* 关中断整体写入/读出，任务与中断中均可调用，读者不会读到写了一半的数据；只用于几十字节的结构体 */
+    void store(const T& data) {
+        const uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        data_ = data;
+        __set_PRIMASK(primask);
+    }
+
+    void load(T& out) const {
+        const uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        out = data_;
+        __set_PRIMASK(primask);
+    }
 };
 
 class Manager {
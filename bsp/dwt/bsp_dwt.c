@@ -1,14 +1,97 @@
+/**
+ * @file bsp_dwt.c
+ * @brief DWT周期计数器时间模块
+ * CYCCNT为32位，168MHz下约25.5s溢出一次。由TIM14(HAL时基，1kHz)中断调用DWT_CNT_Update
+ * 将其扩展为64位，读者无锁：更新方写入空闲槽后再递增代数，读者发现代数变化则重读。
+ * 周期到us/ns的换算使用乘法取高位(整数部分+64位小数)，不做64位除法。
+ * @version 1.1
+ * @date 2026-10-19
+ */
+
 #include "dwt/bsp_dwt.h"
 
 DWT_Time_t SysTime;
-static uint32_t CPU_FREQ_Hz, CPU_FREQ_Hz_ms, CPU_FREQ_Hz_us;
-static uint32_t CYCCNT_RountCount;
-static uint32_t CYCCNT_LAST;
-uint64_t CYCCNT64;
-static void DWT_CNT_Update(void);
+DWT_Cost_t DWT_Cost;
+static uint32_t CPU_FREQ_Hz, CPU_FREQ_Hz_us;
+
+/* 定点换算系数: 结果 = cycles * (mi + mf / 2^64)，mf向上取整使整数倍周期换算无误差 */
+typedef struct
+{
+    uint32_t mi;
+    uint64_t mf;
+} DWT_Scale_t;
+static DWT_Scale_t Scale_us, Scale_ns;
+
+/* 双槽64位基准，CYCCNT_Gen的最低位指示当前有效槽 */
+static volatile uint64_t CYCCNT_Base[2];
+static volatile uint32_t CYCCNT_Gen;
+
+static void DWT_ScaleInit(DWT_Scale_t *scale, const uint32_t unit_per_s)
+{
+    /* 仅初始化时做除法，两步长除得到64位小数 */
+    const uint64_t r0 = unit_per_s % CPU_FREQ_Hz;
+    const uint64_t r1 = (r0 << 32) % CPU_FREQ_Hz;
+    const uint64_t r2 = (r1 << 32) % CPU_FREQ_Hz;
+
+    scale->mi = unit_per_s / CPU_FREQ_Hz;
+    scale->mf = (((r0 << 32) / CPU_FREQ_Hz) << 32) | ((r1 << 32) / CPU_FREQ_Hz);
+    if (r2 != 0) scale->mf++;
+}
+
+/* 64x64乘法的高64位，4次UMULL */
+static uint64_t DWT_MulHi64(const uint64_t a, const uint64_t b)
+{
+    const uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    const uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    const uint64_t p0 = a_lo * b_lo;
+    const uint64_t p1 = a_lo * b_hi;
+    const uint64_t p2 = a_hi * b_lo;
+    const uint64_t p3 = a_hi * b_hi;
+    const uint64_t mid = (p0 >> 32) + (uint32_t)p1 + (uint32_t)p2;
+
+    return p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+}
+
+static uint64_t DWT_Scale(const uint64_t cycles, const DWT_Scale_t *scale)
+{
+    return cycles * scale->mi + DWT_MulHi64(cycles, scale->mf);
+}
+
+static void DWT_CostMeasure(void)
+{
+    volatile uint64_t sink;
+    uint32_t t0, t1, best;
+
+    best = UINT32_MAX;
+    for (int i = 0; i < 8; i++) {
+        t0 = DWT->CYCCNT;
+        t1 = DWT->CYCCNT;
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+    DWT_Cost.cyccnt = best;
+
+#define DWT_COST_OF(field, expr)                                \
+    best = UINT32_MAX;                                          \
+    for (int i = 0; i < 8; i++) {                               \
+        t0 = DWT->CYCCNT;                                       \
+        sink = (expr);                                          \
+        t1 = DWT->CYCCNT;                                       \
+        if (t1 - t0 < best) best = t1 - t0;                     \
+    }                                                           \
+    DWT_Cost.field = best - DWT_Cost.cyccnt
+
+    DWT_COST_OF(get_cycles, DWT_GetCycles());
+    DWT_COST_OF(get_time_us, DWT_GetTime_us());
+    DWT_COST_OF(get_time_ns, DWT_GetTime_ns());
+#undef DWT_COST_OF
+    (void)sink;
+}
 
 void DWT_Init(uint32_t CPU_Freq_mHz)
 {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
     /* 使能DWT外设 */
     CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
 
@@ -19,9 +102,82 @@ void DWT_Init(uint32_t CPU_Freq_mHz)
     DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 
     CPU_FREQ_Hz = CPU_Freq_mHz * 1000000;
-    CPU_FREQ_Hz_ms = CPU_FREQ_Hz / 1000;
     CPU_FREQ_Hz_us = CPU_FREQ_Hz / 1000000;
-    CYCCNT_RountCount = 0;
+    DWT_ScaleInit(&Scale_us, 1000000u);
+    DWT_ScaleInit(&Scale_ns, 1000000000u);
+
+    CYCCNT_Base[0] = 0;
+    CYCCNT_Base[1] = 0;
+    CYCCNT_Gen = 0;
+
+    __set_PRIMASK(primask);
+
+    DWT_CostMeasure();
+}
+
+/**
+ * @brief 扩展CYCCNT到64位，必须以小于2^32个周期的间隔调用，且只能有一个调用者(TIM14中断)
+ */
+void DWT_CNT_Update(void)
+{
+    const uint32_t gen = CYCCNT_Gen;
+    const uint64_t base = CYCCNT_Base[gen & 1u];
+    const uint32_t cnt_now = DWT->CYCCNT;
+
+    CYCCNT_Base[(gen + 1u) & 1u] = base + (uint32_t)(cnt_now - (uint32_t)base);
+    __DMB();
+    CYCCNT_Gen = gen + 1u;
+}
+
+uint64_t DWT_GetCycles(void)
+{
+    uint32_t gen, cnt_now;
+    uint64_t base;
+
+    do {
+        gen = CYCCNT_Gen;
+        __DMB();
+        base = CYCCNT_Base[gen & 1u];
+        cnt_now = DWT->CYCCNT;
+        __DMB();
+    } while (gen != CYCCNT_Gen);
+
+    return base + (uint32_t)(cnt_now - (uint32_t)base);
+}
+
+uint64_t DWT_CyclesToUs(const uint64_t cycles)
+{
+    return DWT_Scale(cycles, &Scale_us);
+}
+
+uint64_t DWT_CyclesToNs(const uint64_t cycles)
+{
+    return DWT_Scale(cycles, &Scale_ns);
+}
+
+uint64_t DWT_UsToCycles(const uint32_t us)
+{
+    return (uint64_t)us * CPU_FREQ_Hz_us;
+}
+
+uint64_t DWT_GetTime_us(void)
+{
+    return DWT_CyclesToUs(DWT_GetCycles());
+}
+
+uint64_t DWT_GetTime_ns(void)
+{
+    return DWT_CyclesToNs(DWT_GetCycles());
+}
+
+uint64_t DWT_Deadline_us(const uint32_t us)
+{
+    return DWT_GetCycles() + DWT_UsToCycles(us);
+}
+
+uint8_t DWT_DeadlineReached(const uint64_t deadline)
+{
+    return DWT_GetCycles() >= deadline;
 }
 
 float DWT_GetDeltaT(uint32_t *cnt_last)
@@ -30,8 +186,6 @@ float DWT_GetDeltaT(uint32_t *cnt_last)
     float dt = ((uint32_t)(cnt_now - *cnt_last)) / ((float)(CPU_FREQ_Hz));
     *cnt_last = cnt_now;
 
-    DWT_CNT_Update();
-
     return dt;
 }
 
@@ -41,70 +195,41 @@ double DWT_GetDeltaT64(uint32_t *cnt_last)
     double dt = ((uint32_t)(cnt_now - *cnt_last)) / ((double)(CPU_FREQ_Hz));
     *cnt_last = cnt_now;
 
-    DWT_CNT_Update();
-
     return dt;
 }
 
 void DWT_SysTimeUpdate(void)
 {
-    volatile uint32_t cnt_now = DWT->CYCCNT;
-    static uint64_t CNT_TEMP1, CNT_TEMP2, CNT_TEMP3;
-
-    DWT_CNT_Update();
+    const uint64_t us = DWT_GetTime_us();
+    const uint32_t s = (uint32_t)(us / 1000000u);
+    const uint32_t us_rem = (uint32_t)(us - (uint64_t)s * 1000000u);
 
-    CYCCNT64 = (uint64_t)CYCCNT_RountCount * (uint64_t)UINT32_MAX + (uint64_t)cnt_now;
-    CNT_TEMP1 = CYCCNT64 / CPU_FREQ_Hz;
-    CNT_TEMP2 = CYCCNT64 - CNT_TEMP1 * CPU_FREQ_Hz;
-    SysTime.s = CNT_TEMP1;
-    SysTime.ms = CNT_TEMP2 / CPU_FREQ_Hz_ms;
-    CNT_TEMP3 = CNT_TEMP2 - SysTime.ms * CPU_FREQ_Hz_ms;
-    SysTime.us = CNT_TEMP3 / CPU_FREQ_Hz_us;
+    SysTime.s = s;
+    SysTime.ms = us_rem / 1000u;
+    SysTime.us = us_rem - SysTime.ms * 1000u;
 }
 
 float DWT_GetTimeline_s(void)
 {
-    DWT_SysTimeUpdate();
-
-    float DWT_Timelinef32 = SysTime.s + SysTime.ms * 0.001f + SysTime.us * 0.000001f;
-
-    return DWT_Timelinef32;
+    return (float)DWT_GetTime_us() * 0.000001f;
 }
 
 float DWT_GetTimeline_ms(void)
 {
-    DWT_SysTimeUpdate();
-
-    float DWT_Timelinef32 = SysTime.s * 1000 + SysTime.ms + SysTime.us * 0.001f;
-
-    return DWT_Timelinef32;
+    return (float)DWT_GetTime_us() * 0.001f;
 }
 
 uint64_t DWT_GetTimeline_us(void)
 {
-    DWT_SysTimeUpdate();
-
-    uint64_t DWT_Timelinef32 = SysTime.s * 1000000 + SysTime.ms * 1000 + SysTime.us;
-
-    return DWT_Timelinef32;
-}
-
-static void DWT_CNT_Update(void)
-{
-    volatile uint32_t cnt_now = DWT->CYCCNT;
-
-    if (cnt_now < CYCCNT_LAST)
-        CYCCNT_RountCount++;
-
-    CYCCNT_LAST = cnt_now;
+    return DWT_GetTime_us();
 }
 
 void DWT_Delay(float Delay)
 {
     uint32_t tickstart = DWT->CYCCNT;
-    float wait = Delay;
+    const uint32_t wait = (uint32_t)(Delay * (float)CPU_FREQ_Hz);
 
-    while ((DWT->CYCCNT - tickstart) < wait * (float)CPU_FREQ_Hz)
+    while ((DWT->CYCCNT - tickstart) < wait)
     {
     }
 }
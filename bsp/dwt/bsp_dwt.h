@@ -11,7 +11,35 @@ typedef struct
     uint16_t us;
 } DWT_Time_t;
 
+/* 各时间接口单次调用开销(周期数)，DWT_Init时实测，已扣除读CYCCNT本身的开销 */
+typedef struct
+{
+    uint32_t cyccnt;        // 连续两次读CYCCNT的开销
+    uint32_t get_cycles;    // DWT_GetCycles
+    uint32_t get_time_us;   // DWT_GetTime_us
+    uint32_t get_time_ns;   // DWT_GetTime_ns
+} DWT_Cost_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 void DWT_Init(uint32_t CPU_Freq_mHz);
+void DWT_CNT_Update(void);
+
+/* 64位单调时间戳，单位为CPU周期 */
+uint64_t DWT_GetCycles(void);
+uint64_t DWT_CyclesToUs(uint64_t cycles);
+uint64_t DWT_CyclesToNs(uint64_t cycles);
+uint64_t DWT_UsToCycles(uint32_t us);
+uint64_t DWT_GetTime_us(void);
+uint64_t DWT_GetTime_ns(void);
+
+/* 截止时间，单位为CPU周期 */
+uint64_t DWT_Deadline_us(uint32_t us);
+uint8_t DWT_DeadlineReached(uint64_t deadline);
+
+/* 旧接口，浮点秒在长时间运行后会丢失精度，新代码请使用上面的整数接口 */
 float DWT_GetDeltaT(uint32_t *cnt_last);
 double DWT_GetDeltaT64(uint32_t *cnt_last);
 float DWT_GetTimeline_s(void);
@@ -21,5 +49,10 @@ void DWT_Delay(float Delay);
 void DWT_SysTimeUpdate(void);
 
 extern DWT_Time_t SysTime;
+extern DWT_Cost_t DWT_Cost;
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif /* BSP_DWT_H_ */
@@ -0,0 +1,57 @@
+/**
+ * @file bsp_exti.cpp
+ * @brief EXTI中断分发
+ * HAL_GPIO_EXTI_Callback按引脚号查表调用注册的回调，O(1)。
+ * 引脚模式、触发沿与NVIC优先级由CubeMX在gpio.c中配置
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "exti/bsp_exti.h"
+
+namespace {
+
+struct ExtiEntry
+{
+    exti_func_t func;
+    void *ctx;
+};
+
+ExtiEntry exti_map[16];
+
+int8_t exti_line(const uint16_t pin)
+{
+    if (pin == 0 || (pin & (pin - 1u)) != 0)
+        return -1;
+    return static_cast<int8_t>(31u - __CLZ(pin));
+}
+
+} // namespace
+
+extern "C"
+{
+
+int8_t exti_register(const uint16_t pin, const exti_func_t func, void *ctx)
+{
+    const int8_t line = exti_line(pin);
+    if (line < 0 || exti_map[line].func != nullptr)
+        return -1;
+
+    // 先写ctx，中断中看到func非空时ctx一定有效
+    exti_map[line].ctx = ctx;
+    __DMB();
+    exti_map[line].func = func;
+    return 0;
+}
+
+void HAL_GPIO_EXTI_Callback(const uint16_t GPIO_Pin)
+{
+    const int8_t line = exti_line(GPIO_Pin);
+    if (line < 0)
+        return;
+    const ExtiEntry &e = exti_map[line];
+    if (e.func)
+        e.func(e.ctx);
+}
+
+}
@@ -0,0 +1,24 @@
+#ifndef STANDARD_ROBOT_BSP_EXTI_H
+#define STANDARD_ROBOT_BSP_EXTI_H
+#include "typedef.h"
+#include "main.h"
+
+/* EXTI回调，在中断中执行 */
+typedef void (*exti_func_t)(void *ctx);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 注册一条EXTI线的回调，EXTI线号即引脚号，与端口无关
+ * @param pin 单个GPIO_PIN_x
+ * @return 0成功，pin无效或该线已被注册返回-1
+ */
+int8_t exti_register(uint16_t pin, exti_func_t func, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //STANDARD_ROBOT_BSP_EXTI_H
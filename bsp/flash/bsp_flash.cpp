@@ -0,0 +1,141 @@
+/**
+ * @file bsp_flash.cpp
+ * @brief 内部Flash参数存储区的记录读写
+ * 记录头: tag(16位) | len(16位) | crc(16位，覆盖tag、len与数据) | 0xFFFF，
+ * 头的第一个字为0xFFFFFFFF即空白区的开始。先写头再写数据，写了一半的记录仍可由len跳过
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "flash/bsp_flash.h"
+#include "algorithm/crc.h"
+#include <cstring>
+
+namespace flash_store {
+namespace {
+
+constexpr uint32_t HEADER = 8;
+constexpr uint32_t ERASED = 0xFFFFFFFFu;
+
+struct Header
+{
+    uint16_t tag;
+    uint16_t len;
+    uint16_t crc;
+    uint16_t reserved;
+};
+static_assert(sizeof(Header) == HEADER);
+
+const uint8_t *base()
+{
+    return reinterpret_cast<const uint8_t *>(FLASH_STORAGE_BASE);
+}
+
+uint32_t padded(const uint16_t len)
+{
+    return (static_cast<uint32_t>(len) + 3u) & ~3u;
+}
+
+uint16_t record_crc(const uint16_t tag, const uint16_t len, const void *data)
+{
+    const uint16_t id[2] = {tag, len};
+    crc::Crc16 c;
+    c.update(reinterpret_cast<const uint8_t *>(id), sizeof(id));
+    c.update(static_cast<const uint8_t *>(data), len);
+    return c.finalize();
+}
+
+/*
+ * 依次对每条记录调用f(偏移, 记录头)，返回第一个空白记录头的偏移；
+ * 记录头中的长度越界时认为其后都不可用，返回FLASH_STORAGE_SIZE
+ */
+template <typename F>
+uint32_t scan(F &&f)
+{
+    uint32_t off = 0;
+    while (off + HEADER <= FLASH_STORAGE_SIZE) {
+        Header h;
+        std::memcpy(&h, base() + off, HEADER);
+        uint32_t first;
+        std::memcpy(&first, &h, sizeof(first));
+        if (first == ERASED)
+            return off;
+        f(off, h);
+        off += HEADER + padded(h.len);
+    }
+    return FLASH_STORAGE_SIZE;
+}
+
+bool program(uint32_t off, const uint8_t *data, const uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i += 4, off += 4) {
+        uint32_t word = ERASED;
+        std::memcpy(&word, data + i, len - i < 4 ? len - i : 4);
+        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, FLASH_STORAGE_BASE + off, word) != HAL_OK)
+            return false;
+    }
+    return true;
+}
+
+bool erase()
+{
+    FLASH_EraseInitTypeDef e{};
+    e.TypeErase = FLASH_TYPEERASE_SECTORS;
+    e.Sector = FLASH_STORAGE_SECTOR;
+    e.NbSectors = 1;
+    e.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+    uint32_t sector_error = 0;
+    return HAL_FLASHEx_Erase(&e, &sector_error) == HAL_OK;
+}
+
+} // namespace
+
+bool load(const uint16_t tag, void *data, const uint16_t len)
+{
+    const uint8_t *found = nullptr;
+    scan([&](const uint32_t off, const Header &h) {
+        const uint8_t *payload = base() + off + HEADER;
+        if (h.tag == tag && h.len == len && off + HEADER + len <= FLASH_STORAGE_SIZE &&
+            record_crc(h.tag, h.len, payload) == h.crc)
+            found = payload;
+    });
+    if (found == nullptr)
+        return false;
+    std::memcpy(data, found, len);
+    return true;
+}
+
+Result save(const uint16_t tag, const void *data, const uint16_t len, const bool erase_if_full)
+{
+    const uint32_t size = HEADER + padded(len);
+    if (tag == 0xFFFF || size > FLASH_STORAGE_SIZE)
+        return Result::ERROR;
+
+    uint32_t off = scan([](uint32_t, const Header &) {});
+    if (off + size > FLASH_STORAGE_SIZE && !erase_if_full)
+        return Result::FULL;
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR | FLASH_FLAG_PGAERR |
+                           FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+    bool ok = true;
+    if (off + size > FLASH_STORAGE_SIZE) {
+        ok = erase();
+        off = 0;
+    }
+    const Header h{tag, len, record_crc(tag, len, data), 0xFFFF};
+    ok = ok && program(off, reinterpret_cast<const uint8_t *>(&h), HEADER) &&
+         program(off + HEADER, static_cast<const uint8_t *>(data), len);
+    HAL_FLASH_Lock();
+
+    // 回读校验
+    ok = ok && std::memcmp(base() + off + HEADER, data, len) == 0;
+    return ok ? Result::OK : Result::ERROR;
+}
+
+uint32_t free_bytes()
+{
+    return FLASH_STORAGE_SIZE - scan([](uint32_t, const Header &) {});
+}
+
+} // namespace flash_store
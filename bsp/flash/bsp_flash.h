@@ -0,0 +1,54 @@
+#ifndef STANDARD_ROBOT_BSP_FLASH_H
+#define STANDARD_ROBOT_BSP_FLASH_H
+#include "typedef.h"
+#include "main.h"
+
+/*
+ * 参数存储区: 内部Flash的最后一个扇区(扇区11，0x080E0000，128KB)，链接脚本中FLASH不含该扇区。
+ * 仿真中由stm32f4xx_hal.h替身定义为内存中的数组
+ */
+#ifndef FLASH_STORAGE_BASE
+#define FLASH_STORAGE_BASE   0x080E0000u
+#define FLASH_STORAGE_SIZE   (128u * 1024u)
+#define FLASH_STORAGE_SECTOR FLASH_SECTOR_11
+#endif
+
+#ifdef __cplusplus
+
+/**
+ * @brief 追加写入的记录存储
+ * 每条记录为8字节头(标签、长度、CRC16)加按4字节对齐的数据，依次写在扇区的空白处，
+ * 同一标签的最新一条有效记录即当前值；掉电时写了一半的记录CRC不符，读取时跳过。
+ * 扇区只在写满后擦除，擦除时保留的数据只有本次写入的记录。
+ * 写入与擦除期间从Flash取指与读数据的代码(包括中断)全部停顿:
+ * 每个字约16us，扇区擦除约1~2s，只能在机器人静止、无控制输出时调用。
+ * 只能在一个任务中写入
+ */
+namespace flash_store {
+
+enum class Result : uint8_t
+{
+    OK,
+    FULL,       // 剩余空间不足且不允许擦除
+    ERROR,      // 参数无效，或编程、擦除、校验失败
+};
+
+/**
+ * @brief 读取标签为tag的最新一条记录
+ * @return 找到长度恰为len且CRC正确的记录时返回true
+ */
+bool load(uint16_t tag, void *data, uint16_t len);
+
+/**
+ * @brief 追加一条记录
+ * @param erase_if_full 剩余空间不足时擦除扇区后写入，否则返回FULL
+ */
+Result save(uint16_t tag, const void *data, uint16_t len, bool erase_if_full);
+
+/* 剩余可写的字节数(含记录头) */
+uint32_t free_bytes();
+
+} // namespace flash_store
+#endif
+
+#endif //STANDARD_ROBOT_BSP_FLASH_H
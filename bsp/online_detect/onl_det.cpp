@@ -1,16 +1,16 @@
 #include "onl_det.h"
 
-OD::DeviceInfo OD::devices_[OD_MAX_DEVICES];
+CCM_BSS OD::DeviceInfo OD::devices_[OD_MAX_DEVICES];
 uint32_t OD::device_count_ = 0;
 uint32_t OD::online_bitmap_ = 0;
-float (*OD::get_time_func_)() = nullptr;
+uint64_t (*OD::get_time_func_)() = nullptr;
 
 OD::DeviceInfo::DeviceInfo()
-    : id(0), last_online_time(0.0f), is_registered(false) {
+    : id(0), last_online_time(0), is_registered(false) {
     name[0] = '\0';
 }
 
-void OD::init(float (*get_time_func)()) {
+void OD::init(uint64_t (*get_time_func)()) {
     get_time_func_ = get_time_func;
     device_count_ = 0;
     online_bitmap_ = 0;
@@ -42,7 +42,7 @@ int32_t OD::register_device(const char* name, const uint32_t id) {
     strncpy(devices_[index].name, name, sizeof(devices_[index].name) - 1);
     devices_[index].name[sizeof(devices_[index].name) - 1] = '\0';
     devices_[index].id = (id == 0) ? index : id;
-    devices_[index].last_online_time = get_time_func_();
+    devices_[index].last_online_time = static_cast<uint32_t>(get_time_func_());
     devices_[index].is_registered = true;
 
     online_bitmap_ |= (1 << index);
@@ -66,7 +66,7 @@ void OD::update(const int32_t handle) {
         return;
         }
 
-    devices_[handle].last_online_time = get_time_func_();
+    devices_[handle].last_online_time = static_cast<uint32_t>(get_time_func_());
     online_bitmap_ |= (1 << handle);
 }
 
@@ -85,8 +85,8 @@ bool OD::detect(const int32_t handle, const float timeout) {
         return false;
         }
 
-    const float current_time = get_time_func_();
-    if (current_time - devices_[handle].last_online_time > timeout) {
+    const auto current_time = static_cast<uint32_t>(get_time_func_());
+    if (current_time - devices_[handle].last_online_time > static_cast<uint32_t>(timeout * 1000000.0f)) {
         online_bitmap_ &= ~(1 << handle);
         return false;
     }
@@ -13,7 +13,7 @@ private:
     struct DeviceInfo {
         char name[32]{};
         uint32_t id;
-        float last_online_time;
+        uint32_t last_online_time;  // us，取低32位保证中断中写入为原子操作，按差值比较可跨越回绕
         bool is_registered;
 
         DeviceInfo();
@@ -22,7 +22,7 @@ private:
     static DeviceInfo devices_[OD_MAX_DEVICES];
     static uint32_t device_count_;
     static uint32_t online_bitmap_;
-    static float (*get_time_func_)();
+    static uint64_t (*get_time_func_)();
 
 public:
     // 禁止实例化
@@ -31,7 +31,7 @@ public:
     OD& operator=(const OD&) = delete;
     ~OD() = delete;
 
-    static void init(float (*get_time_func)());
+    static void init(uint64_t (*get_time_func)());
     static int32_t register_device(const char* name, uint32_t id = 0);
     static int32_t find_device(const char* name);
     static void update(int32_t handle);
@@ -0,0 +1,188 @@
+/**
+ * @file pool.cpp
+ * @brief 固定块内存池与按大小分级的分配接口
+ * 各级内存池为常量初始化的静态对象，位于.bss，上电后即可使用，不依赖构造顺序。
+ * 定义POOL_ROUTE_MALLOC时user_malloc改用pool_malloc；定义POOL_ROUTE_NEW时全局new/delete也从内存池分配，
+ * 不再使用newlib的堆，请求超过最大一级或内存池用尽时进入Error_Handler。
+ * 通过USB虚拟串口发送"pool"输出各级的使用情况
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "pool/pool.h"
+#include "cmd/cmd.h"
+#include "ulog/ulog.h"
+#include "main.h"
+#include <cstring>
+#include <new>
+
+namespace pool {
+
+void *Pool::alloc()
+{
+    for (;;) {
+        uint32_t head = head_.load(std::memory_order_acquire);
+        while ((head & 0xFFFFu) != NONE) {
+            const auto index = static_cast<uint16_t>(head & 0xFFFFu);
+            uint16_t next;
+            // 读到的next可能已被打断者改写，此时head的修改计数也已变化，比较交换失败后重读
+            std::memcpy(&next, block(index), sizeof(next));
+            const uint32_t tag = (head >> 16) + 1u;
+            if (head_.compare_exchange_weak(head, (tag << 16) | next, std::memory_order_acquire,
+                                            std::memory_order_acquire)) {
+                count_alloc();
+                return block(index);
+            }
+        }
+
+        uint16_t fresh = fresh_.load(std::memory_order_relaxed);
+        while (fresh < count_) {
+            if (fresh_.compare_exchange_weak(fresh, fresh + 1u, std::memory_order_relaxed)) {
+                count_alloc();
+                return block(fresh);
+            }
+        }
+
+        // 链表与未分配区都为空，期间没有被释放的块时才算失败
+        if ((head_.load(std::memory_order_acquire) & 0xFFFFu) == NONE)
+            break;
+    }
+    failures_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void Pool::count_alloc()
+{
+    const uint16_t used = used_.fetch_add(1, std::memory_order_relaxed) + 1u;
+    uint16_t hw = high_water_.load(std::memory_order_relaxed);
+    while (used > hw && !high_water_.compare_exchange_weak(hw, used, std::memory_order_relaxed)) {
+    }
+}
+
+void Pool::free(void *ptr)
+{
+    const auto index = static_cast<uint16_t>((static_cast<uint8_t *>(ptr) - storage_) / block_size_);
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    uint32_t next;
+    do {
+        const auto link = static_cast<uint16_t>(head & 0xFFFFu);
+        std::memcpy(block(index), &link, sizeof(link));
+        next = (((head >> 16) + 1u) << 16) | index;
+    } while (!head_.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+    used_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void Pool::stats(pool_stats_t &s) const
+{
+    s.block_size = block_size_;
+    s.count = count_;
+    s.used = used_.load(std::memory_order_relaxed);
+    s.high_water = high_water_.load(std::memory_order_relaxed);
+    s.failures = failures_.load(std::memory_order_relaxed);
+}
+
+} // namespace pool
+
+namespace {
+
+#define POOL_DEFINE(size, count) constinit pool::StaticPool<size, count> pool_##size;
+POOL_CLASSES(POOL_DEFINE)
+#undef POOL_DEFINE
+
+#define POOL_ENTRY(size, count) &pool_##size,
+constinit pool::Pool *const pools[] = {POOL_CLASSES(POOL_ENTRY)};
+#undef POOL_ENTRY
+
+constexpr uint8_t POOL_NUM = sizeof(pools) / sizeof(pools[0]);
+
+std::atomic<uint32_t> invalid_frees{0};
+
+void pool_cmd(const char *args)
+{
+    (void)args;
+    for (uint8_t i = 0; i < POOL_NUM; i++) {
+        pool_stats_t s;
+        pool_get_stats(i, &s);
+        log_printf_raw("[POOL] %ux%u used %u high %u fail %lu\r\n",
+                       s.block_size, s.count, s.used, s.high_water, (unsigned long)s.failures);
+    }
+    const uint32_t invalid = invalid_frees.load(std::memory_order_relaxed);
+    if (invalid)
+        log_printf_raw("[POOL] invalid free %lu\r\n", (unsigned long)invalid);
+}
+
+} // namespace
+
+extern "C"
+{
+
+void pool_init(void)
+{
+    cmd_register("pool", pool_cmd);
+}
+
+/**
+ * @brief 从能容纳size的最小一级分配，该级用尽时尝试更大的级
+ * @return 8字节对齐的块；size超过最大一级或各级都用尽时返回NULL
+ */
+void *pool_malloc(const size_t size)
+{
+    for (pool::Pool *p : pools) {
+        if (size > p->block_size())
+            continue;
+        if (void *ptr = p->alloc())
+            return ptr;
+    }
+    return nullptr;
+}
+
+/* 不属于任何内存池的指针不释放，只计数 */
+void pool_free(void *ptr)
+{
+    if (ptr == nullptr)
+        return;
+    for (pool::Pool *p : pools) {
+        if (p->owns(ptr)) {
+            p->free(ptr);
+            return;
+        }
+    }
+    invalid_frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint8_t pool_class_count(void)
+{
+    return POOL_NUM;
+}
+
+void pool_get_stats(const uint8_t index, pool_stats_t *stats)
+{
+    if (index < POOL_NUM)
+        pools[index]->stats(*stats);
+    else
+        std::memset(stats, 0, sizeof(*stats));
+}
+
+}
+
+#ifdef POOL_ROUTE_NEW
+/* 固件以-fno-exceptions编译，分配失败无法抛出bad_alloc */
+namespace {
+void *pool_new(const size_t size)
+{
+    void *ptr = pool_malloc(size ? size : 1);
+    if (ptr == nullptr)
+        Error_Handler();
+    return ptr;
+}
+} // namespace
+
+void *operator new(const size_t size) { return pool_new(size); }
+void *operator new[](const size_t size) { return pool_new(size); }
+void *operator new(const size_t size, const std::nothrow_t &) noexcept { return pool_malloc(size ? size : 1); }
+void *operator new[](const size_t size, const std::nothrow_t &) noexcept { return pool_malloc(size ? size : 1); }
+void operator delete(void *ptr) noexcept { pool_free(ptr); }
+void operator delete[](void *ptr) noexcept { pool_free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { pool_free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { pool_free(ptr); }
+#endif
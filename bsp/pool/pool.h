@@ -0,0 +1,123 @@
+#ifndef STANDARD_ROBOT_POOL_H
+#define STANDARD_ROBOT_POOL_H
+#include "typedef.h"
+
+/*
+ * 按大小分级的内存池，X(块大小, 块数)，块大小须为8的倍数且从小到大排列。
+ * pool_malloc从能容纳请求的最小一级分配，该级用尽时依次尝试更大的级
+ */
+#ifndef POOL_CLASSES
+#define POOL_CLASSES(X) \
+    X(32, 32)           \
+    X(64, 16)           \
+    X(128, 8)           \
+    X(256, 4)
+#endif
+
+typedef struct
+{
+    uint16_t block_size;
+    uint16_t count;
+    uint16_t used;          // 当前已分配的块数
+    uint16_t high_water;    // used的历史最大值
+    uint32_t failures;      // 本级用尽导致分配失败的次数
+} pool_stats_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void pool_init(void);
+void *pool_malloc(size_t size);
+void pool_free(void *ptr);
+uint8_t pool_class_count(void);
+void pool_get_stats(uint8_t index, pool_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+#include <atomic>
+#include <cstddef>
+
+namespace pool {
+
+/**
+ * @brief 固定块大小的内存池
+ * 空闲块组成单链表，链表指针(下一块的序号)存放在空闲块自身中，无额外开销。
+ * 表头为"修改计数 << 16 | 块序号"，alloc/free各为一次LDREX/STREX比较交换，
+ * 修改计数避免ABA问题；中断与任务可同时调用，不关中断也不挂起调度器。
+ * 比较交换只在被更高优先级的中断打断并修改同一个池时重试，重试次数不超过中断嵌套层数，
+ * 耗时有界且与块数无关。
+ * 从未分配过的块不在链表中，由fresh_顺序取出，构造时不需要遍历存储区
+ */
+class Pool
+{
+public:
+    static constexpr uint16_t NONE = 0xFFFF;
+
+    constexpr Pool(uint8_t *storage, const uint16_t block_size, const uint16_t count)
+        : storage_(storage), block_size_(block_size), count_(count)
+    {
+    }
+
+    Pool(const Pool &) = delete;
+    Pool &operator=(const Pool &) = delete;
+
+    /* 池用尽时返回nullptr并计入failures */
+    void *alloc();
+
+    /* ptr须为本池alloc返回的指针 */
+    void free(void *ptr);
+
+    [[nodiscard]] bool owns(const void *ptr) const
+    {
+        const auto p = static_cast<const uint8_t *>(ptr);
+        return p >= storage_ && p < storage_ + static_cast<size_t>(block_size_) * count_;
+    }
+
+    [[nodiscard]] uint16_t block_size() const { return block_size_; }
+    [[nodiscard]] uint16_t count() const { return count_; }
+
+    void stats(pool_stats_t &s) const;
+
+private:
+    uint8_t *const storage_;
+    const uint16_t block_size_;
+    const uint16_t count_;
+    std::atomic<uint32_t> head_{NONE};
+    std::atomic<uint16_t> fresh_{0};
+    std::atomic<uint16_t> used_{0};
+    std::atomic<uint16_t> high_water_{0};
+    std::atomic<uint32_t> failures_{0};
+
+    [[nodiscard]] uint8_t *block(const uint16_t index) const
+    {
+        return storage_ + static_cast<size_t>(block_size_) * index;
+    }
+
+    void count_alloc();
+};
+
+/**
+ * @brief 自带存储区的内存池，块大小与块数在编译期确定
+ * 构造函数为constexpr，静态对象在任何全局构造函数运行前即可使用
+ */
+template <size_t BlockSize, uint16_t Count>
+class StaticPool : public Pool
+{
+    static_assert(BlockSize >= sizeof(uint16_t) && BlockSize % 8 == 0 && BlockSize <= 0xFFFF);
+    static_assert(Count > 0 && Count < NONE);
+
+public:
+    constexpr StaticPool() : Pool(storage_, BlockSize, Count) {}
+
+private:
+    alignas(8) uint8_t storage_[BlockSize * Count]{};
+};
+
+} // namespace pool
+#endif
+
+#endif //STANDARD_ROBOT_POOL_H
@@ -0,0 +1,110 @@
+/**
+ * @file profile.c
+ * @brief 基于DWT周期计数器的代码区间耗时统计
+ * 每个区间统计次数、最小/最大/平均周期数与log2直方图，区间在第一次记录时加入链表。
+ * 通过USB虚拟串口发送"prof"输出所有区间，"prof reset"清空统计。
+ * 未定义PROFILE_ENABLE时所有区间宏为空，不产生任何代码。
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "profile/profile.h"
+#include "cmd/cmd.h"
+#include "ulog/ulog.h"
+
+static profile_zone_t *zone_list = NULL;
+
+static void profile_cmd(const char *args)
+{
+    if (strcmp(args, "reset") == 0)
+        profile_reset();
+    else
+        profile_dump();
+}
+
+void profile_init(void)
+{
+    cmd_register("prof", profile_cmd);
+}
+
+/**
+ * @brief 记录一次区间耗时，关中断更新统计，约十几个周期
+ * @param[in] cycles 区间耗时，已包含一次读CYCCNT的开销
+ */
+void profile_record(profile_zone_t *zone, uint32_t cycles)
+{
+    cycles = (cycles > DWT_Cost.cyccnt) ? cycles - DWT_Cost.cyccnt : 0;
+    uint32_t bin = 32u - __CLZ(cycles);
+    if (bin >= PROFILE_HIST_BINS)
+        bin = PROFILE_HIST_BINS - 1;
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!zone->registered)
+    {
+        zone->registered = 1;
+        zone->next = zone_list;
+        zone_list = zone;
+    }
+    zone->count++;
+    zone->sum += cycles;
+    if (cycles < zone->min) zone->min = cycles;
+    if (cycles > zone->max) zone->max = cycles;
+    zone->hist[bin]++;
+
+    __set_PRIMASK(primask);
+}
+
+void profile_reset(void)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    for (profile_zone_t *zone = zone_list; zone != NULL; zone = zone->next)
+    {
+        zone->count = 0;
+        zone->sum = 0;
+        zone->min = UINT32_MAX;
+        zone->max = 0;
+        __CLEAR(zone->hist);
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 输出所有区间统计，每个区间一行：名称 次数 最小 最大 平均 直方图
+ */
+void profile_dump(void)
+{
+    static const char header[] = "[PROF] zone count min max mean hist(log2 cycles)\r\n";
+    char line[LOG_BUFFER_SIZE * 2];
+
+    log_write_raw(header, sizeof(header) - 1);
+    for (const profile_zone_t *zone = zone_list; zone != NULL; zone = zone->next)
+    {
+        profile_zone_t snap;
+        const uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        snap = *zone;
+        __set_PRIMASK(primask);
+
+        if (snap.count == 0)
+            continue;
+
+        int len = snprintf(line, sizeof(line), "[PROF] %s %lu %lu %lu %lu",
+                           snap.name, (unsigned long)snap.count, (unsigned long)snap.min,
+                           (unsigned long)snap.max, (unsigned long)(snap.sum / snap.count));
+        for (uint32_t i = 0; i < PROFILE_HIST_BINS && len > 0 && len < (int)sizeof(line) - 12; i++)
+        {
+            len += snprintf(line + len, sizeof(line) - len, " %lu", (unsigned long)snap.hist[i]);
+        }
+        if (len > 0 && len < (int)sizeof(line) - 2)
+        {
+            line[len++] = '\r';
+            line[len++] = '\n';
+            log_write_raw(line, len);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef STANDARD_ROBOT_PROFILE_H
+#define STANDARD_ROBOT_PROFILE_H
+#include "typedef.h"
+#include "dwt/bsp_dwt.h"
+
+/* 直方图第i格统计耗时在[2^(i-1), 2^i)个周期内的次数，最后一格包含所有更长的耗时 */
+#ifndef PROFILE_HIST_BINS
+#define PROFILE_HIST_BINS 24
+#endif
+
+typedef struct profile_zone
+{
+    const char *name;
+    struct profile_zone *next;
+    uint8_t registered;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t hist[PROFILE_HIST_BINS];
+} profile_zone_t;
+
+#define PROFILE_ZONE_INIT(name_str) { (name_str), NULL, 0, 0, UINT32_MAX, 0, 0, {0} }
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void profile_init(void);
+void profile_record(profile_zone_t *zone, uint32_t cycles);
+void profile_reset(void);
+void profile_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*
+ * 区间起止时间保存在调用者的栈上，因此区间可以任意嵌套，也可以在中断与任务中同时使用。
+ * 嵌套时外层统计的是包含内层在内的总耗时。
+ * C:   PROFILE_BEGIN(can_rx); ... PROFILE_END(can_rx);   (同一作用域内)
+ * C++: PROFILE_SCOPE(can_rx);  离开作用域时自动记录
+ */
+#ifdef PROFILE_ENABLE
+
+#define PROFILE_BEGIN(name) \
+    static profile_zone_t profile_zone_##name = PROFILE_ZONE_INIT(#name); \
+    const uint32_t profile_start_##name = DWT->CYCCNT
+
+#define PROFILE_END(name) \
+    profile_record(&profile_zone_##name, DWT->CYCCNT - profile_start_##name)
+
+#ifdef __cplusplus
+namespace profile {
+
+class Scope
+{
+private:
+    profile_zone_t* zone_;
+    uint32_t start_;
+
+public:
+    explicit Scope(profile_zone_t* zone) : zone_(zone), start_(DWT->CYCCNT) {}
+    ~Scope() { profile_record(zone_, DWT->CYCCNT - start_); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+} // namespace profile
+
+#define PROFILE_SCOPE(name) \
+    static profile_zone_t profile_zone_##name = PROFILE_ZONE_INIT(#name); \
+    const profile::Scope profile_scope_##name(&profile_zone_##name)
+#endif
+
+#else
+
+#define PROFILE_BEGIN(name) ((void)0)
+#define PROFILE_END(name)   ((void)0)
+#define PROFILE_SCOPE(name) ((void)0)
+
+#endif
+
+#endif //STANDARD_ROBOT_PROFILE_H
@@ -0,0 +1,138 @@
+/**
+ * @file bsp_spi.cpp
+ * @brief SPI总线的DMA传输排队
+ * 每条总线一张设备表，同一时刻只有一个设备在传输；传输完成中断中拉高片选、调用完成回调，
+ * 再从下一个设备开始轮转查找排队的传输并启动，中断驱动的多个传感器共用一条总线时不需要任务参与
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "spi/bsp_spi.h"
+
+struct SPI_Bus
+{
+    SPI_HandleTypeDef *hspi;
+    SPI_Instance *devices[SPI_MAX_DEVICES];
+    uint8_t count;
+    uint8_t next;               // 轮转查找的起点
+    SPI_Instance *active;       // 正在DMA传输的设备
+
+    /* 须在关中断或DMA中断中调用 */
+    void start_next()
+    {
+        for (uint8_t k = 0; k < count; k++) {
+            SPI_Instance *dev = devices[(next + k) % count];
+            if (!dev->pending_)
+                continue;
+            next = static_cast<uint8_t>((next + k + 1) % count);
+            active = dev;
+            dev->cs_low();
+            if (HAL_SPI_TransmitReceive_DMA(hspi, const_cast<uint8_t *>(dev->tx_), dev->rx_, dev->len_) == HAL_OK)
+                return;
+            dev->cs_high();
+            dev->pending_ = false;
+            dev->errors_++;
+            active = nullptr;
+        }
+    }
+
+    void finish(const bool ok)
+    {
+        SPI_Instance *dev = active;
+        active = nullptr;
+        if (dev != nullptr) {
+            dev->cs_high();
+            dev->pending_ = false;
+            if (ok && dev->done_)
+                dev->done_(dev->ctx_);
+            else if (!ok)
+                dev->errors_++;
+        }
+        if (active == nullptr)
+            start_next();
+    }
+};
+
+namespace {
+
+SPI_Bus spi_buses[3];
+
+SPI_Bus *bus_of(const SPI_HandleTypeDef *hspi)
+{
+    for (auto &bus : spi_buses) {
+        if (bus.hspi == hspi)
+            return &bus;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+SPI_Instance::SPI_Instance(SPI_HandleTypeDef *hspi, GPIO_TypeDef *cs_port, const uint16_t cs_pin)
+    : hspi_(hspi), cs_port_(cs_port), cs_pin_(cs_pin)
+{
+    cs_high();
+    SPI_Bus *bus = bus_of(hspi);
+    if (bus == nullptr) {
+        bus = bus_of(nullptr);
+        if (bus == nullptr)
+            return;
+        bus->hspi = hspi;
+    }
+    if (bus->count < SPI_MAX_DEVICES)
+        bus->devices[bus->count++] = this;
+}
+
+HAL_StatusTypeDef SPI_Instance::transfer(const uint8_t *tx, uint8_t *rx, const uint16_t len,
+                                         const uint32_t timeout) const
+{
+    const SPI_Bus *bus = bus_of(hspi_);
+    if (bus == nullptr || bus->active != nullptr)
+        return HAL_BUSY;
+    cs_low();
+    const HAL_StatusTypeDef ret = HAL_SPI_TransmitReceive(hspi_, const_cast<uint8_t *>(tx), rx, len, timeout);
+    cs_high();
+    return ret;
+}
+
+bool SPI_Instance::transfer_dma(const uint8_t *tx, uint8_t *rx, const uint16_t len, const DoneFunc done, void *ctx)
+{
+    SPI_Bus *bus = bus_of(hspi_);
+    if (bus == nullptr)
+        return false;
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (pending_) {
+        overruns_++;
+        __set_PRIMASK(primask);
+        return false;
+    }
+    tx_ = tx;
+    rx_ = rx;
+    len_ = len;
+    done_ = done;
+    ctx_ = ctx;
+    pending_ = true;
+    if (bus->active == nullptr)
+        bus->start_next();
+    __set_PRIMASK(primask);
+    return true;
+}
+
+extern "C"
+{
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (SPI_Bus *bus = bus_of(hspi))
+        bus->finish(true);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (SPI_Bus *bus = bus_of(hspi))
+        bus->finish(false);
+}
+
+}
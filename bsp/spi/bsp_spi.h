@@ -0,0 +1,55 @@
+#ifndef STANDARD_ROBOT_BSP_SPI_H
+#define STANDARD_ROBOT_BSP_SPI_H
+#include "typedef.h"
+#include "spi.h"
+
+/* 一条SPI总线上的最大设备数 */
+#ifndef SPI_MAX_DEVICES
+#define SPI_MAX_DEVICES 4
+#endif
+
+/**
+ * @brief SPI总线上的一个设备(一根片选线)
+ * transfer_dma在中断或任务中排队一次全双工DMA传输，总线空闲时立即开始；
+ * 每个设备最多排队一次，总线上的设备按轮转顺序传输。传输完成后在DMA中断中拉高片选并调用done，
+ * done中可再次调用transfer_dma。收发缓冲区须在传输完成前保持有效，且不能位于CCM(用DMA_BUFFER)。
+ * transfer为阻塞传输，只用于初始化时的寄存器配置
+ */
+class SPI_Instance
+{
+public:
+    using DoneFunc = void (*)(void *ctx);
+
+    SPI_Instance(SPI_HandleTypeDef *hspi, GPIO_TypeDef *cs_port, uint16_t cs_pin);
+    SPI_Instance(const SPI_Instance &) = delete;
+    SPI_Instance &operator=(const SPI_Instance &) = delete;
+
+    /* 总线上有DMA传输时返回HAL_BUSY */
+    HAL_StatusTypeDef transfer(const uint8_t *tx, uint8_t *rx, uint16_t len, uint32_t timeout) const;
+
+    /* 该设备已有一次传输在排队或进行中时返回false，并计入overruns */
+    bool transfer_dma(const uint8_t *tx, uint8_t *rx, uint16_t len, DoneFunc done, void *ctx);
+
+    [[nodiscard]] uint32_t overruns() const { return overruns_; }
+    [[nodiscard]] uint32_t errors() const { return errors_; }
+
+private:
+    friend struct SPI_Bus;
+
+    SPI_HandleTypeDef *hspi_;
+    GPIO_TypeDef *cs_port_;
+    uint16_t cs_pin_;
+    const uint8_t *tx_ = nullptr;
+    uint8_t *rx_ = nullptr;
+    uint16_t len_ = 0;
+    DoneFunc done_ = nullptr;
+    void *ctx_ = nullptr;
+    volatile bool pending_ = false;
+    uint32_t overruns_ = 0;
+    uint32_t errors_ = 0;
+
+    void cs_low() const { HAL_GPIO_WritePin(cs_port_, cs_pin_, GPIO_PIN_RESET); }
+    void cs_high() const { HAL_GPIO_WritePin(cs_port_, cs_pin_, GPIO_PIN_SET); }
+};
+
+#endif //STANDARD_ROBOT_BSP_SPI_H
@@ -0,0 +1,190 @@
+/**
+ * @file tick.c
+ * @brief 硬件定时器驱动的控制周期
+ * TIM7以1~4kHz产生更新中断，中断中直接通知(task notification)调用tick_start的任务，
+ * 该任务应为最高优先级(任务表中固定在周期单调排序之上)，循环调用tick_wait() ... tick_done()。
+ * 周期与FreeRTOS节拍和其他任务的负载无关，抖动只取决于同优先级(5)中断与内核临界区的最长耗时。
+ * 释放时刻取定时器更新事件本身: 中断中读CYCCNT再减去TIM7计数器已走过的时间，不含中断响应延迟。
+ * 统计每周期的释放→开始延迟、执行时间、开始时刻抖动，以及周期重叠与超时次数，
+ * 通过USB虚拟串口发送"tick"输出，"tick reset"清零
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "tick/tick.h"
+#include "tim.h"
+#include "cmsis_os.h"
+#include "cmd/cmd.h"
+#include "ulog/ulog.h"
+#include "dwt/bsp_dwt.h"
+#include <string.h>
+
+static TaskHandle_t tick_task = NULL;
+static volatile uint32_t tick_release;  // 最近一次更新事件的CYCCNT
+static volatile uint32_t tick_count;    // 更新事件总数
+static volatile uint8_t tick_busy;      // tick_wait返回后到下一次调用tick_wait前为1
+static uint32_t tick_served;            // 已由tick_wait处理到的tick_count
+static uint32_t tick_cycles_per_count;  // TIM7计一个数对应的CPU周期数
+static uint32_t tick_cycle_release;     // 本周期对应的释放时刻: 最早一次未处理的更新事件
+static uint32_t tick_start_cnt;         // 本周期任务开始时的CYCCNT
+static uint32_t tick_last_start;
+static tick_stats_t stats;
+
+static void tick_cmd(const char *args)
+{
+    if (strcmp(args, "reset") == 0) {
+        tick_reset_stats();
+        return;
+    }
+
+    tick_stats_t s;
+    tick_get_stats(&s);
+    const uint32_t mhz = SystemCoreClock / 1000000u;
+    log_printf_raw("[TICK] %luHz cycles %lu overrun %lu miss %lu latency(us) %lu.%02lu/%lu.%02lu "
+                   "jitter %lu.%02lu exec %lu.%02lu/%lu.%02lu\r\n",
+                   (unsigned long)s.rate_hz, (unsigned long)s.cycles, (unsigned long)s.overruns,
+                   (unsigned long)s.deadline_miss,
+                   (unsigned long)(s.latency_min / mhz), (unsigned long)(s.latency_min % mhz * 100 / mhz),
+                   (unsigned long)(s.latency_max / mhz), (unsigned long)(s.latency_max % mhz * 100 / mhz),
+                   (unsigned long)(s.jitter_max / mhz), (unsigned long)(s.jitter_max % mhz * 100 / mhz),
+                   (unsigned long)(s.exec_min / mhz), (unsigned long)(s.exec_min % mhz * 100 / mhz),
+                   (unsigned long)(s.exec_max / mhz), (unsigned long)(s.exec_max % mhz * 100 / mhz));
+}
+
+void tick_init(void)
+{
+    tick_reset_stats();
+    cmd_register("tick", tick_cmd);
+}
+
+/**
+ * @brief 以rate_hz启动控制周期，调用任务成为被释放的任务
+ * @return rate_hz不在[TICK_RATE_MIN, TICK_RATE_MAX]内或不能整除定时器频率时返回0
+ */
+uint8_t tick_start(const uint32_t rate_hz)
+{
+    // APB1预分频不为1时定时器时钟为PCLK1的两倍
+    uint32_t tim_clk = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+        tim_clk *= 2u;
+    const uint32_t count_hz = tim_clk / (htim7.Init.Prescaler + 1u);
+
+    if (rate_hz < TICK_RATE_MIN || rate_hz > TICK_RATE_MAX || count_hz % rate_hz != 0 ||
+        count_hz / rate_hz > 65536u)
+        return 0;
+
+    HAL_TIM_Base_Stop_IT(&htim7);
+    tick_task = xTaskGetCurrentTaskHandle();
+    tick_cycles_per_count = SystemCoreClock / count_hz;
+    stats.rate_hz = rate_hz;
+    stats.period = SystemCoreClock / rate_hz;
+    tick_busy = 0;
+    tick_count = 0;
+    tick_served = 0;
+    tick_last_start = 0;
+
+    __HAL_TIM_SET_AUTORELOAD(&htim7, count_hz / rate_hz - 1u);
+    __HAL_TIM_SET_COUNTER(&htim7, 0);
+    ulTaskNotifyTake(pdTRUE, 0);
+    return HAL_TIM_Base_Start_IT(&htim7) == HAL_OK;
+}
+
+void tick_stop(void)
+{
+    HAL_TIM_Base_Stop_IT(&htim7);
+    tick_task = NULL;
+}
+
+/**
+ * @brief 在HAL_TIM_PeriodElapsedCallback中调用
+ * 任务未在tick_wait中等待时到来的释放即overrun，只在这里计数
+ */
+void tick_isr(void)
+{
+    const uint32_t now = DWT->CYCCNT;
+    tick_release = now - TIM7->CNT * tick_cycles_per_count;
+    tick_count++;
+
+    if (tick_task == NULL)
+        return;
+    if (tick_busy)
+        stats.overruns++;
+
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(tick_task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 等待下一次释放
+ * 多次未处理的释放只执行一次，本周期的延迟与截止时间从其中最早的一次算起。
+ * 定时器严格周期，最早一次的时刻由最近一次的时刻倒推，中断中只需保存最近一次
+ */
+void tick_wait(void)
+{
+    tick_busy = 0;
+
+    // 上一次返回后、关中断前到来的释放已在上一周期处理，其通知不算新的释放
+    while (tick_count == tick_served)
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    tick_start_cnt = DWT->CYCCNT;
+    tick_busy = 1;
+    const uint32_t count = tick_count;
+    tick_cycle_release = tick_release - (count - tick_served - 1u) * stats.period;
+    tick_served = count;
+    __set_PRIMASK(primask);
+
+    const uint32_t latency = tick_start_cnt - tick_cycle_release;
+    stats.latency_last = latency;
+    if (latency < stats.latency_min) stats.latency_min = latency;
+    if (latency > stats.latency_max) stats.latency_max = latency;
+
+    if (tick_last_start != 0) {
+        const int32_t jitter = (int32_t)(tick_start_cnt - tick_last_start - stats.period);
+        const uint32_t abs_jitter = jitter < 0 ? (uint32_t)-jitter : (uint32_t)jitter;
+        if (abs_jitter > stats.jitter_max) stats.jitter_max = abs_jitter;
+    }
+    tick_last_start = tick_start_cnt;
+}
+
+/**
+ * @brief 本周期的工作完成，在下一次tick_wait之前调用
+ */
+void tick_done(void)
+{
+    const uint32_t now = DWT->CYCCNT;
+    const uint32_t exec = now - tick_start_cnt;
+
+    stats.cycles++;
+    stats.exec_last = exec;
+    if (exec < stats.exec_min) stats.exec_min = exec;
+    if (exec > stats.exec_max) stats.exec_max = exec;
+    if (now - tick_cycle_release > stats.period)
+        stats.deadline_miss++;
+}
+
+void tick_get_stats(tick_stats_t *s)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *s = stats;
+    __set_PRIMASK(primask);
+}
+
+void tick_reset_stats(void)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const uint32_t rate = stats.rate_hz;
+    const uint32_t period = stats.period;
+    memset(&stats, 0, sizeof(stats));
+    stats.rate_hz = rate;
+    stats.period = period;
+    stats.latency_min = UINT32_MAX;
+    stats.exec_min = UINT32_MAX;
+    tick_last_start = 0;
+    __set_PRIMASK(primask);
+}
@@ -0,0 +1,42 @@
+#ifndef STANDARD_ROBOT_TICK_H
+#define STANDARD_ROBOT_TICK_H
+#include "typedef.h"
+
+#define TICK_RATE_MIN 1000u
+#define TICK_RATE_MAX 4000u
+
+/* 时间均以CPU周期计 */
+typedef struct
+{
+    uint32_t rate_hz;
+    uint32_t period;        // 一个控制周期的CPU周期数
+    uint32_t cycles;        // 已完成的控制周期数
+    uint32_t overruns;      // 释放时任务不在tick_wait中等待(上一周期尚未执行完)的次数
+    uint32_t deadline_miss; // 本周期最早一次未处理的释放到执行完的时间超过一个周期
+    uint32_t latency_last;  // 定时器更新事件到任务开始执行
+    uint32_t latency_min;
+    uint32_t latency_max;
+    uint32_t jitter_max;    // 相邻两次任务开始的间隔与period之差的最大绝对值
+    uint32_t exec_last;     // 任务开始到tick_done
+    uint32_t exec_min;
+    uint32_t exec_max;
+} tick_stats_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void tick_init(void);
+uint8_t tick_start(uint32_t rate_hz);
+void tick_stop(void);
+void tick_wait(void);
+void tick_done(void);
+void tick_isr(void);
+void tick_get_stats(tick_stats_t *stats);
+void tick_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //STANDARD_ROBOT_TICK_H
@@ -0,0 +1,225 @@
+/**
+ * @file trace.c
+ * @brief FreeRTOS运行时间统计与二进制调度跟踪
+ * 调度器通过FreeRTOSConfig.h中的trace宏记录任务切换、就绪、队列与任务通知事件，
+ * 中断通过TRACE_ISR_ENTER/EXIT记录进出，事件带CYCCNT时间戳写入环形缓冲区。
+ * 调试命令(USB虚拟串口):
+ *   trace start   清空并开始记录(快照模式，写满后覆盖最旧事件)
+ *   trace stream  开始记录并持续输出
+ *   trace stop    停止记录
+ *   trace dump    停止记录并输出缓冲区中的全部事件
+ *   top           输出上次执行top以来各任务CPU占用与栈剩余
+ * 二进制帧由tools/trace_decode解析为时间线与各任务调度延迟报告。
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "trace/trace.h"
+#include "task.h"
+#include "cmd/cmd.h"
+#include "ulog/ulog.h"
+#include "algorithm/crc.h"
+
+#define TRACE_RING_MASK (TRACE_RING_SIZE - 1)
+#define TRACE_EVENTS_PER_FRAME 24
+#define TRACE_FRAME_OVERHEAD 7
+#define TRACE_FRAMES_PER_POLL 4
+
+static trace_event_t trace_ring[TRACE_RING_SIZE];
+static volatile uint32_t trace_head = 0;
+static uint32_t trace_tail = 0;
+static uint32_t trace_dropped = 0;
+static volatile uint8_t trace_enabled = 0;
+static uint8_t trace_streaming = 0;
+static uint8_t trace_info_pending = 0;
+
+static TaskStatus_t task_status[TRACE_MAX_TASKS];
+
+/**
+ * @brief 记录一个事件，可在任意中断与任务中调用
+ */
+void trace_record(const uint8_t type, const uint8_t id, const uint16_t arg)
+{
+    if (!trace_enabled)
+        return;
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    trace_event_t *ev = &trace_ring[trace_head & TRACE_RING_MASK];
+    ev->timestamp = portGET_RUN_TIME_COUNTER_VALUE();
+    ev->type = type;
+    ev->id = id;
+    ev->arg = arg;
+    trace_head++;
+
+    __set_PRIMASK(primask);
+}
+
+static void trace_send_frame(const uint8_t type, const uint8_t *payload, const uint16_t len)
+{
+    static uint8_t frame[TRACE_FRAME_OVERHEAD + 8 + TRACE_EVENTS_PER_FRAME * sizeof(trace_event_t)];
+
+    frame[0] = TRACE_FRAME_HEADER;
+    frame[1] = TRACE_FRAME_TAG;
+    frame[2] = type;
+    frame[3] = len & 0xFF;
+    frame[4] = (len >> 8) & 0xFF;
+    memcpy(&frame[5], payload, len);
+    Append_CRC16_Check_Sum(frame, len + TRACE_FRAME_OVERHEAD);
+    log_write_raw((const char *)frame, len + TRACE_FRAME_OVERHEAD);
+}
+
+static void trace_send_info(void)
+{
+    uint8_t payload[2 + configMAX_TASK_NAME_LEN];
+    const uint32_t cpu_hz = SystemCoreClock;
+
+    trace_send_frame(TRACE_FRAME_INFO, (const uint8_t *)&cpu_hz, sizeof(cpu_hz));
+
+    const UBaseType_t n = uxTaskGetSystemState(task_status, TRACE_MAX_TASKS, NULL);
+    for (UBaseType_t i = 0; i < n; i++)
+    {
+        payload[0] = (uint8_t)task_status[i].xTaskNumber;
+        payload[1] = (uint8_t)task_status[i].uxCurrentPriority;
+        memset(&payload[2], 0, configMAX_TASK_NAME_LEN);
+        memcpy(&payload[2], task_status[i].pcTaskName, strnlen(task_status[i].pcTaskName, configMAX_TASK_NAME_LEN));
+        trace_send_frame(TRACE_FRAME_TASK, payload, sizeof(payload));
+    }
+}
+
+/**
+ * @brief 从trace_tail开始输出事件，写入方可能在拷贝期间覆盖数据，拷贝后再检查一次，被覆盖的部分计入丢弃
+ * @param[in] max_frames 最多输出的帧数
+ */
+static void trace_flush(const uint32_t max_frames)
+{
+    static uint8_t payload[8 + TRACE_EVENTS_PER_FRAME * sizeof(trace_event_t)];
+    trace_event_t *events = (trace_event_t *)&payload[8];
+    uint32_t frames = 0;
+
+    while (frames < max_frames)
+    {
+        uint32_t head = trace_head;
+        if (head - trace_tail > TRACE_RING_SIZE)
+        {
+            trace_dropped += head - trace_tail - TRACE_RING_SIZE;
+            trace_tail = head - TRACE_RING_SIZE;
+        }
+
+        uint32_t n = head - trace_tail;
+        if (n == 0)
+            break;
+        if (n > TRACE_EVENTS_PER_FRAME)
+            n = TRACE_EVENTS_PER_FRAME;
+
+        for (uint32_t i = 0; i < n; i++)
+            events[i] = trace_ring[(trace_tail + i) & TRACE_RING_MASK];
+
+        head = trace_head;
+        if (head - trace_tail > TRACE_RING_SIZE)
+            continue;
+
+        memcpy(&payload[0], &trace_tail, 4);
+        memcpy(&payload[4], &trace_dropped, 4);
+        trace_send_frame(TRACE_FRAME_EVENTS, payload, 8 + n * sizeof(trace_event_t));
+        trace_tail += n;
+        frames++;
+    }
+}
+
+static void trace_reset(void)
+{
+    trace_enabled = 0;
+    trace_head = 0;
+    trace_tail = 0;
+    trace_dropped = 0;
+}
+
+static void trace_cmd(const char *args)
+{
+    if (strcmp(args, "start") == 0)
+    {
+        trace_reset();
+        trace_streaming = 0;
+        trace_enabled = 1;
+    }
+    else if (strcmp(args, "stream") == 0)
+    {
+        trace_reset();
+        trace_streaming = 1;
+        trace_info_pending = 1;
+        trace_enabled = 1;
+    }
+    else if (strcmp(args, "stop") == 0)
+    {
+        trace_enabled = 0;
+        trace_streaming = 0;
+    }
+    else
+    {
+        trace_enabled = 0;
+        trace_streaming = 0;
+        trace_send_info();
+        trace_flush(UINT32_MAX);
+    }
+}
+
+/**
+ * @brief 输出自上次调用以来各任务的CPU占用(0.01%)与栈历史最小剩余(字)
+ */
+static void top_cmd(const char *args)
+{
+    static const char header[] = "[TOP] task prio cpu(0.01%) stack_free(words)\r\n";
+    static uint32_t last_counter[TRACE_MAX_TASKS + 1];
+    static uint32_t last_total = 0;
+    char line[LOG_BUFFER_SIZE];
+    uint32_t total;
+
+    const UBaseType_t n = uxTaskGetSystemState(task_status, TRACE_MAX_TASKS, &total);
+    const uint32_t window = total - last_total;
+    last_total = total;
+    if (window == 0)
+        return;
+
+    log_write_raw(header, sizeof(header) - 1);
+    for (UBaseType_t i = 0; i < n; i++)
+    {
+        const TaskStatus_t *status = &task_status[i];
+        uint32_t delta = status->ulRunTimeCounter;
+        if (status->xTaskNumber <= TRACE_MAX_TASKS)
+        {
+            delta -= last_counter[status->xTaskNumber];
+            last_counter[status->xTaskNumber] = status->ulRunTimeCounter;
+        }
+
+        const int len = snprintf(line, sizeof(line), "[TOP] %s %lu %lu %u\r\n",
+                                 status->pcTaskName, (unsigned long)status->uxCurrentPriority,
+                                 (unsigned long)((uint64_t)delta * 10000u / window),
+                                 (unsigned)status->usStackHighWaterMark);
+        if (len > 0 && len < (int)sizeof(line))
+            log_write_raw(line, len);
+    }
+}
+
+void trace_init(void)
+{
+    cmd_register("trace", trace_cmd);
+    cmd_register("top", top_cmd);
+}
+
+/**
+ * @brief 在任务中周期调用，流模式下输出新事件
+ */
+void trace_poll(void)
+{
+    if (!trace_streaming)
+        return;
+
+    if (trace_info_pending)
+    {
+        trace_info_pending = 0;
+        trace_send_info();
+    }
+    trace_flush(TRACE_FRAMES_PER_POLL);
+}
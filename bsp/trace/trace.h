@@ -0,0 +1,83 @@
+#ifndef STANDARD_ROBOT_TRACE_H
+#define STANDARD_ROBOT_TRACE_H
+#include "main.h"
+#include "typedef.h"
+#include "FreeRTOS.h"
+
+/* 事件环形缓冲区大小，必须为2的幂，每个事件8字节 */
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE 512
+#endif
+
+#ifndef TRACE_MAX_TASKS
+#define TRACE_MAX_TASKS 16
+#endif
+
+/* 帧格式(小端): 0xA5 'T' type len(u16) payload crc16(u16)，crc16覆盖帧头与payload */
+#define TRACE_FRAME_HEADER 0xA5
+#define TRACE_FRAME_TAG    'T'
+
+typedef enum
+{
+    TRACE_FRAME_INFO = 1,   // cpu_hz(u32)
+    TRACE_FRAME_TASK,       // number(u8) priority(u8) name[configMAX_TASK_NAME_LEN]
+    TRACE_FRAME_EVENTS,     // seq(u32) dropped(u32) trace_event_t...
+} trace_frame_t;
+
+/* 数值与FreeRTOSConfig.h中的trace宏保持一致 */
+typedef enum
+{
+    TRACE_EV_TASK_IN = 1,   // id: 切入的任务编号
+    TRACE_EV_TASK_READY,    // id: 进入就绪态的任务编号
+    TRACE_EV_ISR_ENTER,     // id: trace_isr_t
+    TRACE_EV_ISR_EXIT,      // id: trace_isr_t
+    TRACE_EV_QUEUE_SEND,    // arg: 队列地址低16位
+    TRACE_EV_QUEUE_RECV,    // arg: 队列地址低16位
+    TRACE_EV_NOTIFY,        // id: 被通知的任务编号
+    TRACE_EV_NOTIFY_WAIT,   // id: 等待通知的任务编号
+} trace_event_type_t;
+
+typedef enum
+{
+    TRACE_ISR_USART1 = 1,
+    TRACE_ISR_USART3,
+    TRACE_ISR_USART6,
+    TRACE_ISR_TIM14,
+    TRACE_ISR_OTG_FS,
+    TRACE_ISR_CAN1_RX0,
+    TRACE_ISR_CAN2_RX0,
+    TRACE_ISR_TIM7,
+    TRACE_ISR_EXTI4,
+    TRACE_ISR_EXTI9_5,
+    TRACE_ISR_DMA2_STREAM2,
+} trace_isr_t;
+
+typedef struct __PACKED
+{
+    uint32_t timestamp;     // DWT CYCCNT
+    uint8_t type;
+    uint8_t id;
+    uint16_t arg;
+} trace_event_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void trace_init(void);
+void trace_record(uint8_t type, uint8_t id, uint16_t arg);
+void trace_poll(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if (configUSE_SCHED_TRACE == 1)
+#define TRACE_ISR_ENTER(isr) trace_record(TRACE_EV_ISR_ENTER, (isr), 0)
+#define TRACE_ISR_EXIT(isr)  trace_record(TRACE_EV_ISR_EXIT, (isr), 0)
+#else
+#define TRACE_ISR_ENTER(isr) ((void)0)
+#define TRACE_ISR_EXIT(isr)  ((void)0)
+#endif
+
+#endif //STANDARD_ROBOT_TRACE_H
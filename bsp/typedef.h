@@ -9,6 +9,20 @@
 #define __COUNT(arr) sizeof(arr)/sizeof(arr[0])
 #define __CLEAR(arr) memset(arr, 0, sizeof(arr))
 
+/*
+ * 内存区域: CCM RAM(0x10000000, 64KB)只连接在D总线上，CPU访问不与DMA争用总线矩阵，但DMA不能访问。
+ * CCM_BSS放零初始化变量，CCM_DATA放有初值的变量(启动时从Flash复制)，只用于不经DMA的高频访问数据；
+ * DMA收发缓冲区用DMA_BUFFER固定在主SRAM，链接脚本检查其不落入CCM。
+ * DMA_BUFFER位于.bss(NOLOAD)，启动时清零，只能零初始化: 写在定义处的初值会被丢弃，须在运行时写入。
+ * 主机仿真中另行定义，sim_init同样清零
+ */
+#define CCM_BSS __attribute__((section(".ccmbss")))
+#define CCM_DATA __attribute__((section(".ccmram")))
+#ifndef DMA_BUFFER
+#define DMA_BUFFER __attribute__((section(".dma_buffer")))
+#endif
+#define IS_CCM_ADDR(p) (((uintptr_t)(p) & 0xFFFF0000u) == 0x10000000u)
+
 typedef unsigned char bool_t;
 typedef float fp32;
 typedef double fp64;
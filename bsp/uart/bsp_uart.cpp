@@ -7,15 +7,29 @@
  */
 
 #include "uart/bsp_uart.h"
+#include "profile/profile.h"
+#include <cstring>
 #define GET_UART_INDEX(instance) ((instance) == USART1 ? 0 : ((instance) == USART3 ? 1 : 2))
 
 extern DMA_HandleTypeDef hdma_usart1_rx;
 extern DMA_HandleTypeDef hdma_usart3_rx;
 extern DMA_HandleTypeDef hdma_usart6_rx;
 
-static uint8_t uart1_rx_buf[2][BUFLEN];
-static uint8_t uart3_rx_buf[2][BUFLEN];
-static uint8_t uart6_rx_buf[2][BUFLEN];
+/* DMA收发缓冲区为全局符号，链接脚本按名字检查其不落入CCM */
+DMA_BUFFER uint8_t uart1_rx_buf[2][BUFLEN];
+DMA_BUFFER uint8_t uart3_rx_buf[2][BUFLEN];
+DMA_BUFFER uint8_t uart6_rx_buf[2][BUFLEN];
+
+/* 发送双缓冲: 一个由DMA发送时，另一个供上层直接写入帧数据 */
+typedef struct
+{
+    uint8_t buf[2][BUFLEN];
+    uint8_t fill;           // 当前供写入的缓冲区
+    uint16_t pending;       // 写入缓冲区中等待发送的长度
+    volatile uint8_t busy;  // 另一缓冲区正在发送
+} uart_tx_t;
+
+DMA_BUFFER uart_tx_t uart_tx[3];
 
 static uint16_t uart_id[3] = {0}; // 0: USART1, 1: USART3, 2: USART6
 static UART_DecodeFunc uart_map[3][5] = {}; // 0: USART1, 1: USART3, 2: USART6
@@ -44,9 +58,67 @@ void UART_Instance::cb_unregister() const
     uart_map[index][id] = nullptr;
 }
 
-void UART_Instance::send(const uint8_t* data, const uint16_t len) const
+/* 在关中断或发送完成中断中调用 */
+static void uart_tx_start(UART_HandleTypeDef* huart, uart_tx_t* tx)
 {
-    HAL_UART_Transmit_DMA(huart, data, len);
+    if (tx->busy || tx->pending == 0)
+        return;
+    if (HAL_UART_Transmit_DMA(huart, tx->buf[tx->fill], tx->pending) != HAL_OK)
+        return;
+    tx->busy = 1;
+    tx->fill ^= 1u;
+    tx->pending = 0;
+}
+
+/**
+ * @brief 租用发送缓冲区，上层直接在其中组帧，之后调用tx_commit发送，省去一次拷贝
+ * @return 长度为BUFLEN的缓冲区，上一帧还未开始发送时返回nullptr
+ */
+uint8_t* UART_Instance::tx_lease() const
+{
+    uart_tx_t* tx = &uart_tx[GET_UART_INDEX(huart->Instance)];
+    uint8_t* buf = nullptr;
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uart_tx_start(huart, tx);
+    if (tx->pending == 0)
+        buf = tx->buf[tx->fill];
+    __set_PRIMASK(primask);
+
+    return buf;
+}
+
+/**
+ * @brief 提交租用缓冲区中的数据，DMA空闲时立即发送，否则在上一帧发送完成后发送
+ */
+void UART_Instance::tx_commit(const uint16_t len) const
+{
+    uart_tx_t* tx = &uart_tx[GET_UART_INDEX(huart->Instance)];
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    tx->pending = (len > BUFLEN) ? BUFLEN : len;
+    uart_tx_start(huart, tx);
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 复制到发送缓冲区后提交，与tx_lease/tx_commit共用双缓冲，不会打断正在进行的发送
+ * data可以是局部变量(任务栈位于CCM RAM，DMA不能访问，因此总是复制)。
+ * 与tx_lease相同，一个串口只能在一个任务中发送
+ * @return len超过BUFLEN或上一帧还未开始发送时返回false，不发送
+ */
+bool UART_Instance::send(const uint8_t* data, const uint16_t len) const
+{
+    if (len > BUFLEN)
+        return false;
+    uint8_t* buf = tx_lease();
+    if (buf == nullptr)
+        return false;
+    std::memcpy(buf, data, len);
+    tx_commit(len);
+    return true;
 }
 
 void cb_handle(const USART_TypeDef* instance, uint8_t* data)
@@ -63,6 +135,13 @@ void cb_handle(const USART_TypeDef* instance, uint8_t* data)
 
 extern "C"{
 
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    uart_tx_t* tx = &uart_tx[GET_UART_INDEX(huart->Instance)];
+    tx->busy = 0;
+    uart_tx_start(huart, tx);
+}
+
 void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size) //DMA
 {
     if(huart == &huart1)
@@ -99,9 +178,9 @@ void uart_init(const UART_HandleTypeDef *huart, const uint8_t double_buffer)
         {
             __HAL_DMA_DISABLE(hdma_rx);
         }
-        dma_instance->PAR = reinterpret_cast<uint32_t>(&(huart->Instance->DR));
-        dma_instance->M0AR = reinterpret_cast<uint32_t>(buf0);
-        dma_instance->M1AR = reinterpret_cast<uint32_t>(buf1);
+        dma_instance->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&(huart->Instance->DR)));
+        dma_instance->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(buf0));
+        dma_instance->M1AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(buf1));
         dma_instance->NDTR = BUFLEN;
         SET_BIT(dma_instance->CR, DMA_SxCR_DBM);
         __HAL_DMA_ENABLE(hdma_rx);
@@ -128,6 +207,7 @@ void uart_init(const UART_HandleTypeDef *huart, const uint8_t double_buffer)
 
 void usart_rec_handler(const UART_HandleTypeDef* huart)
 {
+    PROFILE_SCOPE(usart_rx);
     if(__HAL_UART_GET_FLAG(huart, UART_FLAG_RXNE))
     {
         __HAL_UART_CLEAR_PEFLAG(huart);
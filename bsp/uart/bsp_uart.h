@@ -30,7 +30,9 @@ public:
     ~UART_Instance();
     void cb_register() const;
     void cb_unregister() const;
-    void send(const uint8_t* data, uint16_t len) const;
+    bool send(const uint8_t* data, uint16_t len) const;
+    uint8_t* tx_lease() const;
+    void tx_commit(uint16_t len) const;
 };
 
 void uart_init(const UART_HandleTypeDef *huart, uint8_t double_buffer);
@@ -1,10 +1,16 @@
 /**
  * @file ulog.c
  * @brief 日志模块(Log Module)
- * 单开一个任务来将日志输出到USB虚拟串口，保证线程安全。
- * 给ulogTask的栈空间需大于两倍LOG_BUFFER_SIZE
- * @version 1.1
- * @date 2026-02-21
+ * 单开一个任务来将日志输出到USB虚拟串口。
+ * 各任务和中断通过无锁多生产者环形缓冲区写入日志：以CAS预留空间，写完后置提交标志，
+ * 由ulogTask按顺序取出已提交的记录，合并后写入USB虚拟串口的双缓冲发送队列。缓冲区满时直接丢弃并按级别计数，
+ * ulogTask平时阻塞在任务通知上，由写入空缓冲区的记录或USB发送完成(有积压时)唤醒，没有日志时不占用CPU。
+ * 丢弃数在下一次输出时报告，LOG_*不会阻塞调用方，可在中断中使用。
+ * 环形缓冲区的实现也可用于调用方自己的缓冲区(log_write_to等)，写入其中的记录不会被发送，供基准测试计时用。
+ * 定义ULOG_BINARY时LOG_*宏改用二进制模式，调用方只发送日志点ID、时间戳和原始参数，
+ * 不做格式化，由上位机tools/ulog_decode结合ELF中的格式串表还原文本
+ * @version 1.3
+ * @date 2026-10-19
  */
 
 #include "ulog.h"
@@ -13,34 +19,226 @@
 #include <stdio.h>
 #include <string.h>
 #include "cmsis_os.h"
-#include "stream_buffer.h"
 #include "usbd_cdc_if.h"
-static StreamBufferHandle_t xStreamBuffer = NULL;
+#include "usb_device.h"
+#include "algorithm/crc.h"
+#include "dwt/bsp_dwt.h"
+
+#define ULOG_RING_SIZE   8192u      // 必须为2的幂
+#define ULOG_RECORD_MAX  256u       // 单条记录最大长度，一个trace帧需能放进一条记录
+#define ULOG_TX_SIZE     512u       // 每次从环形缓冲区取出的最大长度
+#define ULOG_HDR_SIZE    4u
+#define ULOG_HDR_COMMIT  0x80000000u
+
+/*
+ * 记录格式: 头(u32, 已提交标志|长度) + 数据，按4字节对齐。
+ * head为生产者预留位置，tail为消费者读取位置，均为自由递增的计数，取模得到下标。
+ * 消费者读完一条记录后将其占用区域清零，保证生产者提交前头部一定读到0。
+ */
+static CCM_BSS uint8_t ulog_ring[ULOG_RING_SIZE] __attribute__((aligned(4)));   // 由CPU复制到USB发送缓冲区，不经DMA
+static ulog_ring_t log_ring = {ulog_ring, ULOG_RING_SIZE - 1u, 0, 0};
+static TaskHandle_t ulog_task = NULL;
+
+/* 下标0为log_write_raw，其余对应log_level_t */
+static uint32_t log_dropped[LOG_LEVEL_DEBUG + 1];
+
+static uint32_t ring_record_size(const uint32_t len)
+{
+    return (ULOG_HDR_SIZE + len + 3u) & ~3u;
+}
+
+static void ring_copy_in(ulog_ring_t *ring, const uint32_t pos, const void *src, const uint32_t len)
+{
+    const uint32_t idx = pos & ring->mask;
+    const uint32_t first = (len < ring->mask + 1u - idx) ? len : ring->mask + 1u - idx;
+
+    memcpy(&ring->buf[idx], src, first);
+    memcpy(ring->buf, (const uint8_t *)src + first, len - first);
+}
+
+static void ring_copy_out(const ulog_ring_t *ring, const uint32_t pos, void *dst, const uint32_t len)
+{
+    const uint32_t idx = pos & ring->mask;
+    const uint32_t first = (len < ring->mask + 1u - idx) ? len : ring->mask + 1u - idx;
+
+    memcpy(dst, &ring->buf[idx], first);
+    memcpy((uint8_t *)dst + first, ring->buf, len - first);
+}
+
+static void ring_clear(ulog_ring_t *ring, const uint32_t pos, const uint32_t len)
+{
+    const uint32_t idx = pos & ring->mask;
+    const uint32_t first = (len < ring->mask + 1u - idx) ? len : ring->mask + 1u - idx;
+
+    memset(&ring->buf[idx], 0, first);
+    memset(ring->buf, 0, len - first);
+}
+
+/* 唤醒ulogTask，任意任务或中断均可调用，调度器启动前忽略 */
+static void ulog_wake(void)
+{
+    TaskHandle_t task = ulog_task;
+
+    if (task == NULL)
+        return;
+    if (xPortIsInsideInterrupt()) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(task, &woken);
+        portYIELD_FROM_ISR(woken);
+    } else {
+        xTaskNotifyGive(task);
+    }
+}
+
+/**
+ * @brief 写入一条记录，任意任务或中断均可调用，耗时有界
+ * 写入日志缓冲区的记录恰好位于读取位置时(此前缓冲区为空，消费者已读到这里)唤醒ulogTask。
+ * 提交与读取位置的检查都用顺序一致的原子操作: 消费者停在未提交的记录上时，生产者一定看到tail等于该记录的位置
+ * @return 空间不足返回0
+ */
+static uint8_t ring_write(ulog_ring_t *ring, const void *data, const uint32_t len)
+{
+    const uint32_t need = ring_record_size(len);
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+
+    if (len > ULOG_RECORD_MAX)
+        return 0;
+    do {
+        const uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        if (head + need - tail > ring->mask + 1u)
+            return 0;
+    } while (!__atomic_compare_exchange_n(&ring->head, &head, head + need, 1,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    ring_copy_in(ring, head + ULOG_HDR_SIZE, data, len);
+    /* 头部4字节对齐且不会跨越缓冲区末尾 */
+    __atomic_store_n((uint32_t *)&ring->buf[head & ring->mask], len | ULOG_HDR_COMMIT, __ATOMIC_SEQ_CST);
+    if (ring == &log_ring && __atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST) == head)
+        ulog_wake();
+    return 1;
+}
+
+/**
+ * @brief 按顺序取出已提交的记录，每个缓冲区只能有一个读取者(日志缓冲区为ulogTask)
+ * 遇到已预留但未提交的记录时停止，等它提交后再继续
+ */
+static uint32_t ring_read(ulog_ring_t *ring, uint8_t *dst, const uint32_t cap)
+{
+    uint32_t n = 0;
+    uint32_t tail = ring->tail;
+
+    while (tail != __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)) {
+        const uint32_t hdr = __atomic_load_n((uint32_t *)&ring->buf[tail & ring->mask], __ATOMIC_ACQUIRE);
+        if ((hdr & ULOG_HDR_COMMIT) == 0)
+            break;
+
+        const uint32_t len = hdr & ~ULOG_HDR_COMMIT;
+        if (n + len > cap)
+            break;
+        ring_copy_out(ring, tail + ULOG_HDR_SIZE, dst + n, len);
+        n += len;
+
+        const uint32_t need = ring_record_size(len);
+        ring_clear(ring, tail, need);
+        tail += need;
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_SEQ_CST);
+    }
+    return n;
+}
+
+/**
+ * @brief 初始化调用方自己的环形缓冲区，写入其中的记录不会被发送
+ * @param buf  4字节对齐的缓冲区
+ * @param size 缓冲区大小，必须为2的幂
+ */
+void ulog_ring_init(ulog_ring_t *ring, uint8_t *buf, const uint32_t size)
+{
+    memset(buf, 0, size);
+    ring->buf = buf;
+    ring->mask = size - 1u;
+    ring->head = 0;
+    ring->tail = 0;
+}
+
+static void log_drop(const uint32_t index)
+{
+    __atomic_fetch_add(&log_dropped[index], 1u, __ATOMIC_RELAXED);
+}
+
+/* 有丢弃时生成一行报告并清零计数 */
+static uint32_t log_drop_report(char *dst, const uint32_t cap)
+{
+    uint32_t count[LOG_LEVEL_DEBUG + 1];
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i <= LOG_LEVEL_DEBUG; i++) {
+        count[i] = __atomic_exchange_n(&log_dropped[i], 0u, __ATOMIC_RELAXED);
+        total += count[i];
+    }
+    if (total == 0)
+        return 0;
+
+    const int len = snprintf(dst, cap, "[WARN] ulog: dropped error %lu warn %lu info %lu debug %lu raw %lu\r\n",
+                             (unsigned long)count[LOG_LEVEL_ERROR], (unsigned long)count[LOG_LEVEL_WARN],
+                             (unsigned long)count[LOG_LEVEL_INFO], (unsigned long)count[LOG_LEVEL_DEBUG],
+                             (unsigned long)count[0]);
+    return (len > 0 && (uint32_t)len < cap) ? (uint32_t)len : 0;
+}
+
+/**
+ * @brief 从环形缓冲区取出一批已提交的记录写入USB发送队列，只能由一个调用者调用
+ * @return 本次写入的字节数，为0时缓冲区已空
+ */
+uint32_t ulog_poll(void)
+{
+    static uint8_t tx_buf[ULOG_TX_SIZE];
+
+    /* 只取发送缓冲区放得下的量，剩余的留在环形缓冲区中，不会丢失 */
+    uint32_t space = CDC_TxSpace_FS();
+    if (space > ULOG_TX_SIZE) {
+        space = ULOG_TX_SIZE;
+    }
+
+    uint32_t len = ring_read(&log_ring, tx_buf, space);
+    if (len == 0 && space >= LOG_BUFFER_SIZE) {
+        len = log_drop_report((char *)tx_buf, space);
+    }
+
+    /* 长度为0时也调用，USB连接后启动积压数据的发送 */
+    CDC_Write_FS(tx_buf, len);
+    return len;
+}
+
+/**
+ * @brief USB发送缓冲区有了空间(发送完成、重新枚举)时在USB中断中调用，环形缓冲区中有积压时唤醒ulogTask
+ */
+void ulog_tx_ready(void)
+{
+    if (__atomic_load_n(&log_ring.tail, __ATOMIC_ACQUIRE) != __atomic_load_n(&log_ring.head, __ATOMIC_ACQUIRE))
+        ulog_wake();
+}
 
 void UlogTask(void const *argument)
 {
-    uint8_t rx_buf[LOG_BUFFER_SIZE];
-    xStreamBuffer = xStreamBufferCreate(LOG_BUFFER_SIZE * 2, 1);
+    ulog_task = xTaskGetCurrentTaskHandle();
+    // USB虚拟串口只由本任务发送，在此初始化(HAL_PCD_Init需要HAL节拍，必须在调度器启动后调用)
+    MX_USB_DEVICE_Init();
+
     while(1) {
-        const size_t received = xStreamBufferReceive(xStreamBuffer, rx_buf, LOG_BUFFER_SIZE, portMAX_DELAY);
-        if (received > 0) {
-            CDC_Transmit_FS(rx_buf, received);
-        }
-        else {
-            osDelay(10);
+        // 取到环形缓冲区为空或USB发送缓冲区已满，之后等待新日志或发送完成
+        while (ulog_poll() > 0) {
         }
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
 }
 
-void log_write(const log_level_t level, const char *file, const int line, const char *fmt, ...)
+static uint8_t log_vwrite(ulog_ring_t *ring, const log_level_t level, const char *file, const int line,
+                          const char *fmt, va_list args)
 {
-    va_list args;
-    va_start(args, fmt);
-    
     char log_buffer[LOG_BUFFER_SIZE];
     char *buffer_ptr = log_buffer;
     int remaining_size = LOG_BUFFER_SIZE;
-    
+
     const char *level_str;
     switch (level) {
         case LOG_LEVEL_ERROR: level_str = "ERROR"; break;
@@ -55,7 +253,7 @@ void log_write(const log_level_t level, const char *file, const int line, const
         buffer_ptr += header_len;
         remaining_size -= header_len;
     }
-    
+
     if (remaining_size > 0) {
         int content_len = vsnprintf(buffer_ptr, remaining_size, fmt, args);
         if (content_len > 0) {
@@ -66,7 +264,7 @@ void log_write(const log_level_t level, const char *file, const int line, const
             remaining_size -= content_len;
         }
     }
-    
+
     if (remaining_size > 1) {
         *buffer_ptr++ = '\r';
         *buffer_ptr++ = '\n';
@@ -75,10 +273,107 @@ void log_write(const log_level_t level, const char *file, const int line, const
     }
 
     const size_t total_len = buffer_ptr - log_buffer;
-    
-    if (total_len > 0 && xStreamBuffer != NULL) {
-        xStreamBufferSend(xStreamBuffer, log_buffer, total_len, portMAX_DELAY);
+
+    return total_len == 0 || ring_write(ring, log_buffer, total_len);
+}
+
+void log_write(const log_level_t level, const char *file, const int line, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    if (!log_vwrite(&log_ring, level, file, line, fmt, args)) {
+        log_drop(level <= LOG_LEVEL_DEBUG ? level : 0);
+    }
+    va_end(args);
+}
+
+/**
+ * @brief 同log_write，写入调用方的环形缓冲区
+ * @return 空间不足返回0
+ */
+uint8_t log_write_to(ulog_ring_t *ring, const log_level_t level, const char *file, const int line, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    const uint8_t ok = log_vwrite(ring, level, file, line, fmt, args);
+    va_end(args);
+    return ok;
+}
+
+/**
+ * @brief 不加日志头直接输出，用于调试命令的成块输出和trace帧
+ * 按ULOG_RECORD_MAX分块写入，每块保证连续不被其他日志插入。
+ * 成块输出不应丢失，任务中缓冲区满时等待，中断中则丢弃
+ */
+void log_write_raw(const char *data, size_t len)
+{
+    while (len > 0) {
+        const size_t chunk = (len > ULOG_RECORD_MAX) ? ULOG_RECORD_MAX : len;
+        if (!ring_write(&log_ring, data, chunk)) {
+            if (xPortIsInsideInterrupt() || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+                log_drop(0);
+                return;
+            }
+            osDelay(1);
+            continue;
+        }
+        data += chunk;
+        len -= chunk;
     }
-    
+}
+
+static uint8_t log_vwrite_bin(ulog_ring_t *ring, const uint16_t id, const uint32_t *args, uint8_t nargs)
+{
+    uint8_t frame[ULOG_FRAME_OVERHEAD + 6 + ULOG_MAX_ARGS * 4];
+
+    if (nargs > ULOG_MAX_ARGS)
+        nargs = ULOG_MAX_ARGS;
+
+    const uint16_t len = 6 + nargs * 4;
+    const uint32_t timestamp = (uint32_t)DWT_GetTime_us();
+    frame[0] = ULOG_FRAME_HEADER;
+    frame[1] = ULOG_FRAME_TAG;
+    frame[2] = ULOG_FRAME_LOG;
+    memcpy(&frame[3], &len, 2);
+    memcpy(&frame[5], &id, 2);
+    memcpy(&frame[7], &timestamp, 4);
+    memcpy(&frame[11], args, nargs * 4);
+    Append_CRC16_Check_Sum(frame, len + ULOG_FRAME_OVERHEAD);
+
+    return ring_write(ring, frame, len + ULOG_FRAME_OVERHEAD);
+}
+
+/**
+ * @brief 格式化后不加日志头输出，用于调试命令的逐行输出
+ * 一行最长ULOG_RECORD_MAX，超出部分截断；调用规则同log_write_raw
+ */
+void log_printf_raw(const char *fmt, ...)
+{
+    char line[ULOG_RECORD_MAX];
+    va_list args;
+    va_start(args, fmt);
+    const int len = vsnprintf(line, sizeof(line), fmt, args);
     va_end(args);
+    if (len > 0)
+        log_write_raw(line, (size_t)len < sizeof(line) ? (size_t)len : sizeof(line) - 1);
+}
+
+/**
+ * @brief 二进制日志，由ULOG_BIN宏调用
+ * 不阻塞调用方，缓冲区满时丢弃并计数，可在中断中调用
+ */
+void log_write_bin(const log_level_t level, const uint16_t id, const uint32_t *args, const uint8_t nargs)
+{
+    if (!log_vwrite_bin(&log_ring, id, args, nargs)) {
+        log_drop(level <= LOG_LEVEL_DEBUG ? level : 0);
+    }
+}
+
+/**
+ * @brief 同log_write_bin，写入调用方的环形缓冲区
+ * @return 空间不足返回0
+ */
+uint8_t log_write_bin_to(ulog_ring_t *ring, const uint16_t id, const uint32_t *args, const uint8_t nargs)
+{
+    return log_vwrite_bin(ring, id, args, nargs);
 }
@@ -11,10 +11,113 @@ typedef enum {
 
 #define LOG_BUFFER_SIZE 128
 
+/*
+ * 二进制日志帧: 0xA5 'L' type len(u16) | id(u16) timestamp_us(u32) args(u32 * n) | crc16
+ * 与bsp/trace的帧格式一致，可与文本输出混在同一虚拟串口中，由tools/ulog_decode解析
+ */
+#define ULOG_FRAME_HEADER   0xA5
+#define ULOG_FRAME_TAG      'L'
+#define ULOG_FRAME_LOG      1
+#define ULOG_FRAME_OVERHEAD 7
+#define ULOG_MAX_ARGS       8
+
+/* 无锁多生产者环形缓冲区，head/tail为自由递增的计数 */
+typedef struct {
+    uint8_t *buf;
+    uint32_t mask;
+    uint32_t head;
+    uint32_t tail;
+} ulog_ring_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 void log_write(log_level_t level, const char *file, int line, const char *fmt, ...);
+void log_write_raw(const char *data, size_t len);
+void log_printf_raw(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+void log_write_bin(log_level_t level, uint16_t id, const uint32_t *args, uint8_t nargs);
+uint8_t log_write_to(ulog_ring_t *ring, log_level_t level, const char *file, int line, const char *fmt, ...);
+uint8_t log_write_bin_to(ulog_ring_t *ring, uint16_t id, const uint32_t *args, uint8_t nargs);
+void ulog_ring_init(ulog_ring_t *ring, uint8_t *buf, uint32_t size);
+uint32_t ulog_poll(void);
+void ulog_tx_ready(void);
 void UlogTask(void const *argument);
+#ifdef __cplusplus
+}
+#endif
+
+/*
+ * 二进制模式下每个参数按32位传输: 整数截断为32位，浮点转为float，
+ * %s只支持指向flash中常量字符串的指针(上位机从ELF中读取)
+ */
+#ifdef __cplusplus
+#include <cstring>
+#include <type_traits>
+static inline uint32_t ulog_arg(const float v) { uint32_t u; std::memcpy(&u, &v, sizeof(u)); return u; }
+static inline uint32_t ulog_arg(const double v) { return ulog_arg(static_cast<float>(v)); }
+template <typename T>
+static inline uint32_t ulog_arg(const T v)
+{
+    if constexpr (std::is_pointer_v<T>)
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(v));
+    else
+        return static_cast<uint32_t>(v);
+}
+#define ULOG_ARG(x) ulog_arg(x)
+#else
+#include <string.h>
+static inline uint32_t ulog_arg_f(const float v) { uint32_t u; memcpy(&u, &v, sizeof(u)); return u; }
+static inline uint32_t ulog_arg_d(const double v) { return ulog_arg_f((float)v); }
+static inline uint32_t ulog_arg_p(const void *v) { return (uint32_t)(uintptr_t)v; }
+static inline uint32_t ulog_arg_i(const uint32_t v) { return v; }
+#define ULOG_ARG(x) _Generic((x),       \
+    float: ulog_arg_f,                  \
+    double: ulog_arg_d,                 \
+    char *: ulog_arg_p,                 \
+    const char *: ulog_arg_p,           \
+    void *: ulog_arg_p,                 \
+    const void *: ulog_arg_p,           \
+    default: ulog_arg_i)(x)
+#endif
+
+#define ULOG_STR_(x) #x
+#define ULOG_STR(x) ULOG_STR_(x)
+#define ULOG_CAT_(a, b) a##b
+#define ULOG_CAT(a, b) ULOG_CAT_(a, b)
+#define ULOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+#define ULOG_NARGS(...) ULOG_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+
+#define ULOG_MAP_0()
+#define ULOG_MAP_1(a)                      , ULOG_ARG(a)
+#define ULOG_MAP_2(a, b)                   ULOG_MAP_1(a) ULOG_MAP_1(b)
+#define ULOG_MAP_3(a, b, c)                ULOG_MAP_2(a, b) ULOG_MAP_1(c)
+#define ULOG_MAP_4(a, b, c, d)             ULOG_MAP_3(a, b, c) ULOG_MAP_1(d)
+#define ULOG_MAP_5(a, b, c, d, e)          ULOG_MAP_4(a, b, c, d) ULOG_MAP_1(e)
+#define ULOG_MAP_6(a, b, c, d, e, f)       ULOG_MAP_5(a, b, c, d, e) ULOG_MAP_1(f)
+#define ULOG_MAP_7(a, b, c, d, e, f, g)    ULOG_MAP_6(a, b, c, d, e, f) ULOG_MAP_1(g)
+#define ULOG_MAP_8(a, b, c, d, e, f, g, h) ULOG_MAP_7(a, b, c, d, e, f, g) ULOG_MAP_1(h)
+#define ULOG_MAP(...) ULOG_CAT(ULOG_MAP_, ULOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+/*
+ * 每个日志点在.ulog_fmt段(链接脚本中为INFO段，不下载到目标板)中放一条
+ * "级别\0文件\0行号\0格式串"，其段内偏移即为该日志点的ID，运行时只发送ID、时间戳和参数。
+ * ID为16位，链接脚本检查段大小不超过64KB
+ */
+#define ULOG_BIN(level, level_str, fmt, ...)                                        \
+    do {                                                                            \
+        static const char ulog_fmt_[] __attribute__((section(".ulog_fmt"), used)) = \
+            level_str "\0" __FILE__ "\0" ULOG_STR(__LINE__) "\0" fmt;                  \
+        const uint32_t ulog_args_[] = {0 ULOG_MAP(__VA_ARGS__)};                    \
+        log_write_bin(level, (uint16_t)(uintptr_t)ulog_fmt_, ulog_args_ + 1,       \
+                      ULOG_NARGS(__VA_ARGS__));                                     \
+    } while (0)
 
-#ifdef LOG_ENABLE
+#if defined(LOG_ENABLE) && defined(ULOG_BINARY)
+#define LOG_ERROR(fmt, ...) ULOG_BIN(LOG_LEVEL_ERROR, "ERROR", fmt, ##__VA_ARGS__)
+#define LOG_WARN(fmt, ...)  ULOG_BIN(LOG_LEVEL_WARN, "WARN", fmt, ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...)  ULOG_BIN(LOG_LEVEL_INFO, "INFO", fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(fmt, ...) ULOG_BIN(LOG_LEVEL_DEBUG, "DEBUG", fmt, ##__VA_ARGS__)
+#elif defined(LOG_ENABLE)
 #define LOG_ERROR(fmt, ...) log_write(LOG_LEVEL_ERROR, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
 #define LOG_WARN(fmt, ...)  log_write(LOG_LEVEL_WARN, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
 #define LOG_INFO(fmt, ...)  log_write(LOG_LEVEL_INFO, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
@@ -0,0 +1,320 @@
+/**
+ * @file bmi088.cpp
+ * @brief BMI088驱动实现
+ * SPI读时序: 陀螺仪在地址字节后直接输出数据，加速度计在地址字节后先输出一个无效字节。
+ * 加速度计上电与软复位后处于I2C模式，片选的第一个上升沿后切换到SPI模式，因此先做一次空读
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "imu/bmi088.h"
+#include "spi/bsp_spi.h"
+#include "exti/bsp_exti.h"
+#include "dwt/bsp_dwt.h"
+#include "cmsis_os.h"
+#include "online_detect/onl_det.h"
+#include "profile/profile.h"
+#include "ulog/ulog.h"
+
+/*
+ * DMA收发缓冲区，不能位于CCM；定义为全局C符号，链接脚本按名字检查其地址。
+ * DMA_BUFFER只能零初始化，发送的地址字节在init中写入
+ */
+extern "C" {
+DMA_BUFFER uint8_t bmi088_gyro_tx[7];
+DMA_BUFFER uint8_t bmi088_gyro_rx[7];
+DMA_BUFFER uint8_t bmi088_accel_tx[8];
+DMA_BUFFER uint8_t bmi088_accel_rx[8];
+DMA_BUFFER uint8_t bmi088_temp_tx[4];
+DMA_BUFFER uint8_t bmi088_temp_rx[4];
+}
+
+namespace bmi088 {
+namespace {
+
+constexpr uint8_t READ = 0x80;
+constexpr uint32_t SPI_TIMEOUT_MS = 10;
+
+/* 加速度计寄存器 */
+constexpr uint8_t ACC_CHIP_ID = 0x00;
+constexpr uint8_t ACC_CHIP_ID_VALUE = 0x1E;
+constexpr uint8_t ACC_DATA = 0x12;          // X_LSB，之后依次为X_MSB、Y、Z
+constexpr uint8_t ACC_TEMP = 0x22;          // TEMP_MSB、TEMP_LSB
+constexpr uint8_t ACC_SOFTRESET = 0x7E;
+
+/* 陀螺仪寄存器 */
+constexpr uint8_t GYRO_CHIP_ID = 0x00;
+constexpr uint8_t GYRO_CHIP_ID_VALUE = 0x0F;
+constexpr uint8_t GYRO_DATA = 0x02;         // RATE_X_LSB，之后依次为X_MSB、Y、Z
+constexpr uint8_t GYRO_SOFTRESET = 0x14;
+constexpr uint8_t SOFTRESET_CMD = 0xB6;
+
+struct RegConfig
+{
+    uint8_t reg;
+    uint8_t value;
+    uint8_t delay_ms;   // 写入后的等待时间
+};
+
+constexpr RegConfig accel_config[] = {
+    {0x7C, 0x00, 1},    // PWR_CONF: 退出暂停模式
+    {0x7D, 0x04, 5},    // PWR_CTRL: 打开加速度计
+    {0x40, 0xAC, 1},    // ACC_CONF: 1600Hz，normal带宽
+    {0x41, 0x01, 1},    // ACC_RANGE: ±6g
+    {0x53, 0x08, 1},    // INT1_IO_CTRL: INT1输出，推挽，低电平有效
+    {0x58, 0x04, 1},    // INT_MAP_DATA: 数据就绪映射到INT1
+};
+
+constexpr RegConfig gyro_config[] = {
+    {0x0F, 0x00, 1},    // GYRO_RANGE: ±2000dps
+    {0x10, 0x80, 1},    // GYRO_BANDWIDTH: 模式0，2000Hz，滤波带宽532Hz(位7只读，读出恒为1)
+    {0x11, 0x00, 1},    // GYRO_LPM1: normal模式
+    {0x15, 0x80, 1},    // GYRO_INT_CTRL: 使能数据就绪中断
+    {0x16, 0x00, 1},    // INT3_INT4_IO_CONF: INT3推挽，低电平有效
+    {0x18, 0x01, 1},    // INT3_INT4_IO_MAP: 数据就绪映射到INT3
+};
+
+constexpr uint16_t GYRO_BURST = 7;      // 地址 + 6字节
+constexpr uint16_t ACCEL_BURST = 8;     // 地址 + 无效字节 + 6字节
+constexpr uint16_t TEMP_BURST = 4;      // 地址 + 无效字节 + 2字节
+
+uint8_t (&gyro_tx)[GYRO_BURST] = bmi088_gyro_tx;
+uint8_t (&gyro_rx)[GYRO_BURST] = bmi088_gyro_rx;
+uint8_t (&accel_tx)[ACCEL_BURST] = bmi088_accel_tx;
+uint8_t (&accel_rx)[ACCEL_BURST] = bmi088_accel_rx;
+uint8_t (&temp_tx)[TEMP_BURST] = bmi088_temp_tx;
+uint8_t (&temp_rx)[TEMP_BURST] = bmi088_temp_rx;
+
+dtm::TopicStorage<ImuData> imu_topic{};
+
+struct Device
+{
+    SPI_Instance gyro{&hspi1, CS1_GYRO_GPIO_Port, CS1_GYRO_Pin};
+    SPI_Instance accel{&hspi1, CS1_ACCEL_GPIO_Port, CS1_ACCEL_Pin};
+    int32_t od_gyro = -1;
+    int32_t od_accel = -1;
+    uint64_t gyro_stamp = 0;    // 本次读取对应的中断时间
+    uint64_t accel_stamp = 0;
+    uint8_t temp_countdown = TEMP_DIVIDER;
+};
+
+Device *dev = nullptr;
+TaskHandle_t gyro_waiter = nullptr;    // 在wait中等待陀螺仪样本的任务
+
+int16_t le16(const uint8_t *p)
+{
+    return static_cast<int16_t>(static_cast<uint16_t>(p[1]) << 8 | p[0]);
+}
+
+/* 写入话题前后各加一次seq，只在SPI DMA中断中调用，不会相互打断 */
+void write_begin(ImuData &d)
+{
+    d.seq++;
+    __DMB();
+}
+
+void write_end(ImuData &d)
+{
+    __DMB();
+    d.seq++;
+}
+
+void gyro_done(void *)
+{
+    PROFILE_SCOPE(imu_gyro);
+    ImuData &d = imu_topic.get();
+    write_begin(d);
+    for (uint8_t i = 0; i < 3; i++)
+        d.gyro[i] = static_cast<float>(le16(&gyro_rx[1 + 2 * i])) * GYRO_SCALE;
+    d.gyro_time = dev->gyro_stamp;
+    d.gyro_count++;
+    write_end(d);
+    OD::update(dev->od_gyro);
+
+    if (gyro_waiter != nullptr) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(gyro_waiter, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+void temp_done(void *)
+{
+    // 11位补码，MSB为高8位，LSB的高3位为低3位，0.125℃/LSB，0对应23℃
+    int16_t t = static_cast<int16_t>(temp_rx[2] << 3 | temp_rx[3] >> 5);
+    if (t > 1023)
+        t = static_cast<int16_t>(t - 2048);
+    ImuData &d = imu_topic.get();
+    write_begin(d);
+    d.temperature = static_cast<float>(t) * 0.125f + 23.0f;
+    d.temp_count++;
+    write_end(d);
+}
+
+void accel_done(void *)
+{
+    PROFILE_SCOPE(imu_accel);
+    ImuData &d = imu_topic.get();
+    write_begin(d);
+    for (uint8_t i = 0; i < 3; i++)
+        d.accel[i] = static_cast<float>(le16(&accel_rx[2 + 2 * i])) * ACCEL_SCALE;
+    d.accel_time = dev->accel_stamp;
+    d.accel_count++;
+    write_end(d);
+    OD::update(dev->od_accel);
+
+    // 温度变化慢，在加速度计读取完成后顺带读取，不另占中断
+    if (--dev->temp_countdown == 0) {
+        dev->temp_countdown = TEMP_DIVIDER;
+        dev->accel.transfer_dma(temp_tx, temp_rx, TEMP_BURST, temp_done, nullptr);
+    }
+}
+
+void gyro_ready(void *)
+{
+    dev->gyro_stamp = DWT_GetCycles();
+    dev->gyro.transfer_dma(gyro_tx, gyro_rx, GYRO_BURST, gyro_done, nullptr);
+}
+
+/* 排队中的温度读取也占用加速度计，此时本次数据就绪被计为overrun */
+void accel_ready(void *)
+{
+    dev->accel_stamp = DWT_GetCycles();
+    dev->accel.transfer_dma(accel_tx, accel_rx, ACCEL_BURST, accel_done, nullptr);
+}
+
+/* 阻塞读写，skip为地址字节后的无效字节数 */
+bool read_reg(const SPI_Instance &spi, const uint8_t reg, uint8_t &value, const uint8_t skip)
+{
+    uint8_t tx[3] = {static_cast<uint8_t>(reg | READ), 0, 0};
+    uint8_t rx[3] = {};
+    if (spi.transfer(tx, rx, static_cast<uint16_t>(2 + skip), SPI_TIMEOUT_MS) != HAL_OK)
+        return false;
+    value = rx[1 + skip];
+    return true;
+}
+
+bool write_reg(const SPI_Instance &spi, const uint8_t reg, const uint8_t value)
+{
+    const uint8_t tx[2] = {reg, value};
+    uint8_t rx[2];
+    return spi.transfer(tx, rx, 2, SPI_TIMEOUT_MS) == HAL_OK;
+}
+
+bool check_id(const SPI_Instance &spi, const char *name, const uint8_t reg, const uint8_t expect, const uint8_t skip)
+{
+    uint8_t id = 0;
+    if (!read_reg(spi, reg, id, skip) || id != expect) {
+        LOG_ERROR("bmi088 %s id 0x%02X, expect 0x%02X", name, id, expect);
+        return false;
+    }
+    return true;
+}
+
+template <size_t N>
+bool configure(const SPI_Instance &spi, const char *name, const RegConfig (&config)[N], const uint8_t skip)
+{
+    for (const auto &c : config) {
+        uint8_t value = 0;
+        if (!write_reg(spi, c.reg, c.value))
+            return false;
+        osDelay(c.delay_ms);
+        if (!read_reg(spi, c.reg, value, skip) || value != c.value) {
+            LOG_ERROR("bmi088 %s reg 0x%02X = 0x%02X, expect 0x%02X", name, c.reg, value, c.value);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool init_accel(const SPI_Instance &spi)
+{
+    uint8_t dummy;
+    read_reg(spi, ACC_CHIP_ID, dummy, 1);   // 切换到SPI模式
+    osDelay(1);
+    if (!check_id(spi, "accel", ACC_CHIP_ID, ACC_CHIP_ID_VALUE, 1))
+        return false;
+
+    write_reg(spi, ACC_SOFTRESET, SOFTRESET_CMD);
+    osDelay(1);
+    read_reg(spi, ACC_CHIP_ID, dummy, 1);   // 复位后回到I2C模式
+    osDelay(1);
+    if (!check_id(spi, "accel", ACC_CHIP_ID, ACC_CHIP_ID_VALUE, 1))
+        return false;
+    return configure(spi, "accel", accel_config, 1);
+}
+
+bool init_gyro(const SPI_Instance &spi)
+{
+    if (!check_id(spi, "gyro", GYRO_CHIP_ID, GYRO_CHIP_ID_VALUE, 0))
+        return false;
+
+    write_reg(spi, GYRO_SOFTRESET, SOFTRESET_CMD);
+    osDelay(30);
+    if (!check_id(spi, "gyro", GYRO_CHIP_ID, GYRO_CHIP_ID_VALUE, 0))
+        return false;
+    return configure(spi, "gyro", gyro_config, 0);
+}
+
+} // namespace
+
+bool init()
+{
+    // SPI_Instance构造时拉高片选，在GPIO初始化之后才能构造
+    static Device device;
+    if (dev != nullptr)
+        return true;
+
+    if (!init_accel(device.accel) || !init_gyro(device.gyro))
+        return false;
+
+    gyro_tx[0] = GYRO_DATA | READ;
+    accel_tx[0] = ACC_DATA | READ;
+    temp_tx[0] = ACC_TEMP | READ;
+
+    device.od_gyro = OD::register_device("od_bmi088_gyro");
+    device.od_accel = OD::register_device("od_bmi088_accel");
+    dtm::Manager::registerTopic("imu", imu_topic);
+    dev = &device;
+
+    // 配置完成后才接管数据就绪中断，此前的中断被忽略
+    exti_register(INT1_GYRO_Pin, gyro_ready, nullptr);
+    exti_register(INT1_ACCEL_Pin, accel_ready, nullptr);
+    LOG_INFO("bmi088 ready, gyro 2000Hz accel 1600Hz");
+    return true;
+}
+
+bool wait(const uint32_t timeout_ms)
+{
+    gyro_waiter = xTaskGetCurrentTaskHandle();
+    return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms)) != 0;
+}
+
+void read(const ImuData &src, ImuData &out)
+{
+    const volatile uint32_t &seq = src.seq;
+    uint32_t before;
+    do {
+        before = seq;
+        __DMB();
+        out = src;
+        __DMB();
+    } while ((before & 1u) != 0 || seq != before);
+}
+
+void read(ImuData &out)
+{
+    read(imu_topic.get(), out);
+}
+
+uint32_t overruns()
+{
+    return dev ? dev->gyro.overruns() + dev->accel.overruns() : 0;
+}
+
+uint32_t errors()
+{
+    return dev ? dev->gyro.errors() + dev->accel.errors() : 0;
+}
+
+} // namespace bmi088
@@ -0,0 +1,69 @@
+/**
+ * @file bmi088.h
+ * @brief BMI088六轴IMU驱动(C板SPI1，加速度计CS1_ACCEL/INT1_ACCEL，陀螺仪CS1_GYRO/INT1_GYRO)
+ * 初始化后由两路数据就绪中断触发SPI1 DMA突发读，不占用任务时间:
+ * 陀螺仪2000Hz、加速度计1600Hz，每16个加速度样本读一次温度。
+ * 时间戳在EXTI中断中取，不含SPI传输与排队的延迟。
+ * 每个陀螺仪样本解码后通知在bmi088::wait中等待的任务，姿态解算以陀螺仪的采样率运行。
+ * 解码结果写入DTM话题"imu"，写入过程由seq保护(写入时为奇数)，读取用bmi088::read
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef BMI088_H
+#define BMI088_H
+
+#include "typedef.h"
+#include "dtm/dtm.h"
+
+namespace bmi088 {
+
+struct ImuData
+{
+    uint32_t seq;           // 写入前后各加1，奇数表示正在写入
+    uint32_t gyro_count;    // 陀螺仪样本数
+    uint32_t accel_count;   // 加速度计样本数
+    uint32_t temp_count;    // 温度读数次数，为0时temperature无效
+    float gyro[3];          // rad/s
+    float accel[3];         // m/s²
+    float temperature;      // ℃
+    uint64_t gyro_time;     // 陀螺仪数据就绪中断时的DWT_GetCycles
+    uint64_t accel_time;    // 加速度计数据就绪中断时的DWT_GetCycles
+};
+
+/* 量程与换算系数，与init写入的寄存器对应 */
+constexpr float GYRO_RANGE_DPS = 2000.0f;
+constexpr float ACCEL_RANGE_G = 6.0f;
+constexpr float GRAVITY = 9.80665f;
+constexpr float GYRO_SCALE = GYRO_RANGE_DPS / 32768.0f * 3.14159265358979f / 180.0f;
+constexpr float ACCEL_SCALE = ACCEL_RANGE_G * GRAVITY / 32768.0f;
+constexpr uint8_t TEMP_DIVIDER = 16;    // 每多少个加速度样本读一次温度
+
+/**
+ * @brief 配置两颗芯片并开始中断驱动的采样，阻塞，调用osDelay，须在任务中调用一次
+ * @return 芯片ID或寄存器回读不符时返回false，并输出错误日志
+ */
+bool init();
+
+/**
+ * @brief 阻塞到下一个陀螺仪样本写入话题"imu"，只能由一个任务调用
+ * 等待期间到来的多个样本只唤醒一次，调用方按gyro_count判断是否漏处理
+ * @return 超时返回false
+ */
+bool wait(uint32_t timeout_ms);
+
+/* 一致地复制src，被写入打断时重试 */
+void read(const ImuData &src, ImuData &out);
+
+/* 一致地读取话题"imu" */
+void read(ImuData &out);
+
+/* 上一次读取还未完成时数据就绪中断再次到来的次数(丢弃的样本数) */
+uint32_t overruns();
+
+/* SPI传输错误次数 */
+uint32_t errors();
+
+} // namespace bmi088
+
+#endif // BMI088_H
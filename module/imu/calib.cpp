@@ -0,0 +1,383 @@
+/**
+ * @file calib.cpp
+ * @brief IMU在线标定实现
+ * feed每个样本做两次3维Welford更新(约40次浮点运算与两次除法)，窗口结束时的判断与合并约为其数十倍，
+ * apply为一次区间查找与插值，都远小于每个陀螺仪样本(2kHz)一次的姿态解算本身的耗时
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "imu/calib.h"
+#include "imu/bmi088.h"
+#include "algorithm/welford.h"
+#include "flash/bsp_flash.h"
+#include "cmd/cmd.h"
+#include "dtm/dtm.h"
+#include "ulog/ulog.h"
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+namespace imu_calib {
+namespace {
+
+constexpr uint16_t RECORD_TAG = 0x1CA1;         // Record的结构改变时须修改，旧记录不再载入
+
+/* 静止判断 */
+constexpr float GYRO_STD_MAX = 0.02f;           // rad/s，BMI088在532Hz带宽下噪声约0.007rad/s
+constexpr float GYRO_MEAN_MAX = 0.05f;          // rad/s，BMI088零偏不超过±1°/s(0.017rad/s)
+constexpr float ACCEL_STD_MAX = 0.2f;           // m/s²
+constexpr float ACCEL_NORM_TOL = 0.5f;          // |a|与g之差 m/s²
+constexpr float GYRO_CONSIST_MAX = 0.01f;       // 与已有效区间零偏之差，超过时认为在缓慢转动 rad/s
+
+/* 零偏区间与加速度计朝向 */
+constexpr uint32_t VALID_COUNT = 2 * WINDOW;    // 至少2个静止窗口
+constexpr uint32_t MAX_COUNT = 120 * WINDOW;    // 约60s的样本，之后按指数遗忘
+constexpr float FACE_RATIO = 0.95f;             // 主轴分量与模长之比，约18°以内
+constexpr float SCALE_TOL = 0.05f;
+constexpr float OFFSET_MAX = 1.0f;              // m/s²
+
+/* 写入Flash */
+constexpr float SAVE_GYRO_DELTA = 0.001f;       // rad/s
+constexpr float SAVE_ACCEL_DELTA = 0.02f;       // m/s²
+constexpr uint32_t SAVE_INTERVAL = 120000;      // 样本数，2kHz下60s
+
+constexpr uint8_t REQ_SAVE = 1u << 0;
+constexpr uint8_t REQ_CLEAR = 1u << 1;
+
+struct Record
+{
+    stats::Welford<3> gyro[TEMP_BINS];  // 各温度区间的陀螺仪均值
+    stats::Welford<3> face[6];          // +x, -x, +y, -y, +z, -z朝向的加速度计均值
+};
+static_assert(std::is_trivially_copyable_v<Record>);
+static_assert(sizeof(Record) <= 0xFFFF);
+static_assert(TEMP_BINS <= 32);
+
+Record cal{};           // 当前标定
+Record saved{};         // 最近一次写入或载入的标定
+stats::Welford<3> win_gyro;     // 本窗口的陀螺仪
+stats::Welford<3> win_accel;    // 本窗口的加速度计
+float temp_sum = 0.0f;
+uint32_t since_save = SAVE_INTERVAL;
+bool full_warned = false;
+std::atomic<uint8_t> requests{0};
+bool (*flash_idle)() = nullptr;
+
+/* 由face导出，只在feed所在任务中更新 */
+float accel_offset[3] = {};
+float accel_scale[3] = {1.0f, 1.0f, 1.0f};
+uint8_t accel_axes = 0;
+
+dtm::TopicStorage<Status> status_topic{};
+
+int8_t bin_of(const float temperature)
+{
+    const float x = (temperature - TEMP_MIN) / TEMP_STEP + 0.5f;
+    if (x < 0.0f || x >= static_cast<float>(TEMP_BINS))
+        return -1;
+    return static_cast<int8_t>(x);
+}
+
+bool bin_valid(const int8_t i)
+{
+    return i >= 0 && i < TEMP_BINS && cal.gyro[i].count() >= VALID_COUNT;
+}
+
+/* 所在区间有效时取其均值，并向温度所在一侧的相邻有效区间线性插值 */
+bool gyro_bias(const float temperature, float *out)
+{
+    const int8_t i = bin_of(temperature);
+    if (!bin_valid(i))
+        return false;
+    const float f = (temperature - TEMP_MIN) / TEMP_STEP - static_cast<float>(i);
+    const int8_t j = static_cast<int8_t>(f >= 0.0f ? i + 1 : i - 1);
+    const float w = bin_valid(j) ? (f >= 0.0f ? f : -f) : 0.0f;
+    for (uint8_t k = 0; k < 3; k++) {
+        const float bi = cal.gyro[i].mean(k);
+        out[k] = bin_valid(j) ? bi + (cal.gyro[j].mean(k) - bi) * w : bi;
+    }
+    return true;
+}
+
+void update_accel()
+{
+    accel_axes = 0;
+    for (uint8_t k = 0; k < 3; k++) {
+        accel_offset[k] = 0.0f;
+        accel_scale[k] = 1.0f;
+        const auto &pos = cal.face[2 * k];
+        const auto &neg = cal.face[2 * k + 1];
+        if (pos.count() < VALID_COUNT || neg.count() < VALID_COUNT)
+            continue;
+        const float span = pos.mean(k) - neg.mean(k);
+        const float offset = 0.5f * (pos.mean(k) + neg.mean(k));
+        const float scale = span > 0.0f ? 2.0f * bmi088::GRAVITY / span : 0.0f;
+        if (scale < 1.0f - SCALE_TOL || scale > 1.0f + SCALE_TOL || offset > OFFSET_MAX || offset < -OFFSET_MAX)
+            continue;
+        accel_offset[k] = offset;
+        accel_scale[k] = scale;
+        accel_axes |= static_cast<uint8_t>(1u << k);
+    }
+}
+
+bool moved(const stats::Welford<3> &now, const stats::Welford<3> &before, const float delta)
+{
+    const bool valid = now.count() >= VALID_COUNT;
+    if (valid != (before.count() >= VALID_COUNT))
+        return true;
+    if (!valid)
+        return false;
+    for (uint8_t k = 0; k < 3; k++) {
+        const float d = now.mean(k) - before.mean(k);
+        if (d > delta || d < -delta)
+            return true;
+    }
+    return false;
+}
+
+/* 与上次保存相比有区间或朝向变为有效，或均值的变化超过阈值 */
+bool changed()
+{
+    for (uint8_t i = 0; i < TEMP_BINS; i++) {
+        if (moved(cal.gyro[i], saved.gyro[i], SAVE_GYRO_DELTA))
+            return true;
+    }
+    for (uint8_t i = 0; i < 6; i++) {
+        if (moved(cal.face[i], saved.face[i], SAVE_ACCEL_DELTA))
+            return true;
+    }
+    return false;
+}
+
+/* 有效区间与加速度计标定结果 */
+void fill_result(Status &s)
+{
+    s.gyro_bins = 0;
+    for (int8_t i = 0; i < TEMP_BINS; i++)
+        s.gyro_bins |= bin_valid(i) ? 1u << i : 0u;
+    for (uint8_t k = 0; k < 3; k++) {
+        s.accel_offset[k] = accel_offset[k];
+        s.accel_scale[k] = accel_scale[k];
+    }
+    s.accel_axes = accel_axes;
+}
+
+/* 写入期间CPU停顿，控制不空闲时不写入 */
+void save(const bool erase_if_full)
+{
+    if (flash_idle == nullptr || !flash_idle())
+        return;
+    Status s = status_topic.get();
+    switch (flash_store::save(RECORD_TAG, &cal, sizeof(cal), erase_if_full)) {
+    case flash_store::Result::OK:
+        saved = cal;
+        since_save = 0;
+        full_warned = false;
+        s.saves++;
+        status_topic.store(s);
+        LOG_INFO("imu calib saved, gyro bins 0x%05lX accel axes 0x%X", static_cast<unsigned long>(s.gyro_bins),
+                 s.accel_axes);
+        break;
+    case flash_store::Result::FULL:
+        if (!full_warned)
+            LOG_WARN("imu calib storage full, \"calib save\" erases it");
+        full_warned = true;
+        break;
+    case flash_store::Result::ERROR:
+        LOG_ERROR("imu calib save failed");
+        break;
+    }
+}
+
+/* 把静止窗口并入零偏区间与加速度计朝向，与所在区间已有的零偏不符时返回false */
+bool learn(const float temperature)
+{
+    const int8_t i = bin_of(temperature);
+    if (bin_valid(i)) {
+        float bias[3];
+        gyro_bias(temperature, bias);
+        for (uint8_t k = 0; k < 3; k++) {
+            const float d = win_gyro.mean(k) - bias[k];
+            if (d > GYRO_CONSIST_MAX || d < -GYRO_CONSIST_MAX)
+                return false;
+        }
+    }
+    if (i >= 0) {
+        cal.gyro[i].merge(win_gyro);
+        cal.gyro[i].limit(MAX_COUNT);
+    }
+
+    // 主轴分量接近模长时按主轴的正负方向归入朝向
+    const float *a = win_accel.mean();
+    uint8_t axis = 0;
+    for (uint8_t k = 1; k < 3; k++)
+        axis = (a[k] > 0.0f ? a[k] : -a[k]) > (a[axis] > 0.0f ? a[axis] : -a[axis]) ? k : axis;
+    const float major = a[axis] > 0.0f ? a[axis] : -a[axis];
+    if (major * major > FACE_RATIO * FACE_RATIO * (a[0] * a[0] + a[1] * a[1] + a[2] * a[2])) {
+        auto &face = cal.face[2 * axis + (a[axis] < 0.0f ? 1 : 0)];
+        face.merge(win_accel);
+        face.limit(MAX_COUNT);
+    }
+    return true;
+}
+
+void end_window()
+{
+    Status s = status_topic.get();
+    const float temperature = temp_sum / static_cast<float>(WINDOW);
+    s.temperature = temperature;
+    s.windows++;
+
+    bool still = true;
+    float norm2 = 0.0f;
+    for (uint8_t k = 0; k < 3; k++) {
+        const float g = win_gyro.mean(k);
+        still = still && win_gyro.variance(k) < GYRO_STD_MAX * GYRO_STD_MAX && g < GYRO_MEAN_MAX &&
+                g > -GYRO_MEAN_MAX && win_accel.variance(k) < ACCEL_STD_MAX * ACCEL_STD_MAX;
+        norm2 += win_accel.mean(k) * win_accel.mean(k);
+    }
+    const float lo = bmi088::GRAVITY - ACCEL_NORM_TOL;
+    const float hi = bmi088::GRAVITY + ACCEL_NORM_TOL;
+    still = still && norm2 > lo * lo && norm2 < hi * hi;
+    s.stationary = still;
+
+    if (still) {
+        s.stationary_windows++;
+        if (learn(temperature))
+            update_accel();
+        else
+            s.rejected++;
+    }
+
+    s.gyro_ready = gyro_bias(temperature, s.gyro_bias);
+    if (!s.gyro_ready)
+        s.gyro_bias[0] = s.gyro_bias[1] = s.gyro_bias[2] = 0.0f;
+    fill_result(s);
+    status_topic.store(s);
+
+    win_gyro.reset();
+    win_accel.reset();
+    temp_sum = 0.0f;
+
+    // 写入时CPU停顿，只在静止且控制空闲时自动写入，被拒绝时在之后的静止窗口重试；不擦除
+    if (still && since_save >= SAVE_INTERVAL && changed())
+        save(false);
+}
+
+/* 输出用整数表示，固件的printf不支持浮点: 零偏单位mdeg/s，偏移单位mm/s²，比例单位ppm */
+long mdps(const float rad_s)
+{
+    return static_cast<long>(rad_s * (180000.0f / 3.14159265f));
+}
+
+void calib_cmd(const char *args)
+{
+    const bool save_req = args != nullptr && strcmp(args, "save") == 0;
+    const bool clear_req = args != nullptr && strcmp(args, "clear") == 0;
+    if ((save_req || clear_req) && (flash_idle == nullptr || !flash_idle())) {
+        log_printf_raw("[CALIB] refused, control active\r\n");
+        return;
+    }
+    if (save_req) {
+        requests.fetch_or(REQ_SAVE);
+        log_printf_raw("[CALIB] save requested\r\n");
+        return;
+    }
+    if (clear_req) {
+        requests.fetch_or(REQ_CLEAR);
+        log_printf_raw("[CALIB] clear requested\r\n");
+        return;
+    }
+
+    Status s;
+    read(s);
+    log_printf_raw("[CALIB] temp %ld ready %u still %u windows %lu/%lu rejected %lu saves %lu free %lu\r\n",
+                   static_cast<long>(s.temperature), s.gyro_ready, s.stationary,
+                   static_cast<unsigned long>(s.stationary_windows), static_cast<unsigned long>(s.windows),
+                   static_cast<unsigned long>(s.rejected), static_cast<unsigned long>(s.saves),
+                   static_cast<unsigned long>(flash_store::free_bytes()));
+    for (uint8_t i = 0; i < TEMP_BINS; i++) {
+        if ((s.gyro_bins >> i & 1u) == 0)
+            continue;
+        // 各区间的均值只在窗口结束时由任务改写，这里逐个float读取，不会读到半个值
+        const auto &b = cal.gyro[i];
+        log_printf_raw("[CALIB] gyro %ldC n %lu bias %ld %ld %ld mdps\r\n",
+                       static_cast<long>(TEMP_MIN + TEMP_STEP * static_cast<float>(i)),
+                       static_cast<unsigned long>(b.count()), mdps(b.mean(0)), mdps(b.mean(1)), mdps(b.mean(2)));
+    }
+    for (uint8_t k = 0; k < 3; k++) {
+        if ((s.accel_axes >> k & 1u) == 0)
+            continue;
+        log_printf_raw("[CALIB] accel %c offset %ld mm/s2 scale %ld ppm\r\n", 'x' + k,
+                       static_cast<long>(s.accel_offset[k] * 1000.0f),
+                       static_cast<long>((s.accel_scale[k] - 1.0f) * 1.0e6f));
+    }
+}
+
+} // namespace
+
+void init(bool (*const idle)())
+{
+    flash_idle = idle;
+    load();
+    dtm::Manager::registerTopic("imu_calib", status_topic);
+    cmd_register("calib", calib_cmd);
+}
+
+bool load()
+{
+    const bool ok = flash_store::load(RECORD_TAG, &cal, sizeof(cal));
+    if (!ok)
+        cal = Record{};
+    saved = cal;
+    update_accel();
+
+    Status s = status_topic.get();
+    fill_result(s);
+    status_topic.store(s);
+    if (ok)
+        LOG_INFO("imu calib loaded, gyro bins 0x%05lX accel axes 0x%X", static_cast<unsigned long>(s.gyro_bins),
+                 accel_axes);
+    return ok;
+}
+
+void feed(const float *gyro, const float *accel, const float temperature)
+{
+    // 命令检查过控制空闲，这里再检查一次，之间开始出力时放弃
+    const uint8_t req = requests.exchange(0);
+    if ((req & (REQ_CLEAR | REQ_SAVE)) && (flash_idle == nullptr || !flash_idle())) {
+        LOG_WARN("imu calib save refused, control active");
+    } else if (req & REQ_CLEAR) {
+        cal = Record{};
+        update_accel();
+        save(true);
+    } else if (req & REQ_SAVE) {
+        save(true);
+    }
+
+    win_gyro.add(gyro);
+    win_accel.add(accel);
+    temp_sum += temperature;
+    since_save++;
+    if (win_gyro.count() >= WINDOW)
+        end_window();
+}
+
+bool apply(const float *gyro, const float *accel, const float temperature, float *gyro_out, float *accel_out)
+{
+    float bias[3] = {};
+    const bool ready = gyro_bias(temperature, bias);
+    for (uint8_t k = 0; k < 3; k++) {
+        gyro_out[k] = gyro[k] - bias[k];
+        accel_out[k] = (accel[k] - accel_offset[k]) * accel_scale[k];
+    }
+    return ready;
+}
+
+void read(Status &out)
+{
+    status_topic.load(out);
+}
+
+} // namespace imu_calib
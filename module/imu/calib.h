@@ -0,0 +1,78 @@
+/**
+ * @file calib.h
+ * @brief BMI088陀螺仪零偏与加速度计的在线标定，结果保存在内部Flash
+ * 每个陀螺仪样本调用一次feed，样本按WINDOW个分成窗口，用Welford算法求均值与方差。
+ * 窗口内陀螺仪与加速度计的波动都很小、角速度接近0且加速度模长接近g时判为静止:
+ *   陀螺仪均值并入窗口平均温度所在的温度区间(10~50℃，每2.5℃一个)，
+ *   每个区间的零偏是该温度下所有静止样本的均值(样本数有上限，旧样本按指数遗忘)；
+ *   加速度计均值按接近哪个轴的正负方向并入6个朝向之一，
+ *   同一轴正反两个朝向都有数据后得到该轴的偏移与比例: a' = (a - offset) * scale。
+ * 零偏按当前温度在相邻区间之间线性插值，所在区间样本不足时无效。
+ * 标定结果有足够变化、处于静止且控制空闲时追加写入Flash(至少间隔SAVE_INTERVAL个样本)，上电时载入，
+ * 当前温度的区间已标定过即可立即使用，不需要开机后静止等待。
+ * 写入Flash时CPU与所有中断停顿(每条记录约2.5ms，扇区写满时擦除约1~2s)，因此只在init传入的flash_idle
+ * 返回true(电机不出力)时写入；自动写入从不擦除，擦除只由控制空闲时的"calib save"/"calib clear"命令触发。
+ * 状态写入DTM话题"imu_calib"；调试命令"calib"输出标定结果，"calib save"立即保存，"calib clear"清除
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef IMU_CALIB_H
+#define IMU_CALIB_H
+
+#include "typedef.h"
+
+namespace imu_calib {
+
+constexpr uint32_t WINDOW = 1000;           // 每个窗口的样本数，陀螺仪2kHz下0.5s
+constexpr float TEMP_MIN = 10.0f;           // 第0个温度区间的中心 ℃
+constexpr float TEMP_STEP = 2.5f;           // ℃
+constexpr uint8_t TEMP_BINS = 17;           // 10~50℃
+
+struct Status
+{
+    float temperature;          // 最近一个窗口的平均温度 ℃
+    float gyro_bias[3];         // 当前温度下的零偏 rad/s，无效时为0
+    float accel_offset[3];      // m/s²
+    float accel_scale[3];
+    uint32_t gyro_bins;         // 零偏有效的温度区间，第i位对应TEMP_MIN + i*TEMP_STEP
+    uint8_t accel_axes;         // 已标定的加速度计轴，第i位对应x/y/z
+    bool gyro_ready;            // 当前温度下零偏有效
+    bool stationary;            // 最近一个窗口静止
+    uint32_t windows;           // 已完成的窗口数
+    uint32_t stationary_windows;
+    uint32_t rejected;          // 静止但与已标定零偏不符的窗口数(缓慢转动)
+    uint32_t saves;             // 本次上电后写入Flash的次数
+};
+
+/**
+ * @brief 从Flash载入标定结果，注册话题"imu_calib"与调试命令"calib"，在任务中调用一次
+ * @param flash_idle 返回是否允许写入Flash(没有控制输出)，每次写入前调用
+ */
+void init(bool (*flash_idle)());
+
+/* 从Flash重新载入，没有有效记录时清空标定，返回是否载入 */
+bool load();
+
+/**
+ * @brief 送入一个样本，只在一个任务中调用
+ * 窗口结束时判断静止并更新标定，满足条件且flash_idle为true时写入Flash(写入期间CPU停顿约2.5ms)
+ * @param gyro        rad/s，未去零偏
+ * @param accel       m/s²，未标定
+ * @param temperature ℃
+ */
+void feed(const float *gyro, const float *accel, float temperature);
+
+/**
+ * @brief 去除零偏并标定加速度计，与feed在同一任务中调用
+ * 零偏无效时陀螺仪原样输出，未标定的轴原样输出
+ * @return 当前温度下零偏有效
+ */
+bool apply(const float *gyro, const float *accel, float temperature, float *gyro_out, float *accel_out);
+
+/* 一致地读取话题"imu_calib" */
+void read(Status &out);
+
+} // namespace imu_calib
+
+#endif // IMU_CALIB_H
@@ -0,0 +1,110 @@
+/**
+ * @file heater.cpp
+ * @brief BMI088恒温控制实现
+ * 每次update只有十几次浮点运算与一次比较寄存器写入，10Hz调用时开销可以忽略
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include "imu/heater.h"
+#include "dtm/dtm.h"
+#include "tim.h"
+#include "ulog/ulog.h"
+
+namespace imu_heater {
+namespace {
+
+constexpr uint32_t CHANNEL = TIM_CHANNEL_1;
+constexpr float OVERHEAT = 65.0f;   // 超过时认为读数或加热失控，关闭加热
+
+Config cfg = default_config;
+float integral = 0.0f;
+float warm_s = 0.0f;                // 本次加热开始后的时间，只用于日志
+bool overheat = false;
+
+dtm::TopicStorage<Status> status_topic{};
+
+void set_duty(const float duty)
+{
+    const uint32_t period = __HAL_TIM_GET_AUTORELOAD(&htim10) + 1;
+    __HAL_TIM_SET_COMPARE(&htim10, CHANNEL, static_cast<uint32_t>(duty * static_cast<float>(period)));
+}
+
+} // namespace
+
+void init(const Config &config)
+{
+    cfg = config;
+    integral = 0.0f;
+    warm_s = 0.0f;
+    Status s{};
+    s.target = cfg.target;
+    status_topic.store(s);
+    dtm::Manager::registerTopic("imu_temp", status_topic);
+    set_duty(0.0f);
+    HAL_TIM_PWM_Start(&htim10, CHANNEL);
+}
+
+void update(const float temperature, const float dt)
+{
+    Status s = status_topic.get();
+    s.temperature = temperature;
+
+    if (temperature > OVERHEAT) {
+        if (!overheat)
+            LOG_ERROR("imu heater off, temperature %ld C", static_cast<long>(temperature));
+        overheat = true;
+        off();
+        return;
+    }
+    overheat = false;
+
+    const float e = cfg.target - temperature;
+    const float p = cfg.kp * e;
+    const float raw = p + integral;
+    if ((raw < cfg.max_duty || e < 0.0f) && (raw > 0.0f || e > 0.0f)) {
+        integral += cfg.ki * e * dt;
+        integral = integral > cfg.max_duty ? cfg.max_duty : (integral < 0.0f ? 0.0f : integral);
+    }
+    float duty = p + integral;
+    duty = duty > cfg.max_duty ? cfg.max_duty : (duty < 0.0f ? 0.0f : duty);
+    set_duty(duty);
+    s.duty = duty;
+
+    warm_s += dt;
+    const float err = e < 0.0f ? -e : e;
+    s.settled_s = err <= cfg.band ? s.settled_s + dt : 0.0f;
+    if (!s.stable && s.settled_s >= cfg.hold_s) {
+        s.stable = true;
+        LOG_INFO("imu heater stable after %lu s, duty %lu%%", static_cast<unsigned long>(warm_s),
+                 static_cast<unsigned long>(duty * 100.0f));
+    } else if (s.stable && err > cfg.drop) {
+        s.stable = false;
+        LOG_WARN("imu heater lost stable, temperature %ld C", static_cast<long>(temperature));
+    }
+    status_topic.store(s);
+}
+
+void off()
+{
+    set_duty(0.0f);
+    integral = 0.0f;
+    warm_s = 0.0f;
+    Status s = status_topic.get();
+    s.duty = 0.0f;
+    s.settled_s = 0.0f;
+    s.stable = false;
+    status_topic.store(s);
+}
+
+bool stable()
+{
+    return status_topic.get().stable;
+}
+
+void read(Status &out)
+{
+    status_topic.load(out);
+}
+
+} // namespace imu_heater
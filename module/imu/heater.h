@@ -0,0 +1,67 @@
+/**
+ * @file heater.h
+ * @brief BMI088恒温控制(C板加热电阻，PF6 TIM10_CH1 PWM，约33.6kHz)
+ * 陀螺仪零偏随温度变化，加热到高于环境的固定温度后零偏才稳定。
+ * 由调用者以低频率(10Hz)传入BMI088的温度读数，PI控制加热占空比；
+ * 温度连续hold_s秒处于target±band内时置"热稳定"，偏离超过drop后清除。
+ * 状态写入DTM话题"imu_temp"，姿态估计按stable决定是否学习零偏
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef IMU_HEATER_H
+#define IMU_HEATER_H
+
+#include "typedef.h"
+
+namespace imu_heater {
+
+struct Status
+{
+    float temperature;  // 最近一次的温度 ℃
+    float target;       // ℃
+    float duty;         // 加热占空比 0~1
+    float settled_s;    // 连续处于target±band内的时间 s
+    bool stable;        // 热稳定
+};
+
+struct Config
+{
+    float target;       // 目标温度 ℃，须高于环境温度
+    float kp;           // 每℃误差的占空比
+    float ki;           // 每℃·s误差的占空比
+    float max_duty;     // 占空比上限，限制加热功率
+    float band;         // 进入稳定的允许误差 ℃
+    float hold_s;       // 在band内保持多久后置稳定 s
+    float drop;         // 稳定后误差超过多少清除稳定 ℃
+};
+
+/*
+ * 按一阶热模型(满占空比温升20~80℃、时间常数20~120s)整定: 积分时间kp/ki=25s，
+ * 从25℃加热到40℃约20~80s进入稳定，超调小于0.3℃，见tools/sim的heater场景
+ */
+constexpr Config default_config = {40.0f, 0.5f, 0.02f, 1.0f, 0.5f, 10.0f, 1.5f};
+
+/* 注册话题"imu_temp"并启动PWM(占空比0)，在任务中调用一次 */
+void init(const Config &config = default_config);
+
+/**
+ * @brief 一次PI控制，只在一个任务中调用
+ * 输出饱和时不再向饱和方向积分(条件积分)，加热阶段积分项不会累积到超调
+ * @param temperature ℃
+ * @param dt          距上次调用的时间 s
+ */
+void update(float temperature, float dt);
+
+/* 关闭加热并清除积分与稳定状态，温度读数不可信(IMU离线)时调用 */
+void off();
+
+/* 热稳定，任何任务中均可调用 */
+bool stable();
+
+/* 一致地读取话题"imu_temp" */
+void read(Status &out);
+
+} // namespace imu_heater
+
+#endif // IMU_HEATER_H
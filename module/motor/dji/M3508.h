@@ -1,32 +1,9 @@
 #ifndef M3508_H
 #define M3508_H
 
-#include "typedef.h"
-#include "can.h"
-#include "can/bsp_can.h"
+#include "motor/dji/dji_motor.h"
 
-class M3508 : public CANInstance
-{
-public:
-    typedef struct
-    {
-        uint16_t ecd;
-        int16_t speed;
-        int16_t current;
-        int16_t temperature;
-        int16_t last_ecd;
-    }m3508_t;
+/* 兼容旧接口: M3508(handler, tx_id, motor_num)与send_cmd(motor1..motor4)不变，测量值见dji::Measure */
+using M3508 = dji::M3508Group;
 
-    M3508(CAN_HandleTypeDef* handler, uint32_t tx_id, uint8_t motor_num);
-    ~M3508();
-
-    void send_cmd(int16_t motor1, int16_t motor2, int16_t motor3, int16_t motor4);
-    void decode(const uint8_t* data, const uint8_t motor);
-private:
-    uint32_t rx_ids[4]{};
-    uint8_t motor_num;
-    m3508_t m3508_measure[4]{};
-    int32_t od_handler[4]{};
-};
-
-#endif // M3508_H
\ No newline at end of file
+#endif // M3508_H
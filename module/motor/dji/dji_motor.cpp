@@ -0,0 +1,48 @@
+/**
+ * @file dji_motor.cpp
+ * @brief DJI电机反馈解码与指令打包，各型号共用
+ * @version 2.0
+ * @date 2026-10-19
+ */
+
+#include "motor/dji/dji_motor.h"
+
+namespace dji {
+
+void decode(const uint8_t *data, Measure &m)
+{
+    const uint16_t ecd = static_cast<uint16_t>(data[0] << 8 | data[1]);
+    const int16_t speed = static_cast<int16_t>(data[2] << 8 | data[3]);
+
+    if (m.valid) {
+        // 差值左移到int16_t的最高位再算术右移回来，即按13位有符号数回绕到[-4096, 4095]
+        m.total_ecd += static_cast<int16_t>((ecd - m.ecd) << (16 - ECD_BITS)) >> (16 - ECD_BITS);
+    } else {
+        m.total_ecd = ecd;
+        m.valid = 1;
+    }
+
+    m.ecd = ecd;
+    m.speed_rpm = speed;
+    m.current = static_cast<int16_t>(data[4] << 8 | data[5]);
+    m.temperature = data[6];
+}
+
+void reset(Measure &m)
+{
+    m.valid = 0;
+    m.total_ecd = 0;
+}
+
+void pack(uint8_t *tx_data, const int16_t *cmd, const uint8_t n, const int16_t limit)
+{
+    for (uint8_t i = 0; i < GROUP_SIZE; i++) {
+        int16_t v = i < n ? cmd[i] : 0;
+        if (v > limit) v = limit;
+        if (v < -limit) v = static_cast<int16_t>(-limit);
+        tx_data[2 * i] = static_cast<uint8_t>(v >> 8);
+        tx_data[2 * i + 1] = static_cast<uint8_t>(v);
+    }
+}
+
+} // namespace dji
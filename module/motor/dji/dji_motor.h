@@ -0,0 +1,245 @@
+/**
+ * @file dji_motor.h
+ * @brief DJI电机驱动(M3508/C620、M2006/C610、GM6020)
+ * 三种电机的反馈报文格式相同，只有减速比、指令范围与ID分配不同，由Traits描述。
+ * 一个MotorGroup对应一个控制报文ID，最多4个电机共用一帧指令；
+ * 反馈解码与指令打包是与电机类型无关的普通函数，各型号共用一份代码。
+ * 测量值直接写入组内的DTM话题存储，不经过按名字的查找。
+ * @version 2.0
+ * @date 2026-10-19
+ */
+
+#ifndef DJI_MOTOR_H
+#define DJI_MOTOR_H
+
+#include "typedef.h"
+#include "can.h"
+#include "can/bsp_can.h"
+#include "dtm/dtm.h"
+#include "online_detect/onl_det.h"
+#include "ulog/ulog.h"
+#include <array>
+#include <cstdio>
+
+namespace dji {
+
+constexpr uint32_t ECD_BITS = 13;
+constexpr int32_t ECD_RANGE = 1 << ECD_BITS;   // 转子一圈8192个编码值
+constexpr uint8_t GROUP_SIZE = 4;              // 一帧指令最多控制的电机数
+
+/* 从编码值与转子转速换算到输出轴的系数，编译期算好，读取时各一次乘法 */
+struct Scale
+{
+    float angle;    // rad / 编码值
+    float speed;    // (rad/s) / rpm
+};
+
+/**
+ * @brief 一个电机的测量值，只保存报文中的原始值与多圈计数
+ * total_ecd为转子多圈累计编码值，保留全部8192分辨率，可表示±262144圈转子。
+ * 输出轴角度与角速度由读者按Scale换算(解码在CAN接收中断中，不做浮点运算)，
+ * 单精度下angle在转子2048圈之外开始损失分辨率，需要精确多圈位置时应使用total_ecd
+ */
+struct Measure
+{
+    uint16_t ecd;           // 转子编码器 0~8191
+    int16_t speed_rpm;      // 转子转速 rpm
+    int16_t current;        // 转矩电流原始值，量程见Traits::current_max
+    uint8_t temperature;    // 电机温度 ℃
+    uint8_t valid;          // 收到过反馈后置1
+    int32_t total_ecd;      // 转子多圈累计编码值
+
+    /* 输出轴角度 rad */
+    [[nodiscard]] float angle(const Scale &s) const { return static_cast<float>(total_ecd) * s.angle; }
+    /* 输出轴角速度 rad/s */
+    [[nodiscard]] float speed(const Scale &s) const { return static_cast<float>(speed_rpm) * s.speed; }
+};
+
+using GroupMeasure = std::array<Measure, GROUP_SIZE>;
+
+constexpr Scale make_scale(const float ratio)
+{
+    constexpr double pi = 3.14159265358979323846;
+    return Scale{
+        static_cast<float>(2.0 * pi / (ECD_RANGE * static_cast<double>(ratio))),
+        static_cast<float>(2.0 * pi / (60.0 * static_cast<double>(ratio))),
+    };
+}
+
+/**
+ * @brief 解码一帧反馈，更新多圈计数
+ * 两帧之间的编码值差按13位有符号数回绕，O(1)，要求相邻两帧转子转动不超过半圈
+ * (1kHz反馈下即转子转速低于30000rpm)
+ */
+void decode(const uint8_t *data, Measure &m);
+
+/* 清除多圈计数，下一帧反馈重新以当前编码值为起点 */
+void reset(Measure &m);
+
+/* 把n个指令限幅到±limit后按大端打包为8字节，不足4个的位置填0 */
+void pack(uint8_t *tx_data, const int16_t *cmd, uint8_t n, int16_t limit);
+
+/*
+ * 各型号参数。ID分配: tx_ids[g]为第g组的控制报文ID，
+ * 第g组第i个电机(从0开始)的反馈ID为rx_first + g * 4 + i，不超过rx_last
+ */
+struct M3508Traits
+{
+    static constexpr const char *name = "m3508";
+    static constexpr float ratio = 3591.0f / 187.0f;
+    static constexpr int16_t cmd_max = 16384;       // 对应±20A
+    static constexpr int16_t current_max = 16384;
+    static constexpr uint32_t tx_ids[2] = {0x200, 0x1FF};
+    static constexpr uint32_t rx_first = 0x201;
+    static constexpr uint32_t rx_last = 0x208;
+};
+
+struct M2006Traits
+{
+    static constexpr const char *name = "m2006";
+    static constexpr float ratio = 36.0f;
+    static constexpr int16_t cmd_max = 10000;       // 对应±10A
+    static constexpr int16_t current_max = 10000;
+    static constexpr uint32_t tx_ids[2] = {0x200, 0x1FF};
+    static constexpr uint32_t rx_first = 0x201;
+    static constexpr uint32_t rx_last = 0x208;
+};
+
+/* 电压控制模式，ID 1~4由0x1FF控制，5~7由0x2FF控制 */
+struct GM6020Traits
+{
+    static constexpr const char *name = "gm6020";
+    static constexpr float ratio = 1.0f;
+    static constexpr int16_t cmd_max = 30000;       // 电压给定
+    static constexpr int16_t current_max = 16384;
+    static constexpr uint32_t tx_ids[2] = {0x1FF, 0x2FF};
+    static constexpr uint32_t rx_first = 0x205;
+    static constexpr uint32_t rx_last = 0x20B;
+};
+
+/**
+ * @brief 共用一个控制报文ID的一组电机
+ * 测量值注册为DTM话题"<name>_<can>_<tx_id>"，如"m3508_1_200"，类型为GroupMeasure，
+ * 其他模块可用dtm::Manager::getPtr<dji::GroupMeasure>取得指针后直接读取，按MotorGroup<Traits>::scale换算。
+ * 话题名存放在对象内，对象应为静态或全局对象
+ */
+template <typename Traits>
+class MotorGroup : public CANInstance
+{
+public:
+    static constexpr Scale scale = make_scale(Traits::ratio);
+
+    /**
+     * @param handler   CAN句柄
+     * @param tx_id     控制报文ID，须为Traits::tx_ids之一
+     * @param motor_num 本组电机数，依次对应该组的第1、2...个电机ID
+     */
+    MotorGroup(CAN_HandleTypeDef *handler, const uint32_t tx_id, const uint8_t motor_num)
+        : CANInstance(handler, tx_id, 0, CAN_ID_STD, 8, CAN_RTR_DATA, nullptr)
+    {
+        uint32_t rx_first = 0;
+        for (uint32_t g = 0; g < std::size(Traits::tx_ids); g++) {
+            if (Traits::tx_ids[g] == tx_id)
+                rx_first = Traits::rx_first + g * GROUP_SIZE;
+        }
+        if (rx_first == 0) {
+            LOG_WARN("%s tx id 0x%lX not found", Traits::name, (unsigned long)tx_id);
+            return;
+        }
+
+        const uint32_t slots = Traits::rx_last + 1 - rx_first;
+        this->motor_num = motor_num > slots ? slots : (motor_num > GROUP_SIZE ? GROUP_SIZE : motor_num);
+        for (uint8_t i = 0; i < this->motor_num; i++) {
+            rx_ids[i] = rx_first + i;
+            cb_register(rx_ids[i], [this, i](uint8_t *data) { this->decode(data, i); });
+        }
+        attach(handler, tx_id);
+    }
+
+    ~MotorGroup()
+    {
+        for (uint8_t i = 0; i < motor_num; i++)
+            cb_unregister(rx_ids[i]);
+    }
+
+    MotorGroup(const MotorGroup &) = delete;
+    MotorGroup &operator=(const MotorGroup &) = delete;
+
+    /* 各电机的指令，超出Traits::cmd_max的部分被限幅 */
+    void send_cmd(const int16_t motor1, const int16_t motor2 = 0, const int16_t motor3 = 0,
+                  const int16_t motor4 = 0)
+    {
+        const int16_t cmd[GROUP_SIZE] = {motor1, motor2, motor3, motor4};
+        send_cmd(cmd, GROUP_SIZE);
+    }
+
+    void send_cmd(const int16_t *cmd, const uint8_t n)
+    {
+        uint8_t tx_data[8];
+        pack(tx_data, cmd, n > GROUP_SIZE ? GROUP_SIZE : n, Traits::cmd_max);
+        send(tx_data);
+    }
+
+    /* 本组每个电机都收到一帧新反馈时调用，在CAN接收中断中执行 */
+    using SyncFunc = void (*)(void *ctx);
+
+    void set_sync(const SyncFunc func, void *ctx)
+    {
+        sync_ctx = ctx;
+        sync = func;
+    }
+
+    void decode(const uint8_t *data, const uint8_t motor)
+    {
+        dji::decode(data, topic.get()[motor]);
+        OD::update(od_handler[motor]);
+
+        fresh |= static_cast<uint8_t>(1u << motor);
+        if (fresh == (1u << motor_num) - 1u) {
+            fresh = 0;
+            if (sync)
+                sync(sync_ctx);
+        }
+    }
+
+    void reset(const uint8_t motor) { dji::reset(topic.get()[motor]); }
+
+    [[nodiscard]] const Measure &measure(const uint8_t motor) const { return topic.get()[motor]; }
+    [[nodiscard]] float angle(const uint8_t motor) const { return topic.get()[motor].angle(scale); }
+    [[nodiscard]] float speed(const uint8_t motor) const { return topic.get()[motor].speed(scale); }
+    [[nodiscard]] const GroupMeasure &measures() const { return topic.get(); }
+    [[nodiscard]] uint8_t size() const { return motor_num; }
+    [[nodiscard]] const char *topic_name() const { return name; }
+
+private:
+    uint32_t rx_ids[GROUP_SIZE]{};
+    int32_t od_handler[GROUP_SIZE]{-1, -1, -1, -1};
+    uint8_t motor_num = 0;
+    uint8_t fresh = 0;      // 自上次同步以来收到过反馈的电机
+    SyncFunc sync = nullptr;
+    void *sync_ctx = nullptr;
+    char name[20]{};
+    dtm::TopicStorage<GroupMeasure> topic{};
+
+    /* 注册OD设备"od_<name>_<can>_<电机ID>"与DTM话题 */
+    void attach(const CAN_HandleTypeDef *handler, const uint32_t tx_id)
+    {
+        const unsigned bus = handler->Instance == CAN2 ? 2 : 1;
+        char od_name[24];
+        for (uint8_t i = 0; i < motor_num; i++) {
+            snprintf(od_name, sizeof(od_name), "od_%s_%u_%lu", Traits::name, bus,
+                     (unsigned long)(rx_ids[i] - Traits::rx_first + 1));
+            od_handler[i] = OD::register_device(od_name);
+        }
+        snprintf(name, sizeof(name), "%s_%u_%lX", Traits::name, bus, (unsigned long)tx_id);
+        dtm::Manager::registerTopic(name, topic);
+    }
+};
+
+using M3508Group = MotorGroup<M3508Traits>;
+using M2006Group = MotorGroup<M2006Traits>;
+using GM6020Group = MotorGroup<GM6020Traits>;
+
+} // namespace dji
+
+#endif // DJI_MOTOR_H
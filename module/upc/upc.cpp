@@ -3,6 +3,7 @@
 #include "algorithm/user_lib.h"
 #include <functional>
 #include "dtm/dtm.h"
+#include "profile/profile.h"
 
 upc::upc(UART_HandleTypeDef *huart)
     : UART_Instance(huart, [this]<typename T0>(T0 && PH1) { decode(std::forward<T0>(PH1)); }),
@@ -24,23 +25,24 @@ void upc::disable()
 
 void upc::send_attitude_handler() const
 {
-    static uint8_t send_data[UPC_TOTAL_LEN] = {0};
-    send_data[0] = UPC_HEADER;
-    send_data[1] = UPC_DATA_LEN;
-    send_data[2] = 0;send_data[3] = 0;
-    send_data[5] = SEND_ATTITUDE & 0xFF;
-    send_data[6] = (SEND_ATTITUDE >> 8) & 0xFF;
+    PROFILE_SCOPE(upc_send_attitude);
+    using AttitudeFrame = upc_frame::Builder<SEND_ATTITUDE, attitude_payload_t, UPC_DATA_LEN>;
+    static_assert(AttitudeFrame::size == UPC_TOTAL_LEN);
+
+    // 上一帧还在排队时跳过本次发送
+    uint8_t* buf = tx_lease();
+    if (buf == nullptr)
+        return;
 
     float temp = 0.0f;
     DTM_GET(test1, temp);
-    pack_float_to_4bytes(temp, &send_data[7]);
-    // pack_float_to_4bytes(tf_ptr->Chassis_angle.yaw_deg, &send_data[7]);
-    // pack_float_to_4bytes(tf_ptr->Small_Gimbal_angle.yaw_deg, &send_data[11]);
-    // pack_float_to_4bytes(tf_ptr->Small_Gimbal_angle.pitch_deg, &send_data[15]);
-
-    Append_CRC8_Check_Sum(send_data, UPC_HEADER_LEN);
-    Append_CRC16_Check_Sum(send_data, UPC_TOTAL_LEN);
-    send(send_data, sizeof(send_data));
+    attitude_payload_t payload{};
+    payload.chassis_yaw = temp;
+    // payload.chassis_yaw = tf_ptr->Chassis_angle.yaw_deg;
+    // payload.small_gimbal_yaw = tf_ptr->Small_Gimbal_angle.yaw_deg;
+    // payload.small_gimbal_pitch = tf_ptr->Small_Gimbal_angle.pitch_deg;
+
+    tx_commit(AttitudeFrame::build(buf, payload));
 }
 
 void upc::decode(uint8_t* data)
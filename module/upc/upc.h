@@ -2,6 +2,7 @@
 #define STANDARD_ROBOT_UPC_H
 #include "uart/bsp_uart.h"
 #include "can/bsp_can.h"
+#include "upc/upc_frame.h"
 
 #define UPC_HEADER 0xA5
 #define UPC_HEADER_LEN 5
@@ -23,6 +24,12 @@ private:
         float x, y, z;
 
     } upc_t;
+    typedef struct __attribute__((packed))
+    {
+        float chassis_yaw;
+        float small_gimbal_yaw;
+        float small_gimbal_pitch;
+    } attitude_payload_t;
     typedef enum
     {
         SEND_ATTITUDE = 0x301,
@@ -0,0 +1,67 @@
+#ifndef STANDARD_ROBOT_UPC_FRAME_H
+#define STANDARD_ROBOT_UPC_FRAME_H
+#include "algorithm/crc.h"
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+/*
+ * upc/裁判系统帧: 0xA5 | data_len | seq(2) | crc8 | cmd_id(2, 小端) | data[data_len] | crc16(小端)
+ * 帧头7字节只取决于命令号与数据长度，在编译期连同CRC8及帧头部分的CRC16状态一起算好；
+ * 运行时只需拷贝帧头，然后将数据结构体复制到发送缓冲区的同时计算CRC16。
+ */
+namespace upc_frame {
+
+constexpr uint8_t HEADER = 0xA5;
+constexpr size_t HEADER_LEN = 5;
+constexpr size_t PREFIX_LEN = HEADER_LEN + 2;
+constexpr size_t OVERHEAD = PREFIX_LEN + 2;
+
+/**
+ * @tparam CmdId   命令号
+ * @tparam Payload 数据段布局，需为可平凡复制的紧凑结构体(字段按小端序)
+ * @tparam DataLen 数据段长度，大于sizeof(Payload)时末尾补0
+ */
+template <uint16_t CmdId, typename Payload, uint8_t DataLen = sizeof(Payload)>
+class Builder {
+    static_assert(std::is_trivially_copyable_v<Payload>, "payload must be trivially copyable");
+    static_assert(sizeof(Payload) <= DataLen, "payload larger than data length");
+
+    static constexpr std::array<uint8_t, PREFIX_LEN> make_prefix()
+    {
+        std::array<uint8_t, PREFIX_LEN> p{HEADER, DataLen, 0, 0, 0,
+                                          static_cast<uint8_t>(CmdId & 0xFFu),
+                                          static_cast<uint8_t>(CmdId >> 8)};
+        p[4] = crc::Crc8::compute(p.data(), HEADER_LEN - 1);
+        return p;
+    }
+
+    static constexpr auto prefix = make_prefix();
+    static constexpr uint16_t prefix_crc = crc::Crc16::compute(prefix.data(), PREFIX_LEN);
+
+public:
+    static constexpr size_t size = OVERHEAD + DataLen;
+
+    /**
+     * @brief 在dst中写出完整的一帧
+     * @param dst 至少size字节，通常为UART_Instance::tx_lease()返回的缓冲区
+     * @return 帧长度
+     */
+    static size_t build(uint8_t *dst, const Payload &payload)
+    {
+        std::memcpy(dst, prefix.data(), PREFIX_LEN);
+        crc::Crc16 crc16(prefix_crc);
+        crc16.update_copy(dst + PREFIX_LEN, &payload, sizeof(Payload));
+        if constexpr (DataLen > sizeof(Payload)) {
+            constexpr size_t pad = DataLen - sizeof(Payload);
+            std::memset(dst + PREFIX_LEN + sizeof(Payload), 0, pad);
+            crc16.update(dst + PREFIX_LEN + sizeof(Payload), pad);
+        }
+        crc16.finalize(dst + PREFIX_LEN + DataLen);
+        return size;
+    }
+};
+
+} // namespace upc_frame
+
+#endif //STANDARD_ROBOT_UPC_FRAME_H
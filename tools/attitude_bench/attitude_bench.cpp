@@ -0,0 +1,296 @@
+/**
+ * @file attitude_bench.cpp
+ * @brief attitude::Mahony/attitude::Ekf上位机精度与速度测试
+ * 输入为IMU记录(CSV，每行 t,gx,gy,gz,ax,ay,az[,qw,qx,qy,qz]，单位s、rad/s、m/s²，
+ * 末尾4列为参考姿态，可省略)，不给文件时使用内置的合成记录:
+ * 60s、1kHz，三轴正弦组合转动，陀螺仪含常值零偏与噪声，加速度计含噪声与若干段0.5g的线加速度，
+ * 两者按BMI088的量程(±2000dps、±6g)量化。
+ * 1. 有参考姿态时给出收敛后(前5s之后)的倾角误差(估计与参考的重力方向夹角)RMS/最大值与偏航误差；
+ *    合成记录另外检查EKF估计的x、y轴零偏。Mahony的比例项在线加速度与重力的合力模长接近g时
+ *    无法区分两者，误差上界比EKF宽得多；
+ * 2. 给出每次update的耗时中位数与最大值(x86使用TSC计数，其他平台按纳秒计)。
+ * 片上对应的测试为"bench att"命令。
+ * 用法: attitude_bench [记录.csv] | attitude_bench --write 输出.csv(导出合成记录)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycle"
+static uint64_t bench_now() { return __rdtsc(); }
+#else
+#define BENCH_UNIT "ns"
+static uint64_t bench_now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+#include "algorithm/attitude.h"
+
+namespace {
+
+constexpr double G = 9.80665;
+constexpr double RATE = 1000.0;
+constexpr double DURATION = 60.0;
+constexpr double SETTLE = 5.0;          // 不计入误差统计的收敛时间 s
+constexpr double BIAS[3] = {0.010, -0.020, 0.015};
+constexpr double GYRO_LSB = 2000.0 / 32768.0 * M_PI / 180.0;
+constexpr double ACCEL_LSB = 6.0 * G / 32768.0;
+constexpr double RAD2DEG = 180.0 / M_PI;
+
+int failures = 0;
+volatile float sink;
+
+void expect(const bool ok, const char *what)
+{
+    std::printf("%-44s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok)
+        failures++;
+}
+
+struct Sample
+{
+    double t;
+    float gyro[3];
+    float accel[3];
+    bool has_ref;
+    double q[4];
+};
+
+void quat_mul(const double *a, const double *b, double *r)
+{
+    r[0] = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+    r[1] = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+    r[2] = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+    r[3] = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+}
+
+/* 机体系中的重力方向(旋转矩阵第三行) */
+void gravity_body(const double *q, double *v)
+{
+    v[0] = 2.0 * (q[1] * q[3] - q[0] * q[2]);
+    v[1] = 2.0 * (q[2] * q[3] + q[0] * q[1]);
+    v[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+}
+
+double yaw_of(const double *q)
+{
+    return std::atan2(2.0 * (q[0] * q[3] + q[1] * q[2]), 1.0 - 2.0 * (q[2] * q[2] + q[3] * q[3]));
+}
+
+float quantize(const double v, const double lsb)
+{
+    const double raw = std::fmax(-32768.0, std::fmin(32767.0, std::round(v / lsb)));
+    return static_cast<float>(raw * lsb);
+}
+
+std::vector<Sample> synthesize()
+{
+    std::mt19937 rng(1);
+    std::normal_distribution<double> gyro_noise(0.0, 0.004), accel_noise(0.0, 0.03);
+    std::vector<Sample> rec;
+    double q[4] = {1.0, 0.0, 0.0, 0.0};
+    constexpr int SUB = 10;     // 参考姿态的积分子步
+    const auto omega = [](const double t, double *w) {
+        w[0] = 1.2 * std::sin(2.0 * M_PI * 0.31 * t) + 0.4 * std::sin(2.0 * M_PI * 2.1 * t);
+        w[1] = 0.9 * std::sin(2.0 * M_PI * 0.23 * t + 1.0) + 0.3 * std::sin(2.0 * M_PI * 1.7 * t);
+        w[2] = 2.0 * std::sin(2.0 * M_PI * 0.11 * t + 0.5);
+    };
+
+    const uint32_t n = static_cast<uint32_t>(DURATION * RATE);
+    for (uint32_t k = 0; k < n; k++) {
+        const double t = k / RATE;
+        Sample s{};
+        s.t = t;
+        double w[3];
+        omega(t, w);
+        for (int i = 0; i < 3; i++)
+            s.gyro[i] = quantize(w[i] + BIAS[i] + gyro_noise(rng), GYRO_LSB);
+
+        // 每10s中有1s叠加0.5g的线加速度
+        double v[3];
+        gravity_body(q, v);
+        const bool burst = std::fmod(t, 10.0) >= 6.0 && std::fmod(t, 10.0) < 7.0;
+        const double lin[3] = {burst ? 0.5 * G : 0.0, burst ? -0.2 * G : 0.0, 0.0};
+        for (int i = 0; i < 3; i++)
+            s.accel[i] = quantize(v[i] * G + lin[i] + accel_noise(rng), ACCEL_LSB);
+
+        s.has_ref = true;
+        std::memcpy(s.q, q, sizeof(q));
+        rec.push_back(s);
+
+        // 在下一个采样前以更小的步长积分真实角速度
+        for (int j = 0; j < SUB; j++) {
+            const double dt = 1.0 / (RATE * SUB);
+            omega(t + (j + 0.5) * dt, w);
+            const double wn = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+            const double half = 0.5 * wn * dt;
+            const double sc = wn > 0.0 ? std::sin(half) / wn : 0.5 * dt;
+            const double dq[4] = {std::cos(half), w[0] * sc, w[1] * sc, w[2] * sc};
+            double r[4];
+            quat_mul(q, dq, r);
+            const double nr = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+            for (int i = 0; i < 4; i++)
+                q[i] = r[i] / nr;
+        }
+    }
+    return rec;
+}
+
+bool load(const char *path, std::vector<Sample> &rec)
+{
+    FILE *f = std::fopen(path, "r");
+    if (f == nullptr)
+        return false;
+    char line[512];
+    while (std::fgets(line, sizeof(line), f)) {
+        Sample s{};
+        double v[11];
+        const int n = std::sscanf(line, "%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf", &v[0], &v[1], &v[2], &v[3],
+                                  &v[4], &v[5], &v[6], &v[7], &v[8], &v[9], &v[10]);
+        if (n < 7)
+            continue;   // 表头或空行
+        s.t = v[0];
+        for (int i = 0; i < 3; i++) {
+            s.gyro[i] = static_cast<float>(v[1 + i]);
+            s.accel[i] = static_cast<float>(v[4 + i]);
+        }
+        s.has_ref = n == 11;
+        for (int i = 0; s.has_ref && i < 4; i++)
+            s.q[i] = v[7 + i];
+        rec.push_back(s);
+    }
+    std::fclose(f);
+    return true;
+}
+
+bool save(const char *path, const std::vector<Sample> &rec)
+{
+    FILE *f = std::fopen(path, "w");
+    if (f == nullptr)
+        return false;
+    std::fprintf(f, "t,gx,gy,gz,ax,ay,az,qw,qx,qy,qz\n");
+    for (const auto &s : rec)
+        std::fprintf(f, "%.6f,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g\n", s.t, s.gyro[0], s.gyro[1],
+                     s.gyro[2], s.accel[0], s.accel[1], s.accel[2], s.q[0], s.q[1], s.q[2], s.q[3]);
+    std::fclose(f);
+    return true;
+}
+
+struct Result
+{
+    double tilt_rms;    // deg
+    double tilt_max;
+    double yaw_max;     // 相对参考的偏航误差，扣除初始偏航 deg
+    float bias[3];
+    std::vector<uint64_t> cost;
+};
+
+template <typename Filter>
+Result run(Filter &filter, const std::vector<Sample> &rec)
+{
+    Result res{};
+    res.cost.reserve(rec.size());
+    filter.reset(rec[0].accel);
+
+    double sum = 0.0, yaw0 = 0.0;
+    uint32_t count = 0;
+    for (size_t k = 0; k < rec.size(); k++) {
+        const Sample &s = rec[k];
+        const float dt = k > 0 ? static_cast<float>(s.t - rec[k - 1].t) : static_cast<float>(1.0 / RATE);
+
+        const uint64_t t0 = bench_now();
+        filter.update(s.gyro, s.accel, dt);
+        res.cost.push_back(bench_now() - t0);
+
+        if (!s.has_ref)
+            continue;
+        const float *qf = filter.quat();
+        const double q[4] = {qf[0], qf[1], qf[2], qf[3]};
+        if (k == 0)
+            yaw0 = yaw_of(q) - yaw_of(s.q);
+        if (s.t - rec[0].t < SETTLE)
+            continue;
+
+        double ve[3], vr[3];
+        gravity_body(q, ve);
+        gravity_body(s.q, vr);
+        const double c = std::fmax(-1.0, std::fmin(1.0, ve[0] * vr[0] + ve[1] * vr[1] + ve[2] * vr[2]));
+        const double tilt = std::acos(c) * RAD2DEG;
+        sum += tilt * tilt;
+        count++;
+        res.tilt_max = std::fmax(res.tilt_max, tilt);
+        const double dy = std::remainder(yaw_of(q) - yaw_of(s.q) - yaw0, 2.0 * M_PI) * RAD2DEG;
+        res.yaw_max = std::fmax(res.yaw_max, std::fabs(dy));
+    }
+    res.tilt_rms = count ? std::sqrt(sum / count) : 0.0;
+    filter.bias(res.bias);
+    sink = filter.quat()[0];
+    return res;
+}
+
+void report(const char *name, Result &r, const bool has_ref)
+{
+    std::sort(r.cost.begin(), r.cost.end());
+    if (has_ref)
+        std::printf("%-8s tilt rms %.3f deg max %.3f deg, yaw max %.2f deg, bias %.4f %.4f %.4f rad/s\n", name,
+                    r.tilt_rms, r.tilt_max, r.yaw_max, r.bias[0], r.bias[1], r.bias[2]);
+    std::printf("%-8s update median %llu " BENCH_UNIT "s, p99 %llu, max %llu (max includes host preemption)\n",
+                name, static_cast<unsigned long long>(r.cost[r.cost.size() / 2]),
+                static_cast<unsigned long long>(r.cost[r.cost.size() * 99 / 100]),
+                static_cast<unsigned long long>(r.cost.back()));
+}
+
+} // namespace
+
+int main(const int argc, char **argv)
+{
+    std::vector<Sample> rec;
+    bool synthetic = false;
+    if (argc > 2 && std::strcmp(argv[1], "--write") == 0) {
+        rec = synthesize();
+        if (!save(argv[2], rec)) {
+            std::fprintf(stderr, "cannot write %s\n", argv[2]);
+            return 2;
+        }
+        return 0;
+    }
+    if (argc > 1) {
+        if (!load(argv[1], rec) || rec.empty()) {
+            std::fprintf(stderr, "cannot read %s\n", argv[1]);
+            return 2;
+        }
+    } else {
+        rec = synthesize();
+        synthetic = true;
+    }
+    const bool has_ref = rec.back().has_ref;
+    std::printf("%zu samples, %.1f s\n", rec.size(), rec.back().t - rec.front().t);
+
+    attitude::Mahony mahony(0.3f, 0.03f);
+    Result rm = run(mahony, rec);
+    report("mahony", rm, has_ref);
+
+    attitude::Ekf ekf;
+    Result re = run(ekf, rec);
+    report("ekf", re, has_ref);
+
+    if (synthetic) {
+        expect(rm.tilt_rms < 3.0, "mahony tilt rms < 3 deg");
+        expect(re.tilt_rms < 0.5, "ekf tilt rms < 0.5 deg");
+        expect(re.tilt_max < 2.0, "ekf tilt max < 2 deg (with 0.5g bursts)");
+        expect(std::fabs(re.bias[0] - BIAS[0]) < 0.002 && std::fabs(re.bias[1] - BIAS[1]) < 0.002,
+               "ekf x/y gyro bias within 0.002 rad/s");
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file filter_bench.cpp
+ * @brief filter::Cascade/filter::Bank上位机参考实现与基准测试
+ * 1. 校验设计结果: Butterworth低通在截止频率处-3dB，陷波器中心处衰减，带阻边界处-3dB；
+ * 2. 以双精度直接II型转置实现为参考，给出单精度实现的最大误差；
+ * 3. 校验Bank与逐通道调用CMSIS-DSP(arm_biquad_cascade_df2T_f32)的输出逐位一致；
+ * 4. 给出每个采样的耗时(x86使用TSC计数，其他平台按纳秒计)。片上对应的测试为"bench biquad"命令。
+ */
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycle"
+static uint64_t bench_now() { return __rdtsc(); }
+#else
+#define BENCH_UNIT "ns"
+static uint64_t bench_now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+#include "algorithm/filter.h"
+
+namespace {
+
+constexpr float FS = 1000.0f;      // 控制周期1kHz
+constexpr uint8_t STAGES = 4;
+constexpr uint8_t CHANNELS = 8;
+constexpr uint32_t SAMPLES = 4096;
+
+volatile float sink;
+int failures = 0;
+
+void expect(const bool ok, const char *what)
+{
+    std::printf("%-44s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok)
+        failures++;
+}
+
+/* 由系数计算频率f处的增益(dB) */
+double gain_db(const float *coeffs, const uint8_t stages, const double fs, const double f)
+{
+    const std::complex<double> z1 = std::polar(1.0, -2.0 * M_PI * f / fs);
+    const std::complex<double> z2 = z1 * z1;
+    std::complex<double> h = 1.0;
+    for (uint8_t s = 0; s < stages; s++) {
+        const float *f = coeffs + 5 * s;
+        const double c[5] = {f[0], f[1], f[2], f[3], f[4]};
+        h *= (c[0] + c[1] * z1 + c[2] * z2) / (1.0 - c[3] * z1 - c[4] * z2);
+    }
+    return 20.0 * std::log10(std::abs(h));
+}
+
+/* 双精度参考实现，系数同样来自单精度设计结果 */
+void reference(const float *coeffs, const uint8_t stages, const float *in, double *out, const uint32_t n)
+{
+    std::vector<double> d(2 * stages, 0.0);
+    for (uint32_t i = 0; i < n; i++) {
+        double x = in[i];
+        for (uint8_t s = 0; s < stages; s++) {
+            const float *c = coeffs + 5 * s;
+            const double y = c[0] * x + d[2 * s];
+            d[2 * s] = c[1] * x + c[3] * y + d[2 * s + 1];
+            d[2 * s + 1] = c[2] * x + c[4] * y;
+            x = y;
+        }
+        out[i] = x;
+    }
+}
+
+template <typename F>
+void design(F &f)
+{
+    f.add_butter_lowpass(FS, 80.0f, 4);
+    f.add_notch(FS, 50.0f, 5.0f);
+    f.add_band_stop(FS, 180.0f, 220.0f);
+}
+
+void check_design()
+{
+    filter::Cascade<STAGES> lp, ntc, bs, lp3;
+    lp.add_butter_lowpass(FS, 80.0f, 4);
+    lp3.add_butter_lowpass(FS, 5.0f, 3);
+    ntc.add_notch(FS, 50.0f, 5.0f);
+    bs.add_band_stop(FS, 180.0f, 220.0f);
+
+    expect(std::fabs(gain_db(lp.coeffs(), lp.stages(), FS, 80.0) + 3.0103) < 0.01, "butter4 -3dB at fc");
+    expect(std::fabs(gain_db(lp.coeffs(), lp.stages(), FS, 1.0)) < 0.01, "butter4 0dB at DC");
+    expect(gain_db(lp.coeffs(), lp.stages(), FS, 320.0) < -40.0, "butter4 < -40dB at 4fc");
+    expect(std::fabs(gain_db(lp3.coeffs(), lp3.stages(), FS, 5.0) + 3.0103) < 0.01, "butter3 -3dB at fc (5Hz)");
+    expect(gain_db(ntc.coeffs(), ntc.stages(), FS, 50.0) < -60.0, "notch < -60dB at f0");
+    expect(std::fabs(gain_db(ntc.coeffs(), ntc.stages(), FS, 50.0 * 1.5)) < 1.0, "notch > -1dB at 1.5 f0");
+    expect(std::fabs(gain_db(bs.coeffs(), bs.stages(), FS, 180.0) + 3.0103) < 0.01, "band_stop -3dB at f_low");
+    expect(std::fabs(gain_db(bs.coeffs(), bs.stages(), FS, 220.0) + 3.0103) < 0.01, "band_stop -3dB at f_high");
+
+    filter::Cascade<2> small;
+    expect(!small.add_butter_lowpass(FS, 80.0f, 6), "reject too many sections");
+    expect(!small.add_notch(FS, 600.0f, 1.0f), "reject f0 above Nyquist");
+    expect(!small.add_band_stop(FS, 220.0f, 180.0f), "reject f_low >= f_high");
+    expect(small.stages() == 0, "rejected designs leave no sections");
+}
+
+void check_accuracy(const std::vector<float> &in)
+{
+    filter::Cascade<STAGES> cascade;
+    design(cascade);
+
+    std::vector<float> out(in.size());
+    std::vector<double> ref(in.size());
+    cascade.process(in.data(), out.data(), in.size());
+    reference(cascade.coeffs(), cascade.stages(), in.data(), ref.data(), in.size());
+
+    double max_err = 0.0, max_ref = 0.0;
+    for (size_t i = 0; i < in.size(); i++) {
+        max_err = std::fmax(max_err, std::fabs(out[i] - ref[i]));
+        max_ref = std::fmax(max_ref, std::fabs(ref[i]));
+    }
+    std::printf("max abs error vs double %.3g (peak %.3g)\n", max_err, max_ref);
+    expect(max_err < 1e-4 * max_ref, "float within 1e-4 of double reference");
+}
+
+void check_bank(const std::vector<float> &in)
+{
+    filter::Bank<STAGES, CHANNELS> bank;
+    design(bank);
+
+    // 各通道输入为同一噪声序列的不同偏移与缩放
+    std::vector<float> frames(SAMPLES * CHANNELS), bank_out(SAMPLES * CHANNELS);
+    for (uint32_t i = 0; i < SAMPLES; i++)
+        for (uint8_t c = 0; c < CHANNELS; c++)
+            frames[i * CHANNELS + c] = in[(i + 97u * c) % in.size()] * (1.0f + c);
+    bank.process(frames.data(), bank_out.data(), SAMPLES);
+
+    uint32_t mismatch = 0;
+    for (uint8_t c = 0; c < CHANNELS; c++) {
+        filter::Cascade<STAGES> cascade;
+        design(cascade);
+        std::vector<float> x(SAMPLES), y(SAMPLES);
+        for (uint32_t i = 0; i < SAMPLES; i++)
+            x[i] = frames[i * CHANNELS + c];
+        cascade.process(x.data(), y.data(), SAMPLES);
+        for (uint32_t i = 0; i < SAMPLES; i++)
+            mismatch += std::memcmp(&y[i], &bank_out[i * CHANNELS + c], sizeof(float)) != 0;
+    }
+    std::printf("bank vs CMSIS-DSP mismatched samples %u / %u\n", mismatch, SAMPLES * CHANNELS);
+    expect(mismatch == 0, "bank bit-exact with arm_biquad_cascade_df2T_f32");
+}
+
+template <typename Fn>
+void bench(const char *name, const uint32_t samples, Fn &&fn)
+{
+    uint64_t best = UINT64_MAX;
+    for (int round = 0; round < 5; round++) {
+        const uint64_t t0 = bench_now();
+        fn();
+        const uint64_t t = bench_now() - t0;
+        if (t < best) best = t;
+    }
+    std::printf("%s,%u,%.2f\n", name, samples, static_cast<double>(best) / samples);
+}
+
+void run_bench(const std::vector<float> &in)
+{
+    std::vector<float> out(SAMPLES * CHANNELS);
+    filter::Cascade<STAGES> cascade;
+    filter::Bank<STAGES, 4> bank4;
+    filter::Bank<STAGES, CHANNELS> bank8;
+    design(cascade);
+    design(bank4);
+    design(bank8);
+
+    std::printf("name,samples," BENCH_UNIT "s_per_sample\n");
+    bench("cascade_block", SAMPLES, [&] {
+        cascade.process(in.data(), out.data(), SAMPLES);
+        sink = out[SAMPLES - 1];
+    });
+    bench("cascade_single", SAMPLES, [&] {
+        for (uint32_t i = 0; i < SAMPLES; i++)
+            out[i] = cascade.process(in[i]);
+        sink = out[SAMPLES - 1];
+    });
+    bench("cascade_per_channel_4", SAMPLES * 4, [&] {
+        for (uint32_t i = 0; i < SAMPLES; i++)
+            for (uint8_t c = 0; c < 4; c++)
+                out[i * 4 + c] = cascade.process(in[i]);
+        sink = out[SAMPLES - 1];
+    });
+    bench("bank_4ch", SAMPLES * 4, [&] {
+        bank4.process(in.data(), out.data(), SAMPLES);
+        sink = out[SAMPLES - 1];
+    });
+    bench("bank_8ch", SAMPLES * CHANNELS, [&] {
+        for (uint32_t i = 0; i < SAMPLES; i++)
+            bank8.process(&in[i % (SAMPLES - CHANNELS)], &out[i * CHANNELS]);
+        sink = out[SAMPLES - 1];
+    });
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(1);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::vector<float> in(SAMPLES * 4);
+    for (size_t i = 0; i < in.size(); i++)
+        in[i] = 100.0f * std::sin(2.0f * static_cast<float>(M_PI) * 3.0f * i / FS) + 20.0f * noise(rng);
+
+    check_design();
+    check_accuracy(in);
+    check_bank(in);
+    if (failures)
+        return 1;
+    run_bench(in);
+    return 0;
+}
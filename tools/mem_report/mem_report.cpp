@@ -0,0 +1,275 @@
+/**
+ * @file mem_report.cpp
+ * @brief 按模块统计固件的Flash/RAM占用
+ * 解析链接器生成的map文件(build/standard_robot.map)，把每个输入段按目标文件所在目录归到模块，
+ * 输出各模块的代码(含只读数据)、已初始化数据、未初始化数据，以及Flash与RAM合计。
+ * 静态库中的成员归到库名下(如libCMSIS_DSP.a、libc_nano.a)；
+ * 输出段中不属于任何输入段的部分(对齐填充、链接脚本预留的堆与栈)单独列出。
+ * 用法: mem_report standard_robot.map [--depth N] [--top N] [--csv]
+ *   --depth N  模块取目录的前N级，默认2(如bsp/ulog、Core/Src)
+ *   --top N    另外列出RAM占用最大的N个输入段
+ *   --csv      以CSV输出
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class Region { NONE, FLASH, RAM, DATA };   // DATA: 运行于RAM、初值存于Flash
+
+struct Usage {
+    uint64_t code = 0;
+    uint64_t data = 0;
+    uint64_t bss = 0;
+
+    [[nodiscard]] uint64_t flash() const { return code + data; }
+    [[nodiscard]] uint64_t ram() const { return data + bss; }
+
+    void add(const Region r, const uint64_t size)
+    {
+        switch (r) {
+            case Region::FLASH: code += size; break;
+            case Region::DATA:  data += size; break;
+            case Region::RAM:   bss += size; break;
+            case Region::NONE:  break;
+        }
+    }
+};
+
+struct Section {
+    std::string name;
+    std::string module;
+    uint64_t size;
+};
+
+bool parse_hex(const std::string &s, uint64_t &v)
+{
+    if (s.size() < 3 || s[0] != '0' || s[1] != 'x')
+        return false;
+    char *end = nullptr;
+    v = std::strtoull(s.c_str() + 2, &end, 16);
+    return *end == '\0';
+}
+
+/*
+ * STM32F4的Flash在0x08000000，SRAM在0x20000000，CCM RAM在0x10000000。
+ * 位于AT> FLASH之后的NOLOAD段在map中也带有load address，按段名识别(.bss、.ccmbss、堆栈预留)
+ */
+Region region_of(const uint64_t vma, const bool has_load, const std::string &name)
+{
+    if (vma >= 0x08000000 && vma < 0x10000000)
+        return Region::FLASH;
+    if ((vma >= 0x20000000 && vma < 0x20100000) || (vma >= 0x10000000 && vma < 0x10010000)) {
+        const bool noload = name.find("bss") != std::string::npos || name.find("heap") != std::string::npos;
+        return has_load && !noload ? Region::DATA : Region::RAM;
+    }
+    return Region::NONE;
+}
+
+/*
+ * CMake目标文件路径如 CMakeFiles/standard_robot.dir/bsp/ulog/ulog.c.obj，
+ * 子目录中的库为 cmake/stm32cubemx/CMakeFiles/STM32_Drivers.dir/__/__/Drivers/...，
+ * 静态库成员为 /path/libfoo.a(bar.o)
+ */
+std::string module_of(const std::string &path, const int depth)
+{
+    const size_t paren = path.find('(');
+    if (paren != std::string::npos && path.back() == ')') {
+        const size_t slash = path.rfind('/', paren);
+        return path.substr(slash == std::string::npos ? 0 : slash + 1, paren - (slash == std::string::npos ? 0 : slash + 1));
+    }
+
+    std::string rel = path;
+    const size_t dir = rel.rfind(".dir/");
+    if (dir != std::string::npos)
+        rel = rel.substr(dir + 5);
+    while (rel.compare(0, 3, "__/") == 0)
+        rel = rel.substr(3);
+
+    std::string module;
+    size_t pos = 0;
+    for (int i = 0; i < depth; i++) {
+        const size_t slash = rel.find('/', pos);
+        if (slash == std::string::npos)
+            break;
+        pos = slash + 1;
+    }
+    module = pos ? rel.substr(0, pos - 1) : rel;
+    return module.empty() ? "(unknown)" : module;
+}
+
+void usage()
+{
+    std::fprintf(stderr, "usage: mem_report <file.map> [--depth N] [--top N] [--csv]\n");
+}
+
+} // namespace
+
+int main(const int argc, char **argv)
+{
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+
+    int depth = 2;
+    size_t top = 0;
+    bool csv = false;
+    for (int i = 2; i < argc; i++) {
+        if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc)
+            depth = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--top") == 0 && i + 1 < argc)
+            top = static_cast<size_t>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--csv") == 0)
+            csv = true;
+        else {
+            usage();
+            return 1;
+        }
+    }
+
+    std::ifstream in(argv[1]);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::map<std::string, Usage> modules;
+    std::vector<Section> ram_sections;
+    Usage total;
+
+    bool in_map = false;
+    std::string out_name;
+    Region out_region = Region::NONE;
+    uint64_t out_size = 0;
+    uint64_t out_inputs = 0;
+    std::string pending;    // 名字过长时输入段名单独占一行，地址等在下一行
+
+    const auto close_output = [&] {
+        if (out_region != Region::NONE && out_size > out_inputs) {
+            const std::string key = "(" + out_name + ")";
+            modules[key].add(out_region, out_size - out_inputs);
+            total.add(out_region, out_size - out_inputs);
+            if (out_region != Region::FLASH)
+                ram_sections.push_back({out_name, key, out_size - out_inputs});
+        }
+        out_region = Region::NONE;
+        out_size = out_inputs = 0;
+    };
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (!in_map) {
+            in_map = line.rfind("Linker script and memory map", 0) == 0;
+            continue;
+        }
+        if (line.empty())
+            continue;
+
+        std::istringstream ss(line);
+        std::vector<std::string> tok;
+        for (std::string t; ss >> t;)
+            tok.push_back(t);
+
+        // 输出段: 行首即为段名
+        if (line[0] == '.') {
+            close_output();
+            pending.clear();
+            out_name = tok[0];
+            uint64_t vma = 0, size = 0;
+            if (tok.size() >= 3 && parse_hex(tok[1], vma) && parse_hex(tok[2], size)) {
+                out_size = size;
+                out_region = region_of(vma, line.find("load address") != std::string::npos, out_name);
+            }
+            continue;
+        }
+        if (out_region == Region::NONE)
+            continue;
+
+        // 输入段: 一个空格缩进，段名可能与地址、大小、文件同行，也可能在上一行
+        std::string name;
+        size_t first = 0;
+        if (line[0] == ' ' && line.size() > 1 && line[1] != ' ' && line[1] != '*') {
+            name = tok[0];
+            first = 1;
+            if (tok.size() == 1) {
+                pending = name;
+                continue;
+            }
+        } else if (!pending.empty()) {
+            name = pending;
+        } else {
+            continue;
+        }
+        pending.clear();
+
+        uint64_t addr = 0, size = 0;
+        if (tok.size() < first + 3 || !parse_hex(tok[first], addr) || !parse_hex(tok[first + 1], size) || size == 0)
+            continue;
+
+        std::string path = tok[first + 2];
+        for (size_t k = first + 3; k < tok.size(); k++)
+            path += " " + tok[k];
+
+        const std::string module = module_of(path, depth);
+        modules[module].add(out_region, size);
+        total.add(out_region, size);
+        out_inputs += size;
+        if (out_region != Region::FLASH)
+            ram_sections.push_back({name, module, size});
+    }
+    close_output();
+
+    if (!in_map) {
+        std::fprintf(stderr, "%s: no memory map found\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<std::pair<std::string, Usage>> rows(modules.begin(), modules.end());
+    std::sort(rows.begin(), rows.end(), [](const auto &a, const auto &b) {
+        return a.second.ram() != b.second.ram() ? a.second.ram() > b.second.ram() : a.second.flash() > b.second.flash();
+    });
+
+    if (csv) {
+        std::printf("module,code,data,bss,flash,ram\n");
+        for (const auto &[name, u] : rows)
+            std::printf("%s,%llu,%llu,%llu,%llu,%llu\n", name.c_str(), (unsigned long long)u.code,
+                        (unsigned long long)u.data, (unsigned long long)u.bss, (unsigned long long)u.flash(),
+                        (unsigned long long)u.ram());
+        std::printf("total,%llu,%llu,%llu,%llu,%llu\n", (unsigned long long)total.code,
+                    (unsigned long long)total.data, (unsigned long long)total.bss,
+                    (unsigned long long)total.flash(), (unsigned long long)total.ram());
+    } else {
+        std::printf("%-40s %9s %9s %9s %9s %9s\n", "module", "code", "data", "bss", "flash", "ram");
+        for (const auto &[name, u] : rows)
+            std::printf("%-40s %9llu %9llu %9llu %9llu %9llu\n", name.c_str(), (unsigned long long)u.code,
+                        (unsigned long long)u.data, (unsigned long long)u.bss, (unsigned long long)u.flash(),
+                        (unsigned long long)u.ram());
+        std::printf("%-40s %9llu %9llu %9llu %9llu %9llu\n", "total", (unsigned long long)total.code,
+                    (unsigned long long)total.data, (unsigned long long)total.bss,
+                    (unsigned long long)total.flash(), (unsigned long long)total.ram());
+    }
+
+    if (top > 0) {
+        std::sort(ram_sections.begin(), ram_sections.end(),
+                  [](const Section &a, const Section &b) { return a.size > b.size; });
+        if (ram_sections.size() > top)
+            ram_sections.resize(top);
+        std::printf(csv ? "\nsection,module,ram\n" : "\n%-48s %-24s %9s\n", "section", "module", "ram");
+        for (const auto &s : ram_sections)
+            std::printf(csv ? "%s,%s,%llu\n" : "%-48s %-24s %9llu\n", s.name.c_str(), s.module.c_str(),
+                        (unsigned long long)s.size);
+    }
+    return 0;
+}
@@ -0,0 +1,24 @@
+/**
+ * @file bench_main.cpp
+ * @brief 在主机上运行固件的微基准测试
+ * 用法: fw_bench [-j] [名称前缀]
+ * 与片上通过USB虚拟串口发送"bench [-j] [名称前缀]"的输出格式相同。
+ * 周期数由主机时钟按168MHz换算，只用于比较用例之间的相对快慢与发现回退，
+ * 绝对值以片上结果为准
+ */
+
+#include "sim_hal.h"
+#include <string>
+
+int main(const int argc, char **argv)
+{
+    std::string line = "bench";
+    for (int i = 1; i < argc; i++) {
+        line += ' ';
+        line += argv[i];
+    }
+
+    sim_init();
+    sim_cmd(line.c_str());
+    return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file fake_bmi088.cpp
+ * @brief 主机仿真中的BMI088
+ */
+
+#include "fake_bmi088.h"
+#include "sim_hal.h"
+#include <cstring>
+
+FakeBmi088::FakeBmi088()
+{
+    reset_accel();
+    reset_gyro();
+}
+
+void FakeBmi088::attach()
+{
+    sim_spi_attach(CS1_ACCEL_GPIO_Port, CS1_ACCEL_Pin, accel_xfer, this);
+    sim_spi_attach(CS1_GYRO_GPIO_Port, CS1_GYRO_Pin, gyro_xfer, this);
+}
+
+/* 数据与温度寄存器保留上一次设置的值(芯片复位后为0直到下一次采样)，不影响驱动 */
+void FakeBmi088::reset_accel()
+{
+    uint8_t data[6], temp[2];
+    std::memcpy(data, &accel_regs_[0x12], sizeof(data));
+    std::memcpy(temp, &accel_regs_[0x22], sizeof(temp));
+    std::memset(accel_regs_, 0, sizeof(accel_regs_));
+    std::memcpy(&accel_regs_[0x12], data, sizeof(data));
+    std::memcpy(&accel_regs_[0x22], temp, sizeof(temp));
+    accel_regs_[0x00] = 0x1E;   // ACC_CHIP_ID
+    accel_regs_[0x40] = 0xA8;   // ACC_CONF
+    accel_regs_[0x41] = 0x01;   // ACC_RANGE
+    accel_regs_[0x7C] = 0x03;   // PWR_CONF
+    accel_spi_mode_ = false;
+}
+
+void FakeBmi088::reset_gyro()
+{
+    uint8_t data[6];
+    std::memcpy(data, &gyro_regs_[0x02], sizeof(data));
+    std::memset(gyro_regs_, 0, sizeof(gyro_regs_));
+    std::memcpy(&gyro_regs_[0x02], data, sizeof(data));
+    gyro_regs_[0x00] = 0x0F;    // GYRO_CHIP_ID
+    gyro_regs_[0x10] = 0x80;    // GYRO_BANDWIDTH
+}
+
+void FakeBmi088::put16(uint8_t *regs, const uint8_t reg, const int16_t value)
+{
+    regs[reg] = static_cast<uint8_t>(value);
+    regs[reg + 1] = static_cast<uint8_t>(static_cast<uint16_t>(value) >> 8);
+}
+
+void FakeBmi088::set_gyro(const int16_t x, const int16_t y, const int16_t z)
+{
+    put16(gyro_regs_, 0x02, x);
+    put16(gyro_regs_, 0x04, y);
+    put16(gyro_regs_, 0x06, z);
+}
+
+void FakeBmi088::set_accel(const int16_t x, const int16_t y, const int16_t z)
+{
+    put16(accel_regs_, 0x12, x);
+    put16(accel_regs_, 0x14, y);
+    put16(accel_regs_, 0x16, z);
+}
+
+void FakeBmi088::set_temperature(const int16_t t11)
+{
+    const auto raw = static_cast<uint16_t>(t11 & 0x7FF);
+    accel_regs_[0x22] = static_cast<uint8_t>(raw >> 3);
+    accel_regs_[0x23] = static_cast<uint8_t>((raw & 0x7) << 5);
+}
+
+void FakeBmi088::accel_xfer(void *ctx, const uint8_t *tx, uint8_t *rx, const uint16_t size)
+{
+    auto *self = static_cast<FakeBmi088 *>(ctx);
+    self->accel_transfers++;
+    self->bytes += size;
+    std::memset(rx, 0xFF, size);
+    if (!self->accel_spi_mode_) {
+        self->accel_spi_mode_ = true;
+        return;
+    }
+    if (size < 2)
+        return;
+
+    const uint8_t reg = tx[0] & 0x7F;
+    if (tx[0] & 0x80) {
+        // 地址字节后先输出一个无效字节
+        for (uint16_t i = 2; i < size; i++)
+            rx[i] = self->accel_regs_[(reg + i - 2) & 0x7F];
+    } else if (reg == 0x7E) {
+        if (tx[1] == 0xB6)
+            self->reset_accel();
+    } else if (reg != 0x00) {
+        self->accel_regs_[reg] = tx[1];
+    }
+}
+
+void FakeBmi088::gyro_xfer(void *ctx, const uint8_t *tx, uint8_t *rx, const uint16_t size)
+{
+    auto *self = static_cast<FakeBmi088 *>(ctx);
+    self->gyro_transfers++;
+    self->bytes += size;
+    std::memset(rx, 0xFF, size);
+    if (size < 2)
+        return;
+
+    const uint8_t reg = tx[0] & 0x7F;
+    if (tx[0] & 0x80) {
+        for (uint16_t i = 1; i < size; i++)
+            rx[i] = self->gyro_regs_[(reg + i - 1) & 0x7F];
+    } else if (reg == 0x14) {
+        if (tx[1] == 0xB6)
+            self->reset_gyro();
+    } else if (reg != 0x00) {
+        self->gyro_regs_[reg] = tx[1];
+    }
+}
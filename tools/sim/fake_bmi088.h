@@ -0,0 +1,47 @@
+/**
+ * @file fake_bmi088.h
+ * @brief 主机仿真中的BMI088，挂在hspi1的两根片选上
+ * 只模拟驱动用到的行为: 芯片ID、寄存器读写与突发读地址自增、软复位、加速度计读时的无效字节、
+ * 加速度计上电与软复位后处于I2C模式(第一次片选周期只切换到SPI模式，不响应读写)
+ */
+
+#ifndef FAKE_BMI088_H
+#define FAKE_BMI088_H
+
+#include <cstdint>
+
+class FakeBmi088
+{
+public:
+    FakeBmi088();
+
+    /* 挂接到CS1_ACCEL与CS1_GYRO */
+    void attach();
+
+    void set_gyro(int16_t x, int16_t y, int16_t z);
+    void set_accel(int16_t x, int16_t y, int16_t z);
+
+    /* 11位补码温度值，0.125℃/LSB，0对应23℃ */
+    void set_temperature(int16_t t11);
+
+    [[nodiscard]] uint8_t accel_reg(const uint8_t reg) const { return accel_regs_[reg & 0x7F]; }
+    [[nodiscard]] uint8_t gyro_reg(const uint8_t reg) const { return gyro_regs_[reg & 0x7F]; }
+
+    uint32_t accel_transfers = 0;   // 片选周期数
+    uint32_t gyro_transfers = 0;
+    uint32_t bytes = 0;             // 总线上传输的字节数
+
+private:
+    uint8_t accel_regs_[128]{};
+    uint8_t gyro_regs_[128]{};
+    bool accel_spi_mode_ = false;
+
+    void reset_accel();
+    void reset_gyro();
+    static void put16(uint8_t *regs, uint8_t reg, int16_t value);
+
+    static void accel_xfer(void *ctx, const uint8_t *tx, uint8_t *rx, uint16_t size);
+    static void gyro_xfer(void *ctx, const uint8_t *tx, uint8_t *rx, uint16_t size);
+};
+
+#endif //FAKE_BMI088_H
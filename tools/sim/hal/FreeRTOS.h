@@ -0,0 +1,39 @@
+/**
+ * @file FreeRTOS.h
+ * @brief 主机仿真用的FreeRTOS替身，只含bsp与app用到的类型与配置，数值与Core/Inc/FreeRTOSConfig.h相同
+ * 任务与调度见tools/sim/sim_rtos.cpp
+ */
+
+#ifndef SIM_FREERTOS_H
+#define SIM_FREERTOS_H
+
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+
+/* 仿真中任务运行在主机线程上，不使用静态分配的TCB与栈 */
+typedef struct
+{
+    uint32_t reserved;
+} StaticTask_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE  ((BaseType_t)1)
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFu)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portYIELD_FROM_ISR(x) ((void)(x))
+
+#define configTICK_RATE_HZ               ((TickType_t)1000)
+#define configMINIMAL_STACK_SIZE         ((uint16_t)128)
+#define configMAX_TASK_NAME_LEN          (16)
+#define configSUPPORT_STATIC_ALLOCATION  1
+#define configSUPPORT_DYNAMIC_ALLOCATION 0
+#define configUSE_SCHED_TRACE            1
+
+#define portGET_RUN_TIME_COUNTER_VALUE() ((uint32_t)DWT->CYCCNT)
+
+#endif //SIM_FREERTOS_H
@@ -0,0 +1,22 @@
+/**
+ * @file can.h
+ * @brief 主机仿真用，替代CubeMX生成的can.h
+ */
+
+#ifndef SIM_CAN_H
+#define SIM_CAN_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern CAN_HandleTypeDef hcan1;
+extern CAN_HandleTypeDef hcan2;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SIM_CAN_H
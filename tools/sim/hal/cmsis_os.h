@@ -0,0 +1,57 @@
+/**
+ * @file cmsis_os.h
+ * @brief 主机仿真用的CMSIS-RTOS替身
+ * 任务运行在各自的主机线程上，同一时刻只有一个在运行(单核)，见tools/sim/sim_rtos.cpp。
+ * 不在任务中调用osDelay时(场景代码)执行后台工作(ulog输出、UART发送完成等)并运行就绪的任务
+ */
+
+#ifndef _CMSIS_OS_H
+#define _CMSIS_OS_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+typedef int osStatus;
+#define osOK 0
+
+typedef enum
+{
+    osPriorityIdle = -3,
+    osPriorityLow = -2,
+    osPriorityBelowNormal = -1,
+    osPriorityNormal = 0,
+    osPriorityAboveNormal = +1,
+    osPriorityHigh = +2,
+    osPriorityRealtime = +3,
+    osPriorityError = 0x84
+} osPriority;
+
+typedef void (*os_pthread)(void const *argument);
+typedef TaskHandle_t osThreadId;
+typedef StaticTask_t osStaticThreadDef_t;
+
+/* 与cmsis_os.h(v1)相同的字段顺序 */
+typedef struct os_thread_def
+{
+    char *name;
+    os_pthread pthread;
+    osPriority tpriority;
+    uint32_t instances;
+    uint32_t stacksize;
+    uint32_t *buffer;
+    osStaticThreadDef_t *controlblock;
+} osThreadDef_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+osThreadId osThreadCreate(const osThreadDef_t *thread_def, void *argument);
+osStatus osDelay(uint32_t millisec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //_CMSIS_OS_H
@@ -0,0 +1,31 @@
+/**
+ * @file main.h
+ * @brief 主机仿真用，替代CubeMX生成的main.h
+ */
+
+#ifndef SIM_MAIN_H
+#define SIM_MAIN_H
+
+#include "stm32f4xx_hal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void Error_Handler(void);
+
+/* 与Core/Inc/main.h相同的引脚定义 */
+#define CS1_ACCEL_Pin GPIO_PIN_4
+#define CS1_ACCEL_GPIO_Port GPIOA
+#define INT1_ACCEL_Pin GPIO_PIN_4
+#define INT1_ACCEL_GPIO_Port GPIOC
+#define INT1_GYRO_Pin GPIO_PIN_5
+#define INT1_GYRO_GPIO_Port GPIOC
+#define CS1_GYRO_Pin GPIO_PIN_0
+#define CS1_GYRO_GPIO_Port GPIOB
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SIM_MAIN_H
@@ -0,0 +1,21 @@
+/**
+ * @file spi.h
+ * @brief 主机仿真用，替代CubeMX生成的spi.h
+ */
+
+#ifndef SIM_SPI_H
+#define SIM_SPI_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern SPI_HandleTypeDef hspi1;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SIM_SPI_H
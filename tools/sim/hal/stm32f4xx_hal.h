@@ -0,0 +1,302 @@
+/**
+ * @file stm32f4xx_hal.h
+ * @brief 主机仿真用的HAL替身
+ * 只提供bsp、module与app用到的类型、寄存器位与函数，外设实例为普通全局变量。
+ * "中断"即仿真线程中直接调用的HAL回调，只在所有任务都阻塞时发生(见sim_rtos.cpp)，关中断只记录状态，
+ * DWT周期计数器由主机单调时钟按SystemCoreClock换算
+ */
+
+#ifndef SIM_STM32F4XX_HAL_H
+#define SIM_STM32F4XX_HAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* 仿真中寄存器是普通内存，不需要volatile */
+#ifndef __IO
+#define __IO
+#endif
+#ifndef __PACKED
+#define __PACKED __attribute__((packed))
+#endif
+#define __weak __attribute__((weak))
+
+#define SET_BIT(REG, BIT)   ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT) ((REG) &= ~(BIT))
+#define READ_BIT(REG, BIT)  ((REG) & (BIT))
+
+typedef enum { HAL_OK = 0x00U, HAL_ERROR = 0x01U, HAL_BUSY = 0x02U, HAL_TIMEOUT = 0x03U } HAL_StatusTypeDef;
+typedef enum { RESET = 0U, SET = !RESET } FlagStatus, ITStatus;
+typedef enum { DISABLE = 0U, ENABLE = !DISABLE } FunctionalState;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint32_t SystemCoreClock;
+
+/* 内核: 中断与任务不会并发运行，PRIMASK只记录状态 */
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+void __disable_irq(void);
+void __enable_irq(void);
+static inline void __DMB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __DSB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+#ifdef __GNUC_PYTHON__
+/* 与CMSIS-DSP的上位机配置一起编译时使用其中的__CLZ，避免重复定义 */
+#include "arm_math_types.h"
+#include "dsp/none.h"
+#else
+static inline uint8_t __CLZ(const uint32_t x) { return x ? (uint8_t)__builtin_clz(x) : 32u; }
+#endif
+
+/* 外设寄存器，只含bsp直接访问的字段 */
+typedef struct
+{
+    uint32_t reserved;
+} CAN_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t SR, DR, BRR, CR1, CR2, CR3, GTPR;
+} USART_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t CR, NDTR, PAR, M0AR, M1AR, FCR;
+} DMA_Stream_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+    uint32_t reserved;
+} SPI_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t ARR, CCR[4], CNT, PSC;
+} TIM_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t CFGR;
+} RCC_TypeDef;
+
+extern CAN_TypeDef sim_CAN1, sim_CAN2;
+extern USART_TypeDef sim_USART1, sim_USART3, sim_USART6;
+extern GPIO_TypeDef sim_GPIOA, sim_GPIOB, sim_GPIOC;
+extern SPI_TypeDef sim_SPI1;
+extern TIM_TypeDef sim_TIM7, sim_TIM10;
+extern RCC_TypeDef sim_RCC;
+#define CAN1   (&sim_CAN1)
+#define CAN2   (&sim_CAN2)
+#define USART1 (&sim_USART1)
+#define USART3 (&sim_USART3)
+#define USART6 (&sim_USART6)
+#define GPIOA  (&sim_GPIOA)
+#define GPIOB  (&sim_GPIOB)
+#define GPIOC  (&sim_GPIOC)
+#define SPI1   (&sim_SPI1)
+#define TIM7   (&sim_TIM7)
+#define TIM10  (&sim_TIM10)
+#define RCC    (&sim_RCC)
+
+#define DMA_SxCR_EN    0x00000001U
+#define DMA_SxCR_DBM   0x00040000U
+#define DMA_SxCR_CT    0x00080000U
+#define DMA_IT_HT      0x00000008U
+#define USART_CR3_DMAR 0x00000040U
+#define UART_FLAG_RXNE 0x00000020U
+#define UART_FLAG_IDLE 0x00000010U
+#define UART_IT_IDLE   0x00000010U
+
+/* RCC: APB1为HCLK/4(42MHz)，与SystemClock_Config相同 */
+#define RCC_CFGR_PPRE1      0x00001C00U
+#define RCC_CFGR_PPRE1_DIV1 0x00000000U
+#define RCC_CFGR_PPRE1_DIV4 0x00001400U
+
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+
+/* CAN */
+#define CAN_ID_STD                  0x00000000U
+#define CAN_ID_EXT                  0x00000004U
+#define CAN_RTR_DATA                0x00000000U
+#define CAN_RTR_REMOTE              0x00000002U
+#define CAN_RX_FIFO0                0x00000000U
+#define CAN_FILTERMODE_IDMASK       0x00000000U
+#define CAN_FILTERSCALE_32BIT       0x00000001U
+#define CAN_IT_RX_FIFO0_MSG_PENDING 0x00000002U
+
+typedef struct
+{
+    uint32_t StdId, ExtId, IDE, RTR, DLC;
+    FunctionalState TransmitGlobalTime;
+} CAN_TxHeaderTypeDef;
+
+typedef struct
+{
+    uint32_t StdId, ExtId, IDE, RTR, DLC, Timestamp, FilterMatchIndex;
+} CAN_RxHeaderTypeDef;
+
+typedef struct
+{
+    uint32_t FilterIdHigh, FilterIdLow, FilterMaskIdHigh, FilterMaskIdLow;
+    uint32_t FilterFIFOAssignment, FilterBank, FilterMode, FilterScale, FilterActivation;
+    uint32_t SlaveStartFilterBank;
+} CAN_FilterTypeDef;
+
+typedef struct
+{
+    CAN_TypeDef *Instance;
+} CAN_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *hcan, const CAN_FilterTypeDef *filter);
+HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan, uint32_t it);
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, const CAN_TxHeaderTypeDef *header,
+                                       const uint8_t data[], uint32_t *mailbox);
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t fifo, CAN_RxHeaderTypeDef *header,
+                                       uint8_t data[]);
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan);
+
+/* DMA与UART */
+typedef struct
+{
+    DMA_Stream_TypeDef *Instance;
+} DMA_HandleTypeDef;
+
+typedef struct
+{
+    USART_TypeDef *Instance;
+    DMA_HandleTypeDef *hdmarx;
+    DMA_HandleTypeDef *hdmatx;
+} UART_HandleTypeDef;
+
+#define __HAL_DMA_ENABLE(h)         ((h)->Instance->CR |= DMA_SxCR_EN)
+#define __HAL_DMA_DISABLE(h)        ((h)->Instance->CR &= ~DMA_SxCR_EN)
+#define __HAL_DMA_DISABLE_IT(h, it) ((h)->Instance->CR &= ~(it))
+#define __HAL_UART_ENABLE_IT(h, it) ((h)->Instance->CR1 |= (it))
+#define __HAL_UART_GET_FLAG(h, f)   (((h)->Instance->SR & (f)) == (f))
+#define __HAL_UART_CLEAR_PEFLAG(h)  ((h)->Instance->SR = 0U)
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size);
+
+/* GPIO */
+#define GPIO_PIN_0 ((uint16_t)0x0001)
+#define GPIO_PIN_4 ((uint16_t)0x0010)
+#define GPIO_PIN_5 ((uint16_t)0x0020)
+
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+void HAL_GPIO_EXTI_Callback(uint16_t pin);
+
+/* SPI: 阻塞传输立即完成，DMA传输在下一次sim_poll时完成并调用传输完成回调 */
+typedef struct
+{
+    SPI_TypeDef *Instance;
+} SPI_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size,
+                                          uint32_t timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
+
+/* TIM: PWM输出的比较值写入寄存器，由场景读取；TIM7的更新中断由sim_run按主机时间产生 */
+#define TIM_CHANNEL_1 0x00000000U
+#define TIM_CHANNEL_2 0x00000004U
+#define TIM_CHANNEL_3 0x00000008U
+#define TIM_CHANNEL_4 0x0000000CU
+
+typedef struct
+{
+    uint32_t Prescaler, Period;
+} TIM_Base_InitTypeDef;
+
+typedef struct
+{
+    TIM_TypeDef *Instance;
+    TIM_Base_InitTypeDef Init;
+} TIM_HandleTypeDef;
+
+#define __HAL_TIM_GET_AUTORELOAD(h)     ((h)->Instance->ARR)
+#define __HAL_TIM_SET_AUTORELOAD(h, v)  ((h)->Instance->ARR = (v), (h)->Init.Period = (v))
+#define __HAL_TIM_SET_COUNTER(h, v)     ((h)->Instance->CNT = (v))
+#define __HAL_TIM_SET_COMPARE(h, ch, v) ((h)->Instance->CCR[(ch) >> 2] = (v))
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t channel);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+
+/* Flash: 参数存储区为内存中的数组，初始为擦除状态，编程只能把1写成0 */
+#define FLASH_TYPEPROGRAM_WORD  0x00000002U
+#define FLASH_TYPEERASE_SECTORS 0x00000000U
+#define FLASH_VOLTAGE_RANGE_3   0x00000002U
+#define FLASH_SECTOR_11         11U
+#define FLASH_FLAG_EOP          0x00000001U
+#define FLASH_FLAG_OPERR        0x00000002U
+#define FLASH_FLAG_WRPERR       0x00000010U
+#define FLASH_FLAG_PGAERR       0x00000020U
+#define FLASH_FLAG_PGPERR       0x00000040U
+#define FLASH_FLAG_PGSERR       0x00000080U
+#define __HAL_FLASH_CLEAR_FLAG(f) ((void)(f))
+
+extern uint8_t sim_flash_storage[];
+#define FLASH_STORAGE_BASE   ((uintptr_t)sim_flash_storage)
+#define FLASH_STORAGE_SIZE   (128u * 1024u)
+#define FLASH_STORAGE_SECTOR FLASH_SECTOR_11
+
+typedef struct
+{
+    uint32_t TypeErase, Banks, Sector, NbSectors, VoltageRange;
+} FLASH_EraseInitTypeDef;
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+/* 地址为主机指针，目标板上uintptr_t即uint32_t */
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t type, uintptr_t address, uint64_t data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *init, uint32_t *sector_error);
+
+#ifdef __cplusplus
+}
+
+/*
+ * DWT: 读CYCCNT得到主机单调时钟换算的周期数，写入时以写入值为新起点。
+ * 只供C++使用(固件中bsp_dwt.c也按C++编译)
+ */
+struct SimCycleCounter
+{
+    operator uint32_t() const;
+    SimCycleCounter &operator=(uint32_t value);
+};
+
+struct SimDWT
+{
+    SimCycleCounter CYCCNT;
+    uint32_t CTRL;
+};
+
+struct SimCoreDebug
+{
+    uint32_t DEMCR;
+};
+
+extern SimDWT sim_DWT;
+extern SimCoreDebug sim_CoreDebug;
+#define DWT       (&sim_DWT)
+#define CoreDebug (&sim_CoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk       0x00000001U
+#define CoreDebug_DEMCR_TRCENA_Msk   0x01000000U
+#endif
+
+#endif //SIM_STM32F4XX_HAL_H
@@ -0,0 +1,22 @@
+/**
+ * @file tim.h
+ * @brief 主机仿真用，替代CubeMX生成的tim.h
+ */
+
+#ifndef SIM_TIM_H
+#define SIM_TIM_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern TIM_HandleTypeDef htim7;
+extern TIM_HandleTypeDef htim10;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SIM_TIM_H
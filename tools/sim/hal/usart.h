@@ -0,0 +1,23 @@
+/**
+ * @file usart.h
+ * @brief 主机仿真用，替代CubeMX生成的usart.h
+ */
+
+#ifndef SIM_USART_H
+#define SIM_USART_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern UART_HandleTypeDef huart1;
+extern UART_HandleTypeDef huart3;
+extern UART_HandleTypeDef huart6;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SIM_USART_H
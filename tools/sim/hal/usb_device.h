@@ -0,0 +1,19 @@
+/**
+ * @file usb_device.h
+ * @brief 主机仿真用，替代CubeMX生成的usb_device.h
+ */
+
+#ifndef SIM_USB_DEVICE_H
+#define SIM_USB_DEVICE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void MX_USB_DEVICE_Init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SIM_USB_DEVICE_H
@@ -0,0 +1,11 @@
+/**
+ * @file usbd_cdc.h
+ * @brief 主机仿真用，USB协议栈不参与仿真
+ */
+
+#ifndef SIM_USBD_CDC_H
+#define SIM_USBD_CDC_H
+
+#include <stdint.h>
+
+#endif //SIM_USBD_CDC_H
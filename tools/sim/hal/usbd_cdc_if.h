@@ -0,0 +1,22 @@
+/**
+ * @file usbd_cdc_if.h
+ * @brief 主机仿真用的USB虚拟串口，输出写到sim_usb_output指定的函数(默认为标准输出)
+ */
+
+#ifndef SIM_USBD_CDC_IF_H
+#define SIM_USBD_CDC_IF_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint16_t CDC_Write_FS(const uint8_t *Buf, uint16_t Len);
+uint16_t CDC_TxSpace_FS(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SIM_USBD_CDC_IF_H
@@ -0,0 +1,456 @@
+/**
+ * @file sim_hal.cpp
+ * @brief 主机仿真的HAL与USB虚拟串口替身，CMSIS-RTOS与TIM7见sim_rtos.cpp
+ * CAN发送的帧进入队列，由sim_can_tx取出；UART的DMA发送在下一次sim_poll时完成并调用发送完成回调；
+ * UART接收只支持ReceiveToIdle方式(不定义USARTx_DOUBLE_BUFFER_ENABLE)，双缓冲方式直接操作DMA寄存器，
+ * 主机上无法由寄存器中的32位地址找回缓冲区。
+ * SPI传输交给片选为低的仿真器件(sim_spi_attach)处理，一次传输即一次完整的片选周期
+ */
+
+#include "sim_hal.h"
+#include "cmsis_os.h"
+#include "usbd_cdc_if.h"
+#include "usb_device.h"
+#include "can/bsp_can.h"
+#include "uart/bsp_uart.h"
+#include "spi.h"
+#include "tim.h"
+#include "dtm/dtm.h"
+#include "dwt/bsp_dwt.h"
+#include "online_detect/onl_det.h"
+#include "cmd/cmd.h"
+#include "profile/profile.h"
+#include "bench/bench.h"
+#include "pool/pool.h"
+#include "trace/trace.h"
+#include "tick/tick.h"
+#include "ulog/ulog.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+uint32_t SystemCoreClock = 168000000u;
+
+CAN_TypeDef sim_CAN1, sim_CAN2;
+USART_TypeDef sim_USART1, sim_USART3, sim_USART6;
+GPIO_TypeDef sim_GPIOA, sim_GPIOB, sim_GPIOC;
+SPI_TypeDef sim_SPI1;
+TIM_TypeDef sim_TIM7{41999, {}, 0, 1};     // 与MX_TIM7_Init、MX_TIM10_Init的Prescaler、Period相同
+TIM_TypeDef sim_TIM10{4999, {}, 0, 0};
+RCC_TypeDef sim_RCC{RCC_CFGR_PPRE1_DIV4};
+alignas(4) uint8_t sim_flash_storage[FLASH_STORAGE_SIZE];
+extern "C" uint8_t __start_sim_dma_buffer[], __stop_sim_dma_buffer[];
+SimDWT sim_DWT;
+SimCoreDebug sim_CoreDebug;
+
+namespace {
+DMA_Stream_TypeDef dma_usart1_rx, dma_usart3_rx, dma_usart6_rx;
+} // namespace
+
+DMA_HandleTypeDef hdma_usart1_rx{&dma_usart1_rx};
+DMA_HandleTypeDef hdma_usart3_rx{&dma_usart3_rx};
+DMA_HandleTypeDef hdma_usart6_rx{&dma_usart6_rx};
+CAN_HandleTypeDef hcan1{CAN1};
+CAN_HandleTypeDef hcan2{CAN2};
+UART_HandleTypeDef huart1{USART1, &hdma_usart1_rx, nullptr};
+UART_HandleTypeDef huart3{USART3, &hdma_usart3_rx, nullptr};
+UART_HandleTypeDef huart6{USART6, &hdma_usart6_rx, nullptr};
+SPI_HandleTypeDef hspi1{SPI1};
+TIM_HandleTypeDef htim7{TIM7, {1, 41999}};
+TIM_HandleTypeDef htim10{TIM10, {0, 4999}};
+
+namespace {
+
+constexpr size_t CAN_TX_MAX = 4096;     // 无人取出时只保留最近的帧
+constexpr uint32_t SIM_CMD_US = 20000;  // 足够CommTask取到命令、UlogTask发完输出
+
+uint32_t primask = 0;
+int isr_depth = 0;
+
+const auto cycle_epoch = std::chrono::steady_clock::now();
+uint32_t cycle_offset = 0;
+
+uint32_t host_cycles()
+{
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - cycle_epoch);
+    return static_cast<uint32_t>(static_cast<uint64_t>(ns.count()) * (SystemCoreClock / 1000000u) / 1000u);
+}
+
+struct IsrScope
+{
+    IsrScope() { isr_depth++; }
+    ~IsrScope() { isr_depth--; }
+};
+
+std::deque<sim_can_frame_t> can_tx;
+CAN_RxHeaderTypeDef can_rx_header;
+uint8_t can_rx_data[8];
+
+struct UartSim
+{
+    UART_HandleTypeDef *huart;
+    uint8_t *rx_buf;
+    uint16_t rx_size;
+    const uint8_t *tx_data;     // 正在"DMA发送"的数据，下一次sim_poll时完成
+    uint16_t tx_len;
+    std::vector<uint8_t> tx_done;
+};
+
+UartSim uarts[] = {{&huart1, nullptr, 0, nullptr, 0, {}},
+                   {&huart3, nullptr, 0, nullptr, 0, {}},
+                   {&huart6, nullptr, 0, nullptr, 0, {}}};
+
+UartSim *uart_of(const UART_HandleTypeDef *huart)
+{
+    for (auto &u : uarts) {
+        if (u.huart->Instance == huart->Instance)
+            return &u;
+    }
+    return nullptr;
+}
+
+void stdout_output(const uint8_t *data, const uint32_t len)
+{
+    std::fwrite(data, 1, len, stdout);
+}
+
+sim_output_t usb_output = stdout_output;
+
+struct SpiDevice
+{
+    GPIO_TypeDef *cs_port;
+    uint16_t cs_pin;
+    sim_spi_xfer_t xfer;
+    void *ctx;
+};
+
+std::vector<SpiDevice> spi_devices;
+
+struct SpiDma
+{
+    SPI_HandleTypeDef *hspi;
+    const uint8_t *tx;
+    uint8_t *rx;
+    uint16_t size;
+};
+
+SpiDma spi_dma{};       // 正在"DMA传输"，下一次sim_poll时完成
+
+/* 片选为低的器件，没有或多于一个时返回nullptr */
+const SpiDevice *spi_selected()
+{
+    const SpiDevice *selected = nullptr;
+    for (const auto &d : spi_devices) {
+        if ((d.cs_port->ODR & d.cs_pin) != 0)
+            continue;
+        if (selected != nullptr) {
+            std::fprintf(stderr, "spi: more than one chip select low\n");
+            return nullptr;
+        }
+        selected = &d;
+    }
+    return selected;
+}
+
+bool spi_exchange(const uint8_t *tx, uint8_t *rx, const uint16_t size)
+{
+    const SpiDevice *d = spi_selected();
+    if (d == nullptr)
+        return false;
+    d->xfer(d->ctx, tx, rx, size);
+    return true;
+}
+
+} // namespace
+
+SimCycleCounter::operator uint32_t() const
+{
+    return host_cycles() + cycle_offset;
+}
+
+SimCycleCounter &SimCycleCounter::operator=(const uint32_t value)
+{
+    cycle_offset = value - host_cycles();
+    return *this;
+}
+
+extern "C"
+{
+
+void Error_Handler(void)
+{
+    std::fprintf(stderr, "Error_Handler\n");
+    std::abort();
+}
+
+uint32_t __get_PRIMASK(void) { return primask; }
+void __set_PRIMASK(const uint32_t value) { primask = value; }
+void __disable_irq(void) { primask = 1; }
+void __enable_irq(void) { primask = 0; }
+
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *, const CAN_FilterTypeDef *) { return HAL_OK; }
+HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *) { return HAL_OK; }
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *, uint32_t) { return HAL_OK; }
+
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, const CAN_TxHeaderTypeDef *header,
+                                       const uint8_t data[], uint32_t *mailbox)
+{
+    sim_can_frame_t f{};
+    f.instance = hcan->Instance;
+    f.id = header->IDE == CAN_ID_STD ? header->StdId : header->ExtId;
+    f.dlc = static_cast<uint8_t>(header->DLC > 8 ? 8 : header->DLC);
+    std::memcpy(f.data, data, f.dlc);
+    if (can_tx.size() >= CAN_TX_MAX)
+        can_tx.pop_front();
+    can_tx.push_back(f);
+    *mailbox = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *, uint32_t, CAN_RxHeaderTypeDef *header, uint8_t data[])
+{
+    *header = can_rx_header;
+    std::memcpy(data, can_rx_data, sizeof(can_rx_data));
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *data, const uint16_t size)
+{
+    UartSim *u = uart_of(huart);
+    if (u == nullptr || u->tx_data != nullptr)
+        return HAL_BUSY;
+    u->tx_data = data;
+    u->tx_len = size;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *data, const uint16_t size)
+{
+    UartSim *u = uart_of(huart);
+    if (u == nullptr)
+        return HAL_ERROR;
+    u->rx_buf = data;
+    u->rx_size = size;
+    return HAL_OK;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, const uint16_t pin, const GPIO_PinState state)
+{
+    if (state == GPIO_PIN_SET)
+        port->ODR |= pin;
+    else
+        port->ODR &= ~static_cast<uint32_t>(pin);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, const uint16_t size,
+                                          uint32_t)
+{
+    if (spi_dma.hspi == hspi)
+        return HAL_BUSY;
+    return spi_exchange(tx, rx, size) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, const uint16_t size)
+{
+    if (spi_dma.hspi != nullptr)
+        return HAL_BUSY;
+    spi_dma = SpiDma{hspi, tx, rx, size};
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *, uint32_t) { return HAL_OK; }
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void) { return HAL_OK; }
+HAL_StatusTypeDef HAL_FLASH_Lock(void) { return HAL_OK; }
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t, const uintptr_t address, const uint64_t data)
+{
+    const uintptr_t base = FLASH_STORAGE_BASE;
+    if (address < base || address + 4 > base + FLASH_STORAGE_SIZE || address % 4 != 0)
+        return HAL_ERROR;
+    uint32_t word;
+    std::memcpy(&word, reinterpret_cast<const void *>(address), 4);
+    word &= static_cast<uint32_t>(data);
+    std::memcpy(reinterpret_cast<void *>(address), &word, 4);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *init, uint32_t *sector_error)
+{
+    if (init->Sector != FLASH_STORAGE_SECTOR || init->NbSectors != 1) {
+        *sector_error = init->Sector;
+        return HAL_ERROR;
+    }
+    std::memset(sim_flash_storage, 0xFF, sizeof(sim_flash_storage));
+    *sector_error = 0xFFFFFFFFu;
+    return HAL_OK;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void) { return SystemCoreClock / 4u; }
+
+BaseType_t xPortIsInsideInterrupt(void) { return isr_depth > 0; }
+
+uint16_t CDC_TxSpace_FS(void) { return 2048; }
+
+uint16_t CDC_Write_FS(const uint8_t *Buf, const uint16_t Len)
+{
+    if (Len > 0)
+        usb_output(Buf, Len);
+    return Len;
+}
+
+void MX_USB_DEVICE_Init(void) {}
+
+void sim_init(void)
+{
+    std::memset(sim_flash_storage, 0xFF, sizeof(sim_flash_storage));
+    // 目标板启动代码清零.bss，DMA_BUFFER的初值不起作用
+    std::memset(__start_sim_dma_buffer, 0, static_cast<size_t>(__stop_sim_dma_buffer - __start_sim_dma_buffer));
+    DWT_Init(SystemCoreClock / 1000000);
+    dtm::Manager::init();
+    OD::init(DWT_GetTime_us);
+    profile_init();
+    trace_init();
+    bench_init();
+    tick_init();
+    pool_init();
+
+    can_filter_init(&hcan1);
+    can_filter_init(&hcan2);
+    uart_init(&huart1, 0);
+    uart_init(&huart3, 0);
+    uart_init(&huart6, 0);
+}
+
+void sim_poll(void)
+{
+    DWT_CNT_Update();
+
+    for (auto &u : uarts) {
+        if (u.tx_data == nullptr)
+            continue;
+        u.tx_done.insert(u.tx_done.end(), u.tx_data, u.tx_data + u.tx_len);
+        u.tx_data = nullptr;
+        const IsrScope isr;
+        HAL_UART_TxCpltCallback(u.huart);
+    }
+
+    // 完成回调中可能开始下一次传输，直到总线空闲
+    while (spi_dma.hspi != nullptr) {
+        const SpiDma dma = spi_dma;
+        const bool ok = spi_exchange(dma.tx, dma.rx, dma.size);
+        spi_dma = SpiDma{};
+        const IsrScope isr;
+        if (ok)
+            HAL_SPI_TxRxCpltCallback(dma.hspi);
+        else
+            HAL_SPI_ErrorCallback(dma.hspi);
+    }
+
+    // 创建任务后日志由UlogTask输出
+    if (!sim_rtos_started()) {
+        while (ulog_poll() > 0) {
+        }
+    }
+    std::fflush(stdout);
+}
+
+void sim_can_inject(CAN_HandleTypeDef *hcan, const uint32_t id, const uint8_t *data, const uint8_t dlc)
+{
+    can_rx_header = CAN_RxHeaderTypeDef{};
+    can_rx_header.IDE = id > 0x7FFu ? CAN_ID_EXT : CAN_ID_STD;
+    can_rx_header.StdId = id > 0x7FFu ? 0 : id;
+    can_rx_header.ExtId = id > 0x7FFu ? id : 0;
+    can_rx_header.DLC = dlc > 8 ? 8 : dlc;
+    std::memset(can_rx_data, 0, sizeof(can_rx_data));
+    std::memcpy(can_rx_data, data, can_rx_header.DLC);
+
+    const IsrScope isr;
+    HAL_CAN_RxFifo0MsgPendingCallback(hcan);
+}
+
+uint32_t sim_can_tx(sim_can_frame_t *out, const uint32_t max)
+{
+    uint32_t n = 0;
+    while (n < max && !can_tx.empty()) {
+        out[n++] = can_tx.front();
+        can_tx.pop_front();
+    }
+    return n;
+}
+
+void sim_uart_inject(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t len)
+{
+    UartSim *u = uart_of(huart);
+    if (u == nullptr)
+        return;
+
+    // 接收回调重新启动接收前DMA停止，未被接收的数据丢失，与目标板相同
+    while (len > 0 && u->rx_buf != nullptr) {
+        const uint16_t n = len < u->rx_size ? len : u->rx_size;
+        std::memcpy(u->rx_buf, data, n);
+        u->rx_buf = nullptr;
+        data += n;
+        len -= n;
+
+        const IsrScope isr;
+        HAL_UARTEx_RxEventCallback(huart, n);
+    }
+}
+
+uint32_t sim_uart_tx(UART_HandleTypeDef *huart, uint8_t *out, const uint32_t max)
+{
+    UartSim *u = uart_of(huart);
+    if (u == nullptr)
+        return 0;
+    const uint32_t n = u->tx_done.size() < max ? static_cast<uint32_t>(u->tx_done.size()) : max;
+    std::memcpy(out, u->tx_done.data(), n);
+    u->tx_done.erase(u->tx_done.begin(), u->tx_done.begin() + n);
+    return n;
+}
+
+void sim_spi_attach(GPIO_TypeDef *cs_port, const uint16_t cs_pin, const sim_spi_xfer_t xfer, void *ctx)
+{
+    spi_devices.push_back(SpiDevice{cs_port, cs_pin, xfer, ctx});
+}
+
+void sim_exti(const uint16_t pin)
+{
+    const IsrScope isr;
+    HAL_GPIO_EXTI_Callback(pin);
+}
+
+void sim_irq(void (*isr)(void *), void *ctx)
+{
+    const IsrScope scope;
+    isr(ctx);
+}
+
+void sim_usb_output(const sim_output_t output)
+{
+    usb_output = output ? output : stdout_output;
+}
+
+void sim_cmd(const char *line)
+{
+    if (!sim_rtos_started()) {
+        cmd_receive(reinterpret_cast<const uint8_t *>(line), static_cast<uint32_t>(std::strlen(line)));
+        cmd_receive(reinterpret_cast<const uint8_t *>("\n"), 1);
+        cmd_poll();
+        sim_poll();
+        return;
+    }
+
+    // 与USB接收中断相同，命令由CommTask(5ms周期)执行，输出由UlogTask发送
+    sim_irq([](void *ctx) {
+        const auto *s = static_cast<const char *>(ctx);
+        cmd_receive(reinterpret_cast<const uint8_t *>(s), static_cast<uint32_t>(std::strlen(s)));
+        cmd_receive(reinterpret_cast<const uint8_t *>("\n"), 1);
+    }, const_cast<char *>(line));
+    sim_run(SIM_CMD_US, nullptr, nullptr);
+}
+
+}
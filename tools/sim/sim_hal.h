@@ -0,0 +1,88 @@
+/**
+ * @file sim_hal.h
+ * @brief 主机仿真的外部接口: 注入CAN帧与串口数据、取出发送的数据、执行后台工作、运行app任务
+ * 注入函数在调用者线程中直接调用HAL的接收回调，与目标板上中断的调用路径相同。
+ * 创建任务(task_init)后，注入与后台工作只能在仿真线程(main)中、且没有任务在运行时调用，
+ * 由sim_run的step或sim_irq进行
+ */
+
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+#include "main.h"
+#include "can.h"
+#include "usart.h"
+#include "spi.h"
+#include "tim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    const CAN_TypeDef *instance;
+    uint32_t id;
+    uint8_t dlc;
+    uint8_t data[8];
+} sim_can_frame_t;
+
+typedef void (*sim_output_t)(const uint8_t *data, uint32_t len);
+
+/* sim_run每步的时长，即仿真中断的最小间隔 */
+#define SIM_STEP_US 250u
+
+/* sim_run每步在"中断"中调用一次，now_us为仿真时间(各次sim_run累计) */
+typedef void (*sim_step_t)(void *ctx, uint64_t now_us);
+
+/* 仿真SPI器件处理一次完整的片选周期: 收到tx的size字节，同时输出rx */
+typedef void (*sim_spi_xfer_t)(void *ctx, const uint8_t *tx, uint8_t *rx, uint16_t size);
+
+/* 初始化DWT、DTM、OD、调试命令与CAN/UART接收，相当于固件的bsp_init */
+void sim_init(void);
+
+/* 后台工作: 扩展DWT计数、完成已开始的UART发送与SPI DMA传输、输出日志，相当于定时器中断与UlogTask */
+void sim_poll(void);
+
+/* 作为一帧收到的CAN报文，在"中断"中解码 */
+void sim_can_inject(CAN_HandleTypeDef *hcan, uint32_t id, const uint8_t *data, uint8_t dlc);
+
+/* 取出最多max个已发送的CAN帧，按发送顺序，返回取出的数量 */
+uint32_t sim_can_tx(sim_can_frame_t *out, uint32_t max);
+
+/* 作为一次空闲中断收到的数据(超出接收缓冲区时分多次)，在"中断"中解码 */
+void sim_uart_inject(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t len);
+
+/* 取出最多max字节已由DMA发送完成的数据 */
+uint32_t sim_uart_tx(UART_HandleTypeDef *huart, uint8_t *out, uint32_t max);
+
+/* 在片选引脚(cs_port, cs_pin)上挂接一个仿真SPI器件 */
+void sim_spi_attach(GPIO_TypeDef *cs_port, uint16_t cs_pin, sim_spi_xfer_t xfer, void *ctx);
+
+/* 作为引脚pin上的一次EXTI中断，调用HAL_GPIO_EXTI_Callback */
+void sim_exti(uint16_t pin);
+
+/* USB虚拟串口(日志与命令输出)的去向，默认写到标准输出 */
+void sim_usb_output(sim_output_t output);
+
+/* 在"中断"中调用isr(ctx) */
+void sim_irq(void (*isr)(void *ctx), void *ctx);
+
+/* 作为USB虚拟串口收到的一行命令执行；已创建任务时由CommTask执行，其间sim_run沿用上一次的step */
+void sim_cmd(const char *line);
+
+/*
+ * 按主机时间运行duration_us，每SIM_STEP_US: 调用step(注入传感器中断等)、执行后台工作、
+ * 产生到期的TIM7更新中断与FreeRTOS节拍，然后运行就绪的任务直到全部阻塞。
+ * step为NULL时沿用上一次的step。见sim_rtos.cpp
+ */
+void sim_run(uint32_t duration_us, sim_step_t step, void *ctx);
+
+/* 已创建任务时为1: 日志由UlogTask输出，调试命令由CommTask执行 */
+uint8_t sim_rtos_started(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SIM_HAL_H
@@ -0,0 +1,560 @@
+/**
+ * @file sim_main.cpp
+ * @brief 在主机上运行bsp、module驱动与app任务的仿真场景
+ * 用法:
+ *   sim_robot can             注入M3508反馈(含编码器回绕)，检查解码结果与指令帧
+ *   sim_robot upc             注入上位机射击命令帧，检查转发的CAN帧与回传的姿态帧
+ *   sim_robot imu             初始化仿真BMI088，触发数据就绪中断，检查解码结果、排队与overrun计数
+ *   sim_robot heater          用一阶热模型闭环运行IMU恒温控制，检查进入稳定的时间、超调与稳态误差
+ *   sim_robot calib           静止时学习零偏与加速度计标定，检查运动窗口的剔除、写入Flash与重新载入
+ *   sim_robot rtos            创建app的全部任务，以2kHz/1.6kHz的IMU中断与1kHz的电机反馈运行，
+ *                             检查InsTask逐样本解算、ControlTask由TIM7释放并输出电流、trace记录的调度事件
+ *   sim_robot cmd "<命令>"    执行一条调试命令，如"prof"、"pool"
+ * 日志与命令输出写到标准输出，与USB虚拟串口上看到的相同
+ */
+
+#include "sim_hal.h"
+#include "fake_bmi088.h"
+#include "dtm/dtm.h"
+#include "imu/bmi088.h"
+#include "imu/heater.h"
+#include "imu/calib.h"
+#include "motor/dji/dji_motor.h"
+#include "upc/upc.h"
+#include "upc/upc_frame.h"
+#include "tick/tick.h"
+#include "trace/trace.h"
+#include "algorithm/crc.h"
+#include "task_init.h"
+#include "ins.h"
+#include "control.h"
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+void print_can_tx()
+{
+    sim_can_frame_t frames[16];
+    const uint32_t n = sim_can_tx(frames, 16);
+    for (uint32_t i = 0; i < n; i++) {
+        std::printf("can%d tx 0x%03X [%u]", frames[i].instance == CAN2 ? 2 : 1, (unsigned)frames[i].id,
+                    frames[i].dlc);
+        for (uint8_t k = 0; k < frames[i].dlc; k++)
+            std::printf(" %02X", frames[i].data[k]);
+        std::printf("\n");
+    }
+}
+
+/* M3508反馈: ecd(大端) | rpm(大端) | 电流(大端) | 温度 | 保留 */
+void inject_m3508(const uint8_t motor, const uint16_t ecd, const int16_t rpm, const int16_t current)
+{
+    const uint8_t data[8] = {static_cast<uint8_t>(ecd >> 8),     static_cast<uint8_t>(ecd),
+                             static_cast<uint8_t>(rpm >> 8),     static_cast<uint8_t>(rpm),
+                             static_cast<uint8_t>(current >> 8), static_cast<uint8_t>(current),
+                             40, 0};
+    sim_can_inject(&hcan1, dji::M3508Traits::rx_first + motor, data, 8);
+}
+
+int scenario_can()
+{
+    static dji::M3508Group chassis(&hcan1, 0x200, 4);
+
+    // 电机1正转跨过8191->0，电机2反转跨过0->8191
+    const uint16_t ecd1[] = {8000, 8150, 100, 300};
+    const uint16_t ecd2[] = {200, 50, 8100, 7900};
+    for (uint8_t k = 0; k < 4; k++) {
+        inject_m3508(0, ecd1[k], 1200, 500);
+        inject_m3508(1, ecd2[k], -1200, -500);
+        inject_m3508(2, 4096, 0, 0);
+        inject_m3508(3, 4096, 0, 0);
+    }
+
+    for (uint8_t i = 0; i < chassis.size(); i++) {
+        const dji::Measure &m = chassis.measure(i);
+        std::printf("%s[%u] ecd %u total %ld rpm %d current %d angle %.5f speed %.4f\n", chassis.topic_name(), i,
+                    m.ecd, (long)m.total_ecd, m.speed_rpm, m.current, chassis.angle(i), chassis.speed(i));
+    }
+
+    chassis.send_cmd(1000, -1000, 20000, -20000);
+    print_can_tx();
+
+    sim_cmd("prof");
+    return 0;
+}
+
+int scenario_upc()
+{
+    static DTM_DEFINE_TOPIC(float, test1);
+    DTM_REGISTER_TOPIC(float, test1);
+    DTM_PUBLISH(test1, 1.5f);
+
+    static upc pc(&huart6);
+    pc.enable();
+
+    struct __attribute__((packed)) ShootPayload
+    {
+        uint8_t reserved[12];
+        uint8_t shoot;
+    };
+    using ShootFrame = upc_frame::Builder<0x0404, ShootPayload, UPC_DATA_LEN>;
+    uint8_t frame[ShootFrame::size];
+    ShootPayload shoot{};
+    shoot.shoot = 1;
+    ShootFrame::build(frame, shoot);
+    sim_uart_inject(&huart6, frame, sizeof(frame));
+    print_can_tx();
+
+    pc.send_attitude_handler();
+    sim_poll();
+    uint8_t out[64];
+    const uint32_t n = sim_uart_tx(&huart6, out, sizeof(out));
+    std::printf("uart6 tx [%u]", (unsigned)n);
+    for (uint32_t i = 0; i < n; i++)
+        std::printf(" %02X", out[i]);
+    std::printf("\n");
+    return n == UPC_TOTAL_LEN ? 0 : 1;
+}
+
+bool near(const float a, const float b)
+{
+    return std::fabs(a - b) < 1e-3f;
+}
+
+int scenario_imu()
+{
+    static FakeBmi088 fake;
+    fake.attach();
+    fake.set_gyro(1000, -1000, 0);
+    fake.set_accel(0, 0, 5461);     // ±6g量程下约1g
+    fake.set_temperature(16);       // 25℃
+
+    if (!bmi088::init()) {
+        sim_poll();
+        return 1;
+    }
+    int ret = 0;
+
+    // 陀螺仪读取进行中时加速度计排队，同一轮sim_poll中依次完成
+    sim_exti(INT1_GYRO_Pin);
+    sim_exti(INT1_ACCEL_Pin);
+    sim_poll();
+    bmi088::ImuData d{};
+    bmi088::read(d);
+    std::printf("gyro %.5f %.5f %.5f accel %.5f %.5f %.5f count %lu/%lu seq %lu\n", d.gyro[0], d.gyro[1],
+                d.gyro[2], d.accel[0], d.accel[1], d.accel[2], (unsigned long)d.gyro_count,
+                (unsigned long)d.accel_count, (unsigned long)d.seq);
+    const float g = 1000.0f * bmi088::GYRO_SCALE;
+    if (!near(d.gyro[0], g) || !near(d.gyro[1], -g) || !near(d.accel[2], 5461.0f * bmi088::ACCEL_SCALE) ||
+        d.gyro_count != 1 || d.accel_count != 1 || (d.seq & 1u) != 0)
+        ret = 1;
+
+    // 上一次读取未完成时再次就绪，丢弃并计数
+    sim_exti(INT1_GYRO_Pin);
+    sim_exti(INT1_GYRO_Pin);
+    sim_poll();
+    std::printf("overruns %lu\n", (unsigned long)bmi088::overruns());
+    if (bmi088::overruns() != 1)
+        ret = 1;
+
+    // 每TEMP_DIVIDER个加速度样本读一次温度
+    for (uint8_t i = 0; i < bmi088::TEMP_DIVIDER; i++) {
+        sim_exti(INT1_ACCEL_Pin);
+        sim_poll();
+    }
+    bmi088::read(d);
+    std::printf("temperature %.3f\n", d.temperature);
+    if (!near(d.temperature, 25.0f))
+        ret = 1;
+
+    // 吞吐: 每轮两路中断，统计总线传输
+    constexpr uint32_t ROUNDS = 2000;
+    const uint32_t bytes0 = fake.bytes;
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        fake.set_gyro(static_cast<int16_t>(i), 0, 0);
+        sim_exti(INT1_GYRO_Pin);
+        sim_exti(INT1_ACCEL_Pin);
+        sim_poll();
+    }
+    bmi088::read(d);
+    std::printf("rounds %lu gyro %lu accel %lu bytes %lu overruns %lu errors %lu last %.5f\n",
+                (unsigned long)ROUNDS, (unsigned long)d.gyro_count, (unsigned long)d.accel_count,
+                (unsigned long)(fake.bytes - bytes0), (unsigned long)bmi088::overruns(),
+                (unsigned long)bmi088::errors(), d.gyro[0]);
+    if (!near(d.gyro[0], static_cast<float>(ROUNDS - 1) * bmi088::GYRO_SCALE) || bmi088::errors() != 0)
+        ret = 1;
+
+    sim_cmd("prof");
+    return ret;
+}
+
+/* 一阶热模型 dT/dt = (gain·duty - (T - ambient)) / tau，gain为满占空比时的稳态温升 */
+struct ThermalPlant
+{
+    float gain;
+    float tau;
+};
+
+int scenario_heater()
+{
+    static FakeBmi088 fake;
+    fake.attach();
+    if (!bmi088::init()) {
+        sim_poll();
+        return 1;
+    }
+    imu_heater::init();
+
+    constexpr float AMBIENT = 25.0f;
+    constexpr float DT = 0.1f;              // 与InsTask中的调用周期相同
+    constexpr uint32_t STEPS = 3000;        // 300s
+    constexpr float STABLE_WITHIN_S = 120.0f;
+    const imu_heater::Config &cfg = imu_heater::default_config;
+    const ThermalPlant plants[] = {{20.0f, 20.0f}, {35.0f, 40.0f}, {60.0f, 60.0f}, {35.0f, 120.0f}, {80.0f, 30.0f}};
+    int ret = 0;
+
+    for (const auto &plant : plants) {
+        float temp = AMBIENT;
+        float peak = AMBIENT;
+        float stable_at = -1.0f;
+        bool lost = false;
+        bmi088::ImuData d{};
+        imu_heater::Status s{};
+        for (uint32_t n = 0; n < STEPS; n++) {
+            const float duty = static_cast<float>(htim10.Instance->CCR[0]) /
+                               static_cast<float>(__HAL_TIM_GET_AUTORELOAD(&htim10) + 1);
+            for (uint32_t k = 0; k < 100; k++)
+                temp += (plant.gain * duty - (temp - AMBIENT)) / plant.tau * (DT / 100.0f);
+            peak = temp > peak ? temp : peak;
+
+            // 温度随加速度计读取每TEMP_DIVIDER个样本更新一次
+            fake.set_temperature(static_cast<int16_t>(std::lround((temp - 23.0f) / 0.125f)));
+            for (uint8_t i = 0; i < bmi088::TEMP_DIVIDER; i++) {
+                sim_exti(INT1_ACCEL_Pin);
+                sim_poll();
+            }
+            bmi088::read(d);
+            imu_heater::update(d.temperature, DT);
+
+            imu_heater::read(s);
+            if (s.stable && stable_at < 0.0f)
+                stable_at = static_cast<float>(n + 1) * DT;
+            lost = lost || (stable_at >= 0.0f && !s.stable);
+        }
+        std::printf("plant gain %.0f tau %.0f: stable at %.1fs peak %.2f final %.2f duty %.3f%s\n", plant.gain,
+                    plant.tau, stable_at, peak, temp, s.duty, lost ? " lost" : "");
+        if (stable_at < 0.0f || stable_at > STABLE_WITHIN_S || peak > cfg.target + cfg.band || lost ||
+            std::fabs(temp - cfg.target) > cfg.band)
+            ret = 1;
+
+        // 冷却后换下一个模型
+        imu_heater::off();
+        if (imu_heater::stable() || htim10.Instance->CCR[0] != 0)
+            ret = 1;
+    }
+    return ret;
+}
+
+/* 送入n个样本: 每个样本一次陀螺仪与一次加速度计中断，与InsTask一样读取后送入标定 */
+void feed_calib(const uint32_t n)
+{
+    bmi088::ImuData d{};
+    for (uint32_t i = 0; i < n; i++) {
+        sim_exti(INT1_GYRO_Pin);
+        sim_exti(INT1_ACCEL_Pin);
+        sim_poll();
+        bmi088::read(d);
+        imu_calib::feed(d.gyro, d.accel, d.temperature);
+    }
+}
+
+bool calib_ready(const float temperature, float *gyro)
+{
+    const float raw[3] = {0.0f, 0.0f, 0.0f};
+    float accel[3];
+    return imu_calib::apply(raw, raw, temperature, gyro, accel);
+}
+
+int scenario_calib()
+{
+    static FakeBmi088 fake;
+    fake.attach();
+    if (!bmi088::init()) {
+        sim_poll();
+        return 1;
+    }
+    static bool idle = true;
+    imu_calib::init([] { return idle; });
+    int ret = 0;
+    constexpr int16_t BIAS[3] = {30, -20, 10};      // LSB，约0.032/-0.021/0.011 rad/s
+    constexpr float TEMP = 40.0f;
+    // 加速度计z轴: 比例误差约2%、偏移100LSB
+    constexpr int16_t ACCEL_UP = 5670;
+    constexpr int16_t ACCEL_DOWN = -5470;
+    fake.set_temperature(static_cast<int16_t>((TEMP - 23.0f) / 0.125f));
+    fake.set_gyro(BIAS[0], BIAS[1], BIAS[2]);
+    fake.set_accel(0, 0, ACCEL_UP);
+    float bias[3];
+
+    // 空存储区: 静止2个窗口后零偏有效并写入Flash
+    if (calib_ready(TEMP, bias))
+        ret = 1;
+    feed_calib(2 * imu_calib::WINDOW);
+    imu_calib::Status s{};
+    imu_calib::read(s);
+    const bool ready = calib_ready(TEMP, bias);
+    std::printf("learn: ready %d bias %.5f %.5f %.5f bins 0x%05lX saves %lu\n", ready, bias[0], bias[1], bias[2],
+                (unsigned long)s.gyro_bins, (unsigned long)s.saves);
+    for (uint8_t k = 0; k < 3; k++)
+        ret |= near(bias[k], -static_cast<float>(BIAS[k]) * bmi088::GYRO_SCALE) ? 0 : 1;
+    if (!ready || s.saves != 1)
+        ret = 1;
+
+    // 转动的窗口不计入，与已有零偏不符的缓慢转动被拒绝
+    fake.set_gyro(2000, 0, 0);
+    feed_calib(imu_calib::WINDOW);
+    fake.set_gyro(BIAS[0] + 12, BIAS[1], BIAS[2]);
+    feed_calib(imu_calib::WINDOW);
+    imu_calib::read(s);
+    calib_ready(TEMP, bias);
+    std::printf("motion: stationary %lu/%lu rejected %lu bias x %.5f\n", (unsigned long)s.stationary_windows,
+                (unsigned long)s.windows, (unsigned long)s.rejected, bias[0]);
+    if (s.stationary_windows != 3 || s.rejected != 1 || !near(bias[0], -static_cast<float>(BIAS[0]) * bmi088::GYRO_SCALE))
+        ret = 1;
+
+    // 翻转后得到z轴的偏移与比例
+    fake.set_gyro(BIAS[0], BIAS[1], BIAS[2]);
+    fake.set_accel(0, 0, ACCEL_DOWN);
+    feed_calib(2 * imu_calib::WINDOW);
+    imu_calib::read(s);
+    const float scale = 2.0f * bmi088::GRAVITY / (static_cast<float>(ACCEL_UP - ACCEL_DOWN) * bmi088::ACCEL_SCALE);
+    std::printf("accel: axes 0x%X z offset %.4f scale %.5f\n", s.accel_axes, s.accel_offset[2], s.accel_scale[2]);
+    if (s.accel_axes != 0x4 || !near(s.accel_offset[2], 100.0f * bmi088::ACCEL_SCALE) ||
+        !near(s.accel_scale[2], scale))
+        ret = 1;
+
+    // 控制出力时拒绝保存，也不自动写入
+    idle = false;
+    sim_cmd("calib save");
+    feed_calib(1);
+    imu_calib::read(s);
+    const uint32_t saves = s.saves;
+    feed_calib(imu_calib::WINDOW);
+    imu_calib::read(s);
+    std::printf("busy: saves %lu -> %lu\n", (unsigned long)saves, (unsigned long)s.saves);
+    if (s.saves != saves)
+        ret = 1;
+    idle = true;
+
+    // 立即保存，之后的学习只在内存中；重新载入得到保存时的结果
+    sim_cmd("calib save");
+    feed_calib(1);
+    fake.set_gyro(BIAS[0] + 9, BIAS[1], BIAS[2]);
+    feed_calib(4 * imu_calib::WINDOW);
+    float unsaved[3], other[3];
+    calib_ready(TEMP, unsaved);
+    const bool loaded = imu_calib::load();
+    const bool ready40 = calib_ready(TEMP, bias);
+    const bool ready25 = calib_ready(25.0f, other);
+    std::printf("reload: loaded %d bias x %.5f (unsaved %.5f) ready at 40C %d at 25C %d\n", loaded, bias[0],
+                unsaved[0], ready40, ready25);
+    if (!loaded || !ready40 || ready25 || !near(bias[0], -static_cast<float>(BIAS[0]) * bmi088::GYRO_SCALE) ||
+        near(unsaved[0], bias[0]))
+        ret = 1;
+
+    sim_cmd("calib");
+    sim_cmd("prof");
+    return ret;
+}
+
+/* 每步在"中断"中注入: 陀螺仪2kHz、加速度计1.6kHz数据就绪，CAN1上四个M3508的1kHz反馈 */
+void rtos_step(void *, const uint64_t now_us)
+{
+    if (now_us % 500u == 0)
+        sim_exti(INT1_GYRO_Pin);
+    if (now_us % 625u < SIM_STEP_US)
+        sim_exti(INT1_ACCEL_Pin);
+    if (now_us % 1000u == 0) {
+        for (uint8_t i = 0; i < CONTROL_MOTORS; i++)
+            inject_m3508(i, 4096, 0, 0);
+    }
+}
+
+/* 取出已发送的全部CAN帧，返回最后一个电流指令帧(CAN1 0x200)中电机0的电流，没有时返回INT32_MIN */
+int32_t last_current_cmd()
+{
+    sim_can_frame_t frames[64];
+    int32_t current = INT32_MIN;
+    uint32_t n;
+    while ((n = sim_can_tx(frames, 64)) > 0) {
+        for (uint32_t i = 0; i < n; i++) {
+            if (frames[i].instance == CAN1 && frames[i].id == 0x200)
+                current = static_cast<int16_t>(frames[i].data[0] << 8 | frames[i].data[1]);
+        }
+    }
+    return current;
+}
+
+std::vector<uint8_t> usb_capture;
+
+void capture_output(const uint8_t *data, const uint32_t len)
+{
+    usb_capture.insert(usb_capture.end(), data, data + len);
+}
+
+struct TraceCount
+{
+    uint32_t events;
+    uint32_t control_in;    // ControlTask切入
+    uint32_t ins_in;        // InsTask切入
+    uint32_t tim7;          // TIM7中断进入
+};
+
+/* 从USB输出中解析trace帧(0xA5 'T' type len payload crc16)，跳过其间的日志文本 */
+TraceCount parse_trace(std::vector<uint8_t> &buf)
+{
+    TraceCount c{};
+    int control = -1, ins = -1;
+    size_t i = 0;
+    while (i + 7 <= buf.size()) {
+        const uint16_t len = static_cast<uint16_t>(buf[i + 3] | buf[i + 4] << 8);
+        if (buf[i] != TRACE_FRAME_HEADER || buf[i + 1] != TRACE_FRAME_TAG || i + 7u + len > buf.size() ||
+            !Verify_CRC16_Check_Sum(&buf[i], len + 7u)) {
+            i++;
+            continue;
+        }
+        const uint8_t *payload = &buf[i + 5];
+        if (buf[i + 2] == TRACE_FRAME_TASK) {
+            const std::string name(reinterpret_cast<const char *>(&payload[2]),
+                                   strnlen(reinterpret_cast<const char *>(&payload[2]), configMAX_TASK_NAME_LEN));
+            if (name == "control")
+                control = payload[0];
+            else if (name == "ins")
+                ins = payload[0];
+        } else if (buf[i + 2] == TRACE_FRAME_EVENTS) {
+            for (uint16_t k = 8; k + sizeof(trace_event_t) <= len; k += sizeof(trace_event_t)) {
+                trace_event_t ev;
+                std::memcpy(&ev, &payload[k], sizeof(ev));
+                c.events++;
+                if (ev.type == TRACE_EV_TASK_IN && ev.id == control)
+                    c.control_in++;
+                if (ev.type == TRACE_EV_TASK_IN && ev.id == ins)
+                    c.ins_in++;
+                if (ev.type == TRACE_EV_ISR_ENTER && ev.id == TRACE_ISR_TIM7)
+                    c.tim7++;
+            }
+        }
+        i += 7u + len;
+    }
+    return c;
+}
+
+int scenario_rtos()
+{
+    static FakeBmi088 fake;
+    fake.attach();
+    fake.set_gyro(100, 0, 0);
+    fake.set_accel(0, 0, 5461);
+    fake.set_temperature(16);
+    task_init();
+    int ret = 0;
+
+    // 启动: bmi088初始化(含osDelay)、各任务进入主循环
+    sim_run(300000, rtos_step, nullptr);
+
+    // InsTask对每个陀螺仪样本更新一次姿态
+    bmi088::ImuData d{};
+    ins_attitude_t att{};
+    bmi088::read(d);
+    ins_get_attitude(att);
+    const uint32_t gyro0 = d.gyro_count;
+    const uint32_t lag0 = d.gyro_count - att.count;
+    tick_reset_stats();
+    sim_run(200000, nullptr, nullptr);
+    bmi088::read(d);
+    ins_get_attitude(att);
+    tick_stats_t ts{};
+    tick_get_stats(&ts);
+    std::printf("ins: gyro %lu attitude %lu lag %lu -> %lu rate x %.4f\n", (unsigned long)(d.gyro_count - gyro0),
+                (unsigned long)att.count, (unsigned long)lag0, (unsigned long)(d.gyro_count - att.count),
+                att.rate[0]);
+    if (d.gyro_count - gyro0 != 400 || d.gyro_count - att.count != lag0 || att.count == 0)
+        ret = 1;
+
+    // ControlTask由TIM7以1kHz释放；主机繁忙、一步超过1ms时错过的更新事件合并，周期数略少于200
+    std::printf("tick: %luHz cycles %lu overruns %lu\n", (unsigned long)ts.rate_hz, (unsigned long)ts.cycles,
+                (unsigned long)ts.overruns);
+    if (ts.rate_hz != 1000 || ts.cycles < 150 || ts.cycles > 201 || ts.overruns != 0)
+        ret = 1;
+
+    // 使能电机0的速度环，电流指令随之变为正
+    const int32_t idle_current = last_current_cmd();
+    control_target_t target{};
+    target.speed_mask = 1u;
+    target.speed[0] = 10.0f;
+    dtm::Manager::publish("control_target", target);
+    sim_run(20000, nullptr, nullptr);
+    const int32_t current = last_current_cmd();
+    std::printf("control: current %ld -> %ld\n", (long)idle_current, (long)current);
+    if (idle_current != 0 || current <= 0)
+        ret = 1;
+
+    // 调度跟踪: 快照模式记录后导出，在USB输出中解析
+    sim_cmd("trace start");
+    sim_run(50000, nullptr, nullptr);
+    sim_usb_output(capture_output);
+    sim_cmd("trace dump");
+    sim_usb_output(nullptr);
+    const TraceCount tc = parse_trace(usb_capture);
+    std::printf("trace: events %lu control in %lu ins in %lu tim7 %lu\n", (unsigned long)tc.events,
+                (unsigned long)tc.control_in, (unsigned long)tc.ins_in, (unsigned long)tc.tim7);
+    if (tc.events == 0 || tc.control_in == 0 || tc.ins_in == 0 || tc.tim7 == 0 ||
+        (tc.control_in > tc.tim7 + 1 || tc.tim7 > tc.control_in + 1))
+        ret = 1;
+
+    sim_cmd("tick");
+    sim_cmd("top");
+    sim_cmd("prof");
+    return ret;
+}
+
+int usage()
+{
+    std::fprintf(stderr, "usage: sim_robot can | upc | imu | heater | calib | rtos | cmd \"<line>\"\n");
+    return 2;
+}
+
+} // namespace
+
+int main(const int argc, char **argv)
+{
+    if (argc < 2)
+        return usage();
+
+    sim_init();
+    const std::string scenario = argv[1];
+    int ret;
+    if (scenario == "can") {
+        ret = scenario_can();
+    } else if (scenario == "upc") {
+        ret = scenario_upc();
+    } else if (scenario == "imu") {
+        ret = scenario_imu();
+    } else if (scenario == "heater") {
+        ret = scenario_heater();
+    } else if (scenario == "calib") {
+        ret = scenario_calib();
+    } else if (scenario == "rtos") {
+        ret = scenario_rtos();
+    } else if (scenario == "cmd" && argc > 2) {
+        sim_cmd(argv[2]);
+        ret = 0;
+    } else {
+        return usage();
+    }
+    sim_poll();
+    return ret;
+}
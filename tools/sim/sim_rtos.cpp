@@ -0,0 +1,366 @@
+/**
+ * @file sim_rtos.cpp
+ * @brief 主机仿真的CMSIS-RTOS/FreeRTOS替身与TIM7
+ * 每个任务运行在一个主机线程上，但同一时刻只有一个线程在运行(单核): 切换只发生在任务阻塞(osDelay、
+ * ulTaskNotifyTake)或通知了更高优先级的任务时，按优先级、同优先级先就绪者先运行。
+ * 仿真线程(main)相当于中断与空闲任务，只在所有任务都阻塞时运行: sim_run每SIM_STEP_US注入一次"中断"，
+ * 推进FreeRTOS节拍(1kHz)、产生到期的TIM7更新中断，再运行就绪的任务。
+ * 因此中断不会抢占正在运行的任务，任务的执行时间与调度延迟是主机上的，不代表目标板。
+ * 任务切换、就绪与通知按FreeRTOSConfig.h中的trace宏记录到bsp/trace，运行时间按DWT计入，供"trace"与"top"命令使用
+ */
+
+#include "sim_hal.h"
+#include "cmsis_os.h"
+#include "tim.h"
+#include "tick/tick.h"
+#include "trace/trace.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+enum class State { READY, DELAYED, WAIT_NOTIFY };
+
+struct SimTask
+{
+    const char *name;
+    os_pthread entry;
+    const void *arg;
+    int32_t priority;
+    uint32_t stack_words;
+    UBaseType_t number;
+    State state;
+    uint32_t notify;
+    bool timed;             // 阻塞有超时
+    TickType_t wake_tick;
+    uint32_t run_cycles;
+    uint64_t ready_seq;     // 同优先级按进入就绪的顺序运行
+};
+
+using Clock = std::chrono::steady_clock;
+
+// 任务线程在退出时仍阻塞在条件变量上，二者不析构
+std::mutex &lock = *new std::mutex;
+std::condition_variable &cv = *new std::condition_variable;
+std::vector<SimTask *> tasks;
+SimTask *running = nullptr;     // nullptr: 仿真线程(中断与空闲)
+thread_local SimTask *self = nullptr;
+SimTask main_task{"main", nullptr, nullptr, 0, 0, 0, State::READY, 0, false, 0, 0, 0};    // 非任务的调用者
+uint64_t ready_counter = 0;
+uint32_t switch_in_cycles = 0;
+
+TickType_t os_tick = 0;
+uint64_t sim_time_us = 0;
+sim_step_t last_step = nullptr;
+void *last_ctx = nullptr;
+
+/* TIM7: 更新事件的时刻由主机时钟按计数频率与ARR换算 */
+bool tim7_running = false;
+Clock::time_point tim7_next;
+
+uint32_t tim7_count_hz()
+{
+    return HAL_RCC_GetPCLK1Freq() * 2u / (TIM7->PSC + 1u);
+}
+
+Clock::duration tim7_period()
+{
+    const uint64_t ns = (static_cast<uint64_t>(TIM7->ARR) + 1u) * 1000000000u / tim7_count_hz();
+    return std::chrono::nanoseconds(ns);
+}
+
+SimTask *task_of(TaskHandle_t handle)
+{
+    return static_cast<SimTask *>(handle);
+}
+
+void make_ready(SimTask *t)
+{
+    t->state = State::READY;
+    t->ready_seq = ++ready_counter;
+    trace_record(TRACE_EV_TASK_READY, static_cast<uint8_t>(t->number), 0);
+}
+
+/* 优先级最高、同优先级中最先就绪的任务 */
+SimTask *pick()
+{
+    SimTask *best = nullptr;
+    for (SimTask *t : tasks) {
+        if (t->state != State::READY)
+            continue;
+        if (best == nullptr || t->priority > best->priority ||
+            (t->priority == best->priority && t->ready_seq < best->ready_seq))
+            best = t;
+    }
+    return best;
+}
+
+/* 把CPU交给next(nullptr为仿真线程)，调用者持有lock */
+void hand_over(SimTask *next)
+{
+    const uint32_t now = DWT->CYCCNT;
+    if (running != nullptr)
+        running->run_cycles += now - switch_in_cycles;
+    switch_in_cycles = now;
+    running = next;
+    if (next != nullptr)
+        trace_record(TRACE_EV_TASK_IN, static_cast<uint8_t>(next->number), 0);
+    cv.notify_all();
+}
+
+/* 当前任务已阻塞或让出，切换到下一个就绪的任务，直到再次轮到自己 */
+void reschedule(std::unique_lock<std::mutex> &lk)
+{
+    hand_over(pick());
+    cv.wait(lk, [] { return running == self; });
+}
+
+/* 仿真线程: 运行就绪的任务直到全部阻塞 */
+void run_tasks()
+{
+    std::unique_lock lk(lock);
+    SimTask *next = pick();
+    if (next == nullptr)
+        return;
+    hand_over(next);
+    cv.wait(lk, [] { return running == nullptr; });
+}
+
+/* FreeRTOS节拍: 唤醒到期的延时与超时等待 */
+void os_tick_advance()
+{
+    std::unique_lock lk(lock);
+    os_tick++;
+    for (SimTask *t : tasks) {
+        const bool blocked = t->state == State::DELAYED || (t->state == State::WAIT_NOTIFY && t->timed);
+        if (blocked && static_cast<int32_t>(os_tick - t->wake_tick) >= 0)
+            make_ready(t);
+    }
+}
+
+void tim7_irq(void *)
+{
+    TRACE_ISR_ENTER(TRACE_ISR_TIM7);
+    HAL_TIM_PeriodElapsedCallback(&htim7);
+    TRACE_ISR_EXIT(TRACE_ISR_TIM7);
+}
+
+/* 到期时产生一次更新中断，错过的多个更新事件与硬件一样合并为一次，CNT为最近一次更新事件后已计的数 */
+void tim7_poll()
+{
+    if (!tim7_running)
+        return;
+    const auto now = Clock::now();
+    if (now < tim7_next)
+        return;
+
+    const auto period = tim7_period();
+    const auto last = tim7_next + (now - tim7_next) / period * period;
+    const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count();
+    const uint64_t count = ns * tim7_count_hz() / 1000000000u;
+    TIM7->CNT = static_cast<uint32_t>(count > TIM7->ARR ? TIM7->ARR : count);
+    tim7_next = last + period;
+    sim_irq(tim7_irq, nullptr);
+}
+
+} // namespace
+
+extern "C"
+{
+
+osThreadId osThreadCreate(const osThreadDef_t *thread_def, void *argument)
+{
+    auto *t = new SimTask{thread_def->name, thread_def->pthread, argument,
+                          static_cast<int32_t>(thread_def->tpriority), thread_def->stacksize,
+                          0, State::READY, 0, false, 0, 0, 0};
+    {
+        std::unique_lock lk(lock);
+        tasks.push_back(t);
+        t->number = tasks.size();
+        make_ready(t);
+    }
+
+    std::thread([t] {
+        self = t;
+        {
+            std::unique_lock lk(lock);
+            cv.wait(lk, [t] { return running == t; });
+        }
+        t->entry(t->arg);
+        std::fprintf(stderr, "task %s returned\n", t->name);
+        std::abort();
+    }).detach();
+    return t;
+}
+
+/* 在任务中阻塞millisec个节拍；场景代码中调用时执行后台工作并运行就绪的任务 */
+osStatus osDelay(const uint32_t millisec)
+{
+    if (self == nullptr) {
+        sim_poll();
+        if (sim_rtos_started())
+            run_tasks();
+        std::this_thread::sleep_for(std::chrono::milliseconds(millisec));
+        return osOK;
+    }
+
+    std::unique_lock lk(lock);
+    if (millisec == 0) {
+        self->ready_seq = ++ready_counter;
+    } else {
+        self->state = State::DELAYED;
+        self->wake_tick = os_tick + millisec;
+    }
+    reschedule(lk);
+    return osOK;
+}
+
+BaseType_t xTaskGetSchedulerState(void) { return taskSCHEDULER_RUNNING; }
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return self != nullptr ? self : &main_task;
+}
+
+/* 通知了优先级更高的任务时立即切换，与目标板上的抢占相同 */
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    SimTask *t = task_of(task);
+    std::unique_lock lk(lock);
+    t->notify++;
+    if (t == &main_task)
+        return pdTRUE;
+    trace_record(TRACE_EV_NOTIFY, static_cast<uint8_t>(t->number), 0);
+    if (t->state == State::WAIT_NOTIFY)
+        make_ready(t);
+    if (self != nullptr && t->state == State::READY && t->priority > self->priority) {
+        self->ready_seq = ++ready_counter;
+        reschedule(lk);
+    }
+    return pdTRUE;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken)
+{
+    SimTask *t = task_of(task);
+    std::unique_lock lk(lock);
+    t->notify++;
+    if (t == &main_task) {
+        *woken = pdFALSE;
+        return;
+    }
+    trace_record(TRACE_EV_NOTIFY, static_cast<uint8_t>(t->number), 0);
+    if (t->state == State::WAIT_NOTIFY) {
+        make_ready(t);
+        *woken = pdTRUE;
+    }
+}
+
+/* 场景代码中调用时不阻塞，没有通知时执行一次后台工作后返回 */
+uint32_t ulTaskNotifyTake(const BaseType_t clear, const TickType_t wait)
+{
+    if (self == nullptr) {
+        if (main_task.notify == 0)
+            sim_poll();
+        std::unique_lock lk(lock);
+        const uint32_t n = main_task.notify;
+        main_task.notify = clear ? 0 : (n > 0 ? n - 1 : 0);
+        return n;
+    }
+
+    std::unique_lock lk(lock);
+    if (self->notify == 0 && wait > 0) {
+        self->state = State::WAIT_NOTIFY;
+        self->timed = wait != portMAX_DELAY;
+        self->wake_tick = os_tick + wait;
+        reschedule(lk);
+    }
+    const uint32_t n = self->notify;
+    self->notify = clear ? 0 : (n > 0 ? n - 1 : 0);
+    trace_record(TRACE_EV_NOTIFY_WAIT, static_cast<uint8_t>(self->number), 0);
+    return n;
+}
+
+/* 优先级与CMSIS-RTOS的映射相同(osPriorityIdle为0)；主机上无法测量栈用量，栈剩余报告声明的大小 */
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, const UBaseType_t size, uint32_t *total_run_time)
+{
+    std::unique_lock lk(lock);
+    const uint32_t now = DWT->CYCCNT;
+    UBaseType_t n = 0;
+    for (SimTask *t : tasks) {
+        if (n >= size)
+            break;
+        TaskStatus_t &s = status[n++];
+        s.xHandle = t;
+        s.pcTaskName = t->name;
+        s.xTaskNumber = t->number;
+        s.eCurrentState = t == running ? eRunning : (t->state == State::READY ? eReady : eBlocked);
+        s.uxCurrentPriority = static_cast<UBaseType_t>(t->priority - osPriorityIdle);
+        s.uxBasePriority = s.uxCurrentPriority;
+        s.ulRunTimeCounter = t->run_cycles + (t == running ? now - switch_in_cycles : 0u);
+        s.pxStackBase = nullptr;
+        s.usStackHighWaterMark = static_cast<uint16_t>(t->stack_words);
+    }
+    if (total_run_time != nullptr)
+        *total_run_time = now;
+    return n;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM7) {
+        tim7_running = true;
+        tim7_next = Clock::now() + tim7_period();
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM7)
+        tim7_running = false;
+    return HAL_OK;
+}
+
+/* 与Core/Src/main.c相同，TIM14(HAL节拍)不仿真 */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM7)
+        tick_isr();
+}
+
+uint8_t sim_rtos_started(void)
+{
+    std::unique_lock lk(lock);
+    return !tasks.empty();
+}
+
+void sim_run(const uint32_t duration_us, const sim_step_t step, void *ctx)
+{
+    if (step != nullptr) {
+        last_step = step;
+        last_ctx = ctx;
+    }
+
+    // 每次调用重新对齐主机时间，两次调用之间(场景代码的检查)任务不运行，TIM7错过的更新事件合并为一次
+    const auto start = Clock::now();
+    for (uint32_t t = SIM_STEP_US; t <= duration_us; t += SIM_STEP_US) {
+        std::this_thread::sleep_until(start + std::chrono::microseconds(t));
+        sim_time_us += SIM_STEP_US;
+
+        if (last_step != nullptr)
+            sim_irq([](void *) { last_step(last_ctx, sim_time_us); }, nullptr);
+        sim_poll();
+        tim7_poll();
+        while (os_tick < sim_time_us / 1000u)
+            os_tick_advance();
+        run_tasks();
+    }
+}
+
+}
@@ -0,0 +1,280 @@
+/**
+ * @file trace_decode.cpp
+ * @brief bsp/trace二进制调度跟踪解析工具
+ * 从USB虚拟串口抓取的原始数据(可混有文本日志)中找出trace帧，输出时间线与各任务统计。
+ * 用法: trace_decode capture.bin [--timeline]
+ * 帧格式与事件定义见bsp/trace/trace.h
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "algorithm/crc.h"
+
+namespace {
+
+constexpr uint8_t FRAME_HEADER = 0xA5;
+constexpr uint8_t FRAME_TAG = 'T';
+constexpr size_t FRAME_OVERHEAD = 7;
+constexpr size_t FRAME_MAX_PAYLOAD = 1024;
+constexpr size_t TASK_NAME_LEN = 16;
+
+enum FrameType : uint8_t { FRAME_INFO = 1, FRAME_TASK, FRAME_EVENTS };
+
+enum EventType : uint8_t {
+    EV_TASK_IN = 1, EV_TASK_READY, EV_ISR_ENTER, EV_ISR_EXIT,
+    EV_QUEUE_SEND, EV_QUEUE_RECV, EV_NOTIFY, EV_NOTIFY_WAIT
+};
+
+const char* const isr_names[] = {"?", "USART1", "USART3", "USART6", "TIM14", "OTG_FS", "CAN1_RX0", "CAN2_RX0", "TIM7",
+                                 "EXTI4", "EXTI9_5", "DMA2_Stream2"};
+
+struct Event {
+    uint64_t time;  // 展开后的周期数
+    uint8_t type;
+    uint8_t id;
+    uint16_t arg;
+};
+
+struct Stat {
+    uint64_t count = 0;
+    uint64_t total = 0;
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+
+    void add(const uint64_t v)
+    {
+        count++;
+        total += v;
+        if (v < min) min = v;
+        if (v > max) max = v;
+    }
+};
+
+struct TaskInfo {
+    std::string name;
+    uint8_t priority = 0;
+    Stat run;       // 每次被切入后的运行时长
+    Stat latency;   // 就绪到切入的延迟
+    bool ready_pending = false;
+    uint64_t ready_time = 0;
+};
+
+uint32_t rd32(const uint8_t* p) { return p[0] | p[1] << 8 | p[2] << 16 | static_cast<uint32_t>(p[3]) << 24; }
+uint16_t rd16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | p[1] << 8); }
+
+class Decoder {
+public:
+    void feed(std::vector<uint8_t>& data)
+    {
+        size_t i = 0;
+        while (i + FRAME_OVERHEAD <= data.size()) {
+            if (data[i] != FRAME_HEADER || data[i + 1] != FRAME_TAG) {
+                i++;
+                continue;
+            }
+            const uint16_t len = rd16(&data[i + 3]);
+            if (len > FRAME_MAX_PAYLOAD || i + len + FRAME_OVERHEAD > data.size() ||
+                !Verify_CRC16_Check_Sum(&data[i], len + FRAME_OVERHEAD)) {
+                i++;
+                continue;
+            }
+            frame(data[i + 2], &data[i + 5], len);
+            frames_++;
+            i += len + FRAME_OVERHEAD;
+        }
+    }
+
+    void print_timeline() const
+    {
+        const uint64_t t0 = events_.empty() ? 0 : events_.front().time;
+        for (const auto& ev : events_) {
+            std::printf("%12.3f us  ", to_us(ev.time - t0));
+            switch (ev.type) {
+            case EV_TASK_IN:     std::printf("run    %s\n", task_name(ev.id).c_str()); break;
+            case EV_TASK_READY:  std::printf("ready  %s\n", task_name(ev.id).c_str()); break;
+            case EV_ISR_ENTER:   std::printf("isr>   %s\n", isr_name(ev.id)); break;
+            case EV_ISR_EXIT:    std::printf("isr<   %s\n", isr_name(ev.id)); break;
+            case EV_QUEUE_SEND:  std::printf("qsend  q@%04x\n", ev.arg); break;
+            case EV_QUEUE_RECV:  std::printf("qrecv  q@%04x\n", ev.arg); break;
+            case EV_NOTIFY:      std::printf("notify %s\n", task_name(ev.id).c_str()); break;
+            case EV_NOTIFY_WAIT: std::printf("wait   %s\n", task_name(ev.id).c_str()); break;
+            default:             std::printf("?%u    %u %u\n", ev.type, ev.id, ev.arg); break;
+            }
+        }
+    }
+
+    void print_report()
+    {
+        analyse();
+        const uint64_t span = events_.size() > 1 ? events_.back().time - events_.front().time : 0;
+
+        std::printf("frames %zu, events %zu, dropped %u, gaps %u, span %.3f ms, cpu %u Hz\n\n",
+                    frames_, events_.size(), dropped_, gaps_, to_us(span) / 1000.0, cpu_hz_);
+        std::printf("%-16s %4s %8s %8s %10s %10s %10s %10s\n",
+                    "task", "prio", "runs", "cpu%", "run_max", "lat_avg", "lat_max", "lat_cnt");
+        for (auto& [num, task] : tasks_) {
+            const double cpu = span ? 100.0 * static_cast<double>(task.run.total) / static_cast<double>(span) : 0.0;
+            std::printf("%-16s %4u %8llu %8.2f %10.2f %10.2f %10.2f %10llu\n",
+                        task_name(num).c_str(), task.priority,
+                        static_cast<unsigned long long>(task.run.count), cpu, to_us(task.run.max),
+                        task.latency.count ? to_us(task.latency.total / task.latency.count) : 0.0,
+                        to_us(task.latency.max), static_cast<unsigned long long>(task.latency.count));
+        }
+        std::printf("\n%-16s %8s %10s %10s %10s\n", "isr", "count", "min_us", "avg_us", "max_us");
+        for (const auto& [id, st] : isr_stats_) {
+            std::printf("%-16s %8llu %10.2f %10.2f %10.2f\n", isr_name(id),
+                        static_cast<unsigned long long>(st.count), to_us(st.min),
+                        to_us(st.total / st.count), to_us(st.max));
+        }
+        std::printf("(times in us)\n");
+    }
+
+private:
+    uint32_t cpu_hz_ = 168000000;
+    std::map<uint8_t, TaskInfo> tasks_;
+    std::map<uint8_t, Stat> isr_stats_;
+    std::vector<Event> events_;
+    size_t frames_ = 0;
+    uint32_t dropped_ = 0;
+    uint32_t gaps_ = 0;
+    uint32_t next_seq_ = 0;
+    bool have_seq_ = false;
+    uint32_t last_raw_ = 0;
+    uint64_t epoch_ = 0;
+
+    [[nodiscard]] double to_us(const uint64_t cycles) const
+    {
+        return static_cast<double>(cycles) * 1e6 / cpu_hz_;
+    }
+
+    [[nodiscard]] std::string task_name(const uint8_t num) const
+    {
+        const auto it = tasks_.find(num);
+        if (it != tasks_.end() && !it->second.name.empty())
+            return it->second.name;
+        return "task#" + std::to_string(num);
+    }
+
+    static const char* isr_name(const uint8_t id)
+    {
+        return id < std::size(isr_names) ? isr_names[id] : "?";
+    }
+
+    void frame(const uint8_t type, const uint8_t* p, const uint16_t len)
+    {
+        switch (type) {
+        case FRAME_INFO:
+            if (len >= 4) cpu_hz_ = rd32(p);
+            break;
+        case FRAME_TASK:
+            if (len >= 2) {
+                auto& task = tasks_[p[0]];
+                task.priority = p[1];
+                task.name.assign(reinterpret_cast<const char*>(p + 2),
+                                 strnlen(reinterpret_cast<const char*>(p + 2), std::min<size_t>(len - 2, TASK_NAME_LEN)));
+            }
+            break;
+        case FRAME_EVENTS:
+            if (len >= 8) events(p, len);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void events(const uint8_t* p, const uint16_t len)
+    {
+        const uint32_t seq = rd32(p);
+        dropped_ = rd32(p + 4);
+        if (have_seq_ && seq != next_seq_)
+            gaps_++;
+
+        const size_t n = (len - 8) / 8;
+        for (size_t i = 0; i < n; i++) {
+            const uint8_t* e = p + 8 + i * 8;
+            const uint32_t raw = rd32(e);
+            // CYCCNT 32位回绕，相邻事件间隔需小于2^32周期
+            if (!events_.empty() && raw < last_raw_)
+                epoch_ += 1ull << 32;
+            last_raw_ = raw;
+            events_.push_back({epoch_ | raw, e[4], e[5], rd16(e + 6)});
+        }
+        next_seq_ = seq + static_cast<uint32_t>(n);
+        have_seq_ = true;
+    }
+
+    void analyse()
+    {
+        int current = -1;
+        uint64_t switched_in = 0;
+        std::map<uint8_t, uint64_t> isr_enter;
+
+        for (const auto& ev : events_) {
+            switch (ev.type) {
+            case EV_TASK_READY: {
+                auto& task = tasks_[ev.id];
+                if (!task.ready_pending && ev.id != current) {
+                    task.ready_pending = true;
+                    task.ready_time = ev.time;
+                }
+                break;
+            }
+            case EV_TASK_IN: {
+                if (current >= 0 && current != ev.id)
+                    tasks_[static_cast<uint8_t>(current)].run.add(ev.time - switched_in);
+                auto& task = tasks_[ev.id];
+                if (task.ready_pending) {
+                    task.latency.add(ev.time - task.ready_time);
+                    task.ready_pending = false;
+                }
+                if (current != ev.id)
+                    switched_in = ev.time;
+                current = ev.id;
+                break;
+            }
+            case EV_ISR_ENTER:
+                isr_enter[ev.id] = ev.time;
+                break;
+            case EV_ISR_EXIT:
+                if (const auto it = isr_enter.find(ev.id); it != isr_enter.end()) {
+                    isr_stats_[ev.id].add(ev.time - it->second);
+                    isr_enter.erase(it);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+};
+
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s capture.bin [--timeline]\n", argv[0]);
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    Decoder decoder;
+    decoder.feed(data);
+    if (argc > 2 && std::strcmp(argv[2], "--timeline") == 0)
+        decoder.print_timeline();
+    decoder.print_report();
+    return 0;
+}
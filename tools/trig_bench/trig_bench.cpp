@@ -0,0 +1,187 @@
+/**
+ * @file trig_bench.cpp
+ * @brief trig::查表三角函数上位机误差与速度测试
+ * 1. 对双精度libm给出sin/cos/atan2的最大绝对误差，与CMSIS-DSP的arm_sin_cos_f32、单精度libm对比；
+ * 2. 给出每次调用的耗时(x86使用TSC计数，其他平台按纳秒计)。片上对应的测试为"bench trig"命令。
+ * fast_trig.h中记录的误差上界来自本程序的输出
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycle"
+static uint64_t bench_now() { return __rdtsc(); }
+#else
+#define BENCH_UNIT "ns"
+static uint64_t bench_now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+#include "algorithm/fast_trig.h"
+#include "arm_math.h"
+
+namespace {
+
+constexpr double TWO_PI = 2.0 * trig::PI_D;
+constexpr uint32_t ANGLE_STEP = 4096;     // 扫描全部二进制角的步长
+volatile float sink;
+int failures = 0;
+
+void report(const char *name, const double err, const double limit)
+{
+    std::printf("%-28s max abs error %.3g%s\n", name, err, limit > 0.0 && err > limit ? "  FAIL" : "");
+    if (limit > 0.0 && err > limit)
+        failures++;
+}
+
+void check_sincos()
+{
+    double e_trig = 0.0, e_cmsis = 0.0, e_libm = 0.0;
+    uint32_t a = 0;
+    do {
+        const double rad = static_cast<double>(static_cast<int32_t>(a)) * (TWO_PI / 4294967296.0);
+        const double rs = std::sin(rad), rc = std::cos(rad);
+
+        const trig::SinCos sc = trig::sincos_b(a);
+        e_trig = std::fmax(e_trig, std::fmax(std::fabs(sc.sin - rs), std::fabs(sc.cos - rc)));
+
+        float s, c;
+        arm_sin_cos_f32(static_cast<float>(rad * 180.0 / trig::PI_D), &s, &c);
+        e_cmsis = std::fmax(e_cmsis, std::fmax(std::fabs(s - rs), std::fabs(c - rc)));
+
+        const float fr = static_cast<float>(rad);
+        e_libm = std::fmax(e_libm, std::fmax(std::fabs(sinf(fr) - std::sin(static_cast<double>(fr))),
+                                             std::fabs(cosf(fr) - std::cos(static_cast<double>(fr)))));
+        a += ANGLE_STEP;
+    } while (a != 0);
+
+    report("trig::sincos_b", e_trig, 7e-8);
+    report("arm_sin_cos_f32", e_cmsis, 0.0);
+    report("sinf/cosf", e_libm, 0.0);
+
+    // 浮点弧度输入，包括多圈角度
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    double e_rad = 0.0;
+    for (int i = 0; i < 1000000; i++) {
+        const float rad = dist(rng);
+        const trig::SinCos sc = trig::sincos(rad);
+        e_rad = std::fmax(e_rad, std::fmax(std::fabs(sc.sin - std::sin(static_cast<double>(rad))),
+                                           std::fabs(sc.cos - std::cos(static_cast<double>(rad)))));
+    }
+    report("trig::sincos |rad|<100", e_rad, 100.0 * 1.2e-7 + 7e-8);
+}
+
+void check_atan2()
+{
+    double e_trig = 0.0, e_libm = 0.0;
+    uint32_t a = 0;
+    do {
+        for (const float r : {1e-3f, 1.0f, 1234.5f}) {
+            const double rad = static_cast<double>(static_cast<int32_t>(a)) * (TWO_PI / 4294967296.0);
+            const float x = static_cast<float>(r * std::cos(rad));
+            const float y = static_cast<float>(r * std::sin(rad));
+            const double ref = std::atan2(static_cast<double>(y), static_cast<double>(x));
+            e_trig = std::fmax(e_trig, std::fabs(trig::atan2(y, x) - ref));
+            e_libm = std::fmax(e_libm, std::fabs(atan2f(y, x) - ref));
+        }
+        a += ANGLE_STEP;
+    } while (a != 0);
+
+    report("trig::atan2", e_trig, 3e-7);
+    report("atan2f", e_libm, 0.0);
+    if (trig::atan2(0.0f, 0.0f) != 0.0f || trig::atan2(0.0f, -1.0f) != static_cast<float>(trig::PI_D)) {
+        std::printf("trig::atan2 special cases FAIL\n");
+        failures++;
+    }
+}
+
+void check_conversions()
+{
+    static_assert(trig::from_deg(90.0f) == trig::QUARTER);
+    static_assert(trig::from_deg(-90.0f) == 3u * trig::QUARTER);
+    static_assert(trig::from_deg(720.0f + 180.0f) == trig::HALF);
+    static_assert(trig::from_ecd<13>(4096) == trig::HALF);
+    static_assert(trig::diff(trig::from_ecd<13>(100), trig::from_ecd<13>(8100)) == static_cast<int32_t>(trig::from_ecd<13>(192)));
+    static_assert(trig::diff(trig::from_ecd<13>(8100), trig::from_ecd<13>(100)) == -static_cast<int32_t>(trig::from_ecd<13>(192)));
+    static_assert(trig::sin_b(0) == 0.0f && trig::cos_b(0) == 1.0f);
+
+    double e = 0.0;
+    for (float deg = -3600.0f; deg <= 3600.0f; deg += 0.37f) {
+        double ref = std::fmod(static_cast<double>(deg), 360.0);
+        if (ref >= 180.0) ref -= 360.0;
+        if (ref < -180.0) ref += 360.0;
+        const double got = trig::to_deg(trig::from_deg(deg));
+        double err = std::fabs(got - ref);
+        err = std::fmin(err, 360.0 - err);      // ±180处两个结果都正确
+        e = std::fmax(e, err);
+    }
+    report("to_deg(from_deg) |deg|<3600", e, 3600.0 * 1.2e-7);
+}
+
+template <typename Fn>
+void bench(const char *name, Fn &&fn)
+{
+    constexpr int repeat = 1 << 16;
+    uint64_t best = UINT64_MAX;
+    for (int round = 0; round < 5; round++) {
+        const uint64_t t0 = bench_now();
+        for (int i = 0; i < repeat; i++)
+            fn(i);
+        const uint64_t t = bench_now() - t0;
+        if (t < best) best = t;
+    }
+    std::printf("%s,%.2f\n", name, static_cast<double>(best) / repeat);
+}
+
+void run_bench()
+{
+    std::vector<float> rad(1 << 16), x(1 << 16), y(1 << 16);
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+    for (size_t i = 0; i < rad.size(); i++) {
+        rad[i] = dist(rng);
+        x[i] = dist(rng);
+        y[i] = dist(rng);
+    }
+
+    std::printf("name," BENCH_UNIT "s_per_call\n");
+    bench("trig_sincos_b", [&](const int i) {
+        const auto sc = trig::sincos_b(static_cast<uint32_t>(i) * 2654435761u);
+        sink = sc.sin + sc.cos;
+    });
+    bench("trig_sincos_rad", [&](const int i) {
+        const auto sc = trig::sincos(rad[i]);
+        sink = sc.sin + sc.cos;
+    });
+    bench("cmsis_sin_cos_deg", [&](const int i) {
+        float s, c;
+        arm_sin_cos_f32(rad[i] * 57.29578f, &s, &c);
+        sink = s + c;
+    });
+    bench("libm_sinf_cosf", [&](const int i) { sink = sinf(rad[i]) + cosf(rad[i]); });
+    bench("trig_atan2", [&](const int i) { sink = trig::atan2(y[i], x[i]); });
+    bench("libm_atan2f", [&](const int i) { sink = atan2f(y[i], x[i]); });
+}
+
+} // namespace
+
+int main()
+{
+    check_conversions();
+    check_sincos();
+    check_atan2();
+    if (failures)
+        return 1;
+    run_bench();
+    return 0;
+}
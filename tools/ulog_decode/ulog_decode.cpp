@@ -0,0 +1,316 @@
+/**
+ * @file ulog_decode.cpp
+ * @brief ulog二进制日志解析工具
+ * 从固件ELF的.ulog_fmt段读取各日志点的格式串，将USB虚拟串口抓取的二进制日志帧还原为文本，
+ * 帧以外的字节(调试命令输出等)原样输出，trace帧跳过。
+ * 用法: ulog_decode firmware.elf capture.bin
+ * 帧格式见bsp/ulog/ulog.h
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "algorithm/crc.h"
+
+namespace {
+
+constexpr uint8_t FRAME_HEADER = 0xA5;
+constexpr uint8_t FRAME_TAG_LOG = 'L';
+constexpr uint8_t FRAME_TAG_TRACE = 'T';
+constexpr uint8_t FRAME_LOG = 1;
+constexpr size_t FRAME_OVERHEAD = 7;
+constexpr size_t FRAME_MAX_PAYLOAD = 1024;
+
+template <typename T>
+T rd(const uint8_t* p)
+{
+    T v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+struct Section {
+    std::string name;
+    uint64_t addr;
+    uint64_t offset;
+    uint64_t size;
+    bool alloc;
+    bool nobits;
+};
+
+/* 只解析节头，支持32/64位小端ELF */
+class Elf {
+public:
+    bool load(const char* path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return false;
+        data_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        if (data_.size() < 0x40 || std::memcmp(data_.data(), "\x7f" "ELF", 4) != 0 || data_[5] != 1)
+            return false;
+
+        const bool is64 = data_[4] == 2;
+        const uint64_t shoff = is64 ? rd<uint64_t>(&data_[0x28]) : rd<uint32_t>(&data_[0x20]);
+        const uint16_t shentsize = rd<uint16_t>(&data_[is64 ? 0x3A : 0x2E]);
+        const uint16_t shnum = rd<uint16_t>(&data_[is64 ? 0x3C : 0x30]);
+        const uint16_t shstrndx = rd<uint16_t>(&data_[is64 ? 0x3E : 0x32]);
+        if (shoff + static_cast<uint64_t>(shentsize) * shnum > data_.size() || shstrndx >= shnum)
+            return false;
+
+        std::vector<uint32_t> name_offsets;
+        for (uint16_t i = 0; i < shnum; i++) {
+            const uint8_t* sh = &data_[shoff + static_cast<uint64_t>(i) * shentsize];
+            const uint32_t type = rd<uint32_t>(sh + 4);
+            const uint64_t flags = is64 ? rd<uint64_t>(sh + 8) : rd<uint32_t>(sh + 8);
+            Section s;
+            s.addr = is64 ? rd<uint64_t>(sh + 16) : rd<uint32_t>(sh + 12);
+            s.offset = is64 ? rd<uint64_t>(sh + 24) : rd<uint32_t>(sh + 16);
+            s.size = is64 ? rd<uint64_t>(sh + 32) : rd<uint32_t>(sh + 20);
+            s.alloc = (flags & 0x2) != 0;     // SHF_ALLOC
+            s.nobits = type == 8;             // SHT_NOBITS
+            name_offsets.push_back(rd<uint32_t>(sh));
+            sections_.push_back(s);
+        }
+        const Section& strtab = sections_[shstrndx];
+        for (size_t i = 0; i < sections_.size(); i++)
+            sections_[i].name = cstr(strtab.offset + name_offsets[i], strtab.offset + strtab.size);
+        return true;
+    }
+
+    [[nodiscard]] const Section* find(const char* name) const
+    {
+        for (const auto& s : sections_)
+            if (s.name == name)
+                return &s;
+        return nullptr;
+    }
+
+    /* 读取目标板地址处的常量字符串(用于%s参数) */
+    [[nodiscard]] bool read_string(const uint32_t addr, std::string& out) const
+    {
+        for (const auto& s : sections_) {
+            if (!s.alloc || s.nobits || addr < s.addr || addr >= s.addr + s.size)
+                continue;
+            out = cstr(s.offset + (addr - s.addr), s.offset + s.size);
+            return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] std::string cstr(const uint64_t offset, uint64_t end) const
+    {
+        end = std::min<uint64_t>(end, data_.size());
+        std::string s;
+        for (uint64_t i = offset; i < end && data_[i] != 0; i++)
+            s.push_back(static_cast<char>(data_[i]));
+        return s;
+    }
+
+private:
+    std::vector<uint8_t> data_;
+    std::vector<Section> sections_;
+};
+
+/* 日志点: 级别\0文件\0行号\0格式串 */
+struct Site {
+    std::string level;
+    std::string file;
+    std::string line;
+    std::string fmt;
+};
+
+class Decoder {
+public:
+    explicit Decoder(const Elf& elf) : elf_(elf) {}
+
+    bool init()
+    {
+        table_ = elf_.find(".ulog_fmt");
+        return table_ != nullptr;
+    }
+
+    void feed(const std::vector<uint8_t>& data)
+    {
+        size_t i = 0;
+        while (i < data.size()) {
+            if (const size_t n = frame_at(data, i)) {
+                i += n;
+                continue;
+            }
+            std::fputc(data[i], stdout);
+            i++;
+        }
+        std::printf("\n-- %zu log frames, %zu unknown ids\n", frames_, unknown_);
+    }
+
+private:
+    const Elf& elf_;
+    const Section* table_ = nullptr;
+    size_t frames_ = 0;
+    size_t unknown_ = 0;
+    uint32_t last_ts_ = 0;
+    uint64_t epoch_ = 0;
+
+    size_t frame_at(const std::vector<uint8_t>& data, const size_t i)
+    {
+        if (i + FRAME_OVERHEAD > data.size() || data[i] != FRAME_HEADER)
+            return 0;
+        if (data[i + 1] != FRAME_TAG_LOG && data[i + 1] != FRAME_TAG_TRACE)
+            return 0;
+        const uint16_t len = rd<uint16_t>(&data[i + 3]);
+        if (len > FRAME_MAX_PAYLOAD || i + len + FRAME_OVERHEAD > data.size())
+            return 0;
+        if (!Verify_CRC16_Check_Sum(const_cast<uint8_t*>(&data[i]), len + FRAME_OVERHEAD))
+            return 0;
+        if (data[i + 1] == FRAME_TAG_LOG && data[i + 2] == FRAME_LOG && len >= 6)
+            print(&data[i + 5], len);
+        return len + FRAME_OVERHEAD;
+    }
+
+    [[nodiscard]] Site site(const uint16_t id) const
+    {
+        Site s;
+        uint64_t off = table_->offset + id;
+        const uint64_t end = table_->offset + table_->size;
+        for (std::string* field : {&s.level, &s.file, &s.line, &s.fmt}) {
+            *field = elf_.cstr(off, end);
+            off += field->size() + 1;
+        }
+        return s;
+    }
+
+    void print(const uint8_t* p, const uint16_t len)
+    {
+        // 目标板上该段地址为0，ID即段内偏移；主机仿真构建中该段会被分配地址，按低16位换算
+        const auto id = static_cast<uint16_t>(rd<uint16_t>(p) - static_cast<uint16_t>(table_->addr));
+        const uint32_t ts = rd<uint32_t>(p + 2);
+        std::vector<uint32_t> args;
+        for (size_t k = 6; k + 4 <= len; k += 4)
+            args.push_back(rd<uint32_t>(p + k));
+
+        // 时间戳为32位us，约71分钟回绕一次
+        if (frames_ > 0 && ts < last_ts_)
+            epoch_ += 1ull << 32;
+        last_ts_ = ts;
+        frames_++;
+
+        const double t = static_cast<double>(epoch_ | ts) * 1e-6;
+        if (id >= table_->size) {
+            unknown_++;
+            std::printf("[%12.6f] [?] unknown id %u\r\n", t, id);
+            return;
+        }
+        const Site s = site(id);
+        std::string file = s.file;
+        if (const size_t slash = file.find_last_of("/\\"); slash != std::string::npos)
+            file = file.substr(slash + 1);
+        std::printf("[%12.6f] [%s] %s:%s: %s\r\n", t, s.level.c_str(), file.c_str(), s.line.c_str(),
+                    format(s.fmt, args).c_str());
+    }
+
+    /* 按格式串逐个转换说明符替换参数，长度修饰符忽略(参数均为32位) */
+    [[nodiscard]] std::string format(const std::string& fmt, const std::vector<uint32_t>& args) const
+    {
+        std::string out;
+        size_t arg = 0;
+        char buf[256];
+
+        for (size_t i = 0; i < fmt.size(); i++) {
+            if (fmt[i] != '%') {
+                out.push_back(fmt[i]);
+                continue;
+            }
+            if (i + 1 < fmt.size() && fmt[i + 1] == '%') {
+                out.push_back('%');
+                i++;
+                continue;
+            }
+
+            std::string spec = "%";
+            size_t j = i + 1;
+            while (j < fmt.size() && std::strchr("-+ #0123456789.", fmt[j]))
+                spec.push_back(fmt[j++]);
+            while (j < fmt.size() && std::strchr("hlzjt", fmt[j]))
+                j++;
+            if (j >= fmt.size())
+                break;
+            const char conv = fmt[j];
+            i = j;
+
+            if (arg >= args.size()) {
+                out += "<?>";
+                continue;
+            }
+            const uint32_t v = args[arg++];
+            spec.push_back(conv);
+            switch (conv) {
+            case 'd':
+            case 'i':
+                std::snprintf(buf, sizeof(buf), spec.c_str(), static_cast<int32_t>(v));
+                break;
+            case 'u': case 'x': case 'X': case 'o': case 'c':
+                std::snprintf(buf, sizeof(buf), spec.c_str(), v);
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+                float f;
+                std::memcpy(&f, &v, sizeof(f));
+                std::snprintf(buf, sizeof(buf), spec.c_str(), static_cast<double>(f));
+                break;
+            }
+            case 's': {
+                std::string str;
+                if (!elf_.read_string(v, str)) {
+                    std::snprintf(buf, sizeof(buf), "<ptr 0x%08x>", v);
+                    str = buf;
+                }
+                std::snprintf(buf, sizeof(buf), spec.c_str(), str.c_str());
+                break;
+            }
+            case 'p':
+                std::snprintf(buf, sizeof(buf), "0x%08x", v);
+                break;
+            default:
+                std::snprintf(buf, sizeof(buf), "<%%%c>", conv);
+                break;
+            }
+            out += buf;
+        }
+        return out;
+    }
+};
+
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s firmware.elf capture.bin\n", argv[0]);
+        return 1;
+    }
+
+    Elf elf;
+    if (!elf.load(argv[1])) {
+        std::fprintf(stderr, "cannot load ELF %s\n", argv[1]);
+        return 1;
+    }
+    Decoder decoder(elf);
+    if (!decoder.init()) {
+        std::fprintf(stderr, "%s has no .ulog_fmt section (built without ULOG_BINARY?)\n", argv[1]);
+        return 1;
+    }
+
+    std::ifstream in(argv[2], std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", argv[2]);
+        return 1;
+    }
+    const std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    decoder.feed(data);
+    return 0;
+}